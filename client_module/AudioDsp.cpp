@@ -0,0 +1,240 @@
+#include "AudioDsp.h"
+
+// Everything the DSP task needs, precomputed on the loop side (no float per sample)
+struct BiquadQ28 { int32_t b0, b1, b2, a1, a2; };
+
+struct DspRuntime {
+  uint8_t   order[DSP_STAGE_COUNT];
+  uint8_t   count;
+  int32_t   gainQ16;
+  bool      noiseOn;  int32_t noiseMixQ15, noiseFloor;
+  int       nEq;      BiquadQ28 eq[DSP_MAX_BIQUADS];
+  bool      gateOn;   int32_t gateThresh, gateHoldSamples, gateStepQ16;
+  bool      agcOn;    float agcTarget, agcMaxGain, agcExp, agcAttack, agcRelease;
+  int32_t   limitPos, limitNeg;
+};
+
+static DspRuntime gRt, gRtPending;
+static volatile bool gRtDirty = false;
+static bool gRtValid = false;
+static portMUX_TYPE gRtMux = portMUX_INITIALIZER_UNLOCKED;
+
+// DSP task state
+struct BiquadState { int32_t x1, x2, y1, y2; };
+static BiquadState gEqState[DSP_MAX_BIQUADS];
+static int32_t  gGateGain = 65536, gGateHold = 0;
+static float    gAgcEnv = 0;
+static int32_t  gAgcGain = 65536;
+static uint32_t gLfsr = 0xA5A5A5A5u;
+static volatile uint32_t gCycles[DSP_STAGE_COUNT];
+
+static const char* const STAGE_NAMES[DSP_STAGE_COUNT] = { "GAIN", "NOISE", "EQ", "GATE", "AGC", "LIMIT" };
+static const char* const FILTER_NAMES[] = { "OFF", "NOTCH", "LP", "HP", "BP", "PEAK" };
+
+const char* dspStageName(uint8_t stage) { return stage < DSP_STAGE_COUNT ? STAGE_NAMES[stage] : "?"; }
+const char* dspFilterName(uint8_t type) { return type <= DSP_F_PEAK ? FILTER_NAMES[type] : "?"; }
+
+int dspStageFromName(const char* name) {
+  for (int i = 0; i < DSP_STAGE_COUNT; i++) if (strcasecmp(name, STAGE_NAMES[i]) == 0) return i;
+  return -1;
+}
+int dspFilterFromName(const char* name) {
+  for (int i = 0; i <= DSP_F_PEAK; i++) if (strcasecmp(name, FILTER_NAMES[i]) == 0) return i;
+  return -1;
+}
+
+// ===== Loop side: settings -> runtime =====
+
+static inline int32_t q28(float v) { return (int32_t)lroundf(v * 268435456.0f); }
+
+// RBJ cookbook biquads, normalized by a0
+static bool biquadDesign(const DspBiquad& f, float fs, BiquadQ28& out) {
+  if (f.type == DSP_F_OFF) return false;
+  float hz = constrain(f.hz, 10.0f, fs * 0.45f);
+  float q = max(f.q, 0.1f);
+  float w0 = 2.0f * PI * hz / fs;
+  float c = cosf(w0), alpha = sinf(w0) / (2.0f * q);
+  float A = powf(10.0f, f.gainDb / 40.0f);
+  float b0, b1, b2, a0, a1 = -2.0f * c, a2;
+  switch (f.type) {
+    case DSP_F_NOTCH:    b0 = 1; b1 = -2 * c; b2 = 1; a0 = 1 + alpha; a2 = 1 - alpha; break;
+    case DSP_F_LOWPASS:  b0 = (1 - c) / 2; b1 = 1 - c; b2 = b0; a0 = 1 + alpha; a2 = 1 - alpha; break;
+    case DSP_F_HIGHPASS: b0 = (1 + c) / 2; b1 = -(1 + c); b2 = b0; a0 = 1 + alpha; a2 = 1 - alpha; break;
+    case DSP_F_BANDPASS: b0 = alpha; b1 = 0; b2 = -alpha; a0 = 1 + alpha; a2 = 1 - alpha; break;
+    default:             b0 = 1 + alpha * A; b1 = -2 * c; b2 = 1 - alpha * A; a0 = 1 + alpha / A; a2 = 1 - alpha / A; break;
+  }
+  out = { q28(b0 / a0), q28(b1 / a0), q28(b2 / a0), q28(a1 / a0), q28(a2 / a0) };
+  return true;
+}
+
+// one-pole smoothing coefficient per block for a time constant
+static float blockCoef(float tauMs, float blockMs) {
+  return tauMs <= 0 ? 1.0f : 1.0f - expf(-blockMs / tauMs);
+}
+
+void dspConfigure(const DspSettings& s, uint32_t sampleRate, int blockSamples) {
+  DspRuntime r = {};
+  const float fs = (float)sampleRate, blockMs = 1000.0f * blockSamples / fs;
+
+  r.count = min<uint8_t>(s.count, DSP_STAGE_COUNT);
+  memcpy(r.order, s.order, r.count);
+  r.gainQ16 = (int32_t)lroundf(constrain(s.gain, 0.0f, 32.0f) * 65536.0f);
+
+  r.noiseOn = s.noiseOn;
+  r.noiseMixQ15 = (int32_t)lroundf(constrain(s.noiseMix, 0.0f, 1.0f) * 32768.0f);
+  r.noiseFloor = constrain(s.noiseFloor, 0, 4095) << 4;
+
+  for (int i = 0; i < DSP_MAX_BIQUADS; i++) {
+    if (biquadDesign(s.eq[i], fs, r.eq[r.nEq])) r.nEq++;
+  }
+
+  r.gateOn = s.gateOn;
+  r.gateThresh = constrain(s.gateThresh, 0, 4095) << 4;
+  r.gateHoldSamples = (int32_t)((uint32_t)s.gateHoldMs * sampleRate / 1000);
+  r.gateStepQ16 = (int32_t)(65536.0f * min(1.0f, blockMs / max<float>(s.gateReleaseMs, 1.0f)));
+
+  r.agcOn = s.agcOn;
+  r.agcTarget = (float)(constrain(s.agcTarget, 1, 4095) << 4);
+  r.agcMaxGain = powf(10.0f, constrain(s.agcMaxGainDb, 0.0f, 40.0f) / 20.0f);
+  r.agcExp = 1.0f / max(s.agcRatio, 1.0f) - 1.0f;   // gain above target = (env/target)^exp
+  r.agcAttack = blockCoef(s.agcAttackMs, blockMs);
+  r.agcRelease = blockCoef(s.agcReleaseMs, blockMs);
+
+  r.limitPos = (constrain(s.limit, 2048, 4095) - 2048) << 4;
+  r.limitNeg = 32768;
+
+  portENTER_CRITICAL(&gRtMux);
+  gRtPending = r;
+  gRtDirty = true;
+  portEXIT_CRITICAL(&gRtMux);
+}
+
+// ===== DSP task: stages =====
+
+static void stageGain(int32_t* x, int n, const DspRuntime& r) {
+  const int32_t g = r.gainQ16;
+  for (int i = 0; i < n; i++) x[i] = (int32_t)(((int64_t)x[i] * g) >> 16);
+}
+
+// comfort noise: quiet samples are blended towards LFSR noise
+static void stageNoise(int32_t* x, int n, const DspRuntime& r) {
+  if (!r.noiseOn) return;
+  const int32_t floor = r.noiseFloor, mix = r.noiseMixQ15;
+  uint32_t lfsr = gLfsr;
+  for (int i = 0; i < n; i++) {
+    int32_t s = x[i];
+    if (s < floor && s > -floor) {
+      lfsr ^= lfsr << 13; lfsr ^= lfsr >> 17; lfsr ^= lfsr << 5;
+      int32_t nz = (int16_t)(lfsr >> 16);
+      x[i] = s + (int32_t)(((int64_t)(nz - s) * mix) >> 15);
+    }
+  }
+  gLfsr = lfsr;
+}
+
+// cascaded direct form I biquads, 64-bit accumulator
+static void stageEq(int32_t* x, int n, const DspRuntime& r) {
+  for (int k = 0; k < r.nEq; k++) {
+    const BiquadQ28 c = r.eq[k];
+    BiquadState st = gEqState[k];
+    for (int i = 0; i < n; i++) {
+      int64_t acc = (int64_t)c.b0 * x[i] + (int64_t)c.b1 * st.x1 + (int64_t)c.b2 * st.x2
+                  - (int64_t)c.a1 * st.y1 - (int64_t)c.a2 * st.y2;
+      int32_t y = (int32_t)(acc >> 28);
+      st.x2 = st.x1; st.x1 = x[i];
+      st.y2 = st.y1; st.y1 = y;
+      x[i] = y;
+    }
+    gEqState[k] = st;
+  }
+}
+
+static int32_t blockPeak(const int32_t* x, int n) {
+  int32_t p = 0;
+  for (int i = 0; i < n; i++) { int32_t a = x[i] < 0 ? -x[i] : x[i]; if (a > p) p = a; }
+  return p;
+}
+
+// gain g0 -> g1 (Q16) linearly across the block
+static void applyRamp(int32_t* x, int n, int32_t g0, int32_t g1) {
+  if (g0 == g1 && g0 == 65536) return;
+  int32_t step = (g1 - g0) / n, g = g0;
+  for (int i = 0; i < n; i++, g += step) x[i] = (int32_t)(((int64_t)x[i] * g) >> 16);
+}
+
+static void stageGate(int32_t* x, int n, const DspRuntime& r) {
+  if (!r.gateOn) { gGateGain = 65536; return; }
+  if (blockPeak(x, n) >= r.gateThresh) gGateHold = r.gateHoldSamples;
+  else gGateHold = max<int32_t>(0, gGateHold - n);
+  int32_t g1 = gGateHold > 0 ? 65536 : max<int32_t>(0, gGateGain - r.gateStepQ16);
+  applyRamp(x, n, gGateGain, g1);
+  gGateGain = g1;
+}
+
+// AGC/compressor: below target boost up to the max gain, above target compress by ratio
+static void stageAgc(int32_t* x, int n, const DspRuntime& r) {
+  if (!r.agcOn) { gAgcGain = 65536; return; }
+  float peak = (float)blockPeak(x, n);
+  gAgcEnv += (peak - gAgcEnv) * (peak > gAgcEnv ? r.agcAttack : r.agcRelease);
+  float g;
+  if (gAgcEnv <= r.agcTarget) g = gAgcEnv > 1.0f ? min(r.agcMaxGain, r.agcTarget / gAgcEnv) : r.agcMaxGain;
+  else g = powf(gAgcEnv / r.agcTarget, r.agcExp);
+  int32_t g1 = (int32_t)(g * 65536.0f);
+  applyRamp(x, n, gAgcGain, g1);
+  gAgcGain = g1;
+}
+
+// soft knee from half the ceiling, reaching the ceiling with zero slope
+static inline int32_t kneeClip(int32_t x, int32_t c) {
+  int32_t k = c >> 1;
+  if (x <= k) return x;
+  int32_t d = x - k;
+  if (d >= c) return c;
+  return k + d - (int32_t)(((int64_t)d * d) / (2 * (int64_t)c));
+}
+
+static void stageLimit(int32_t* x, int n, const DspRuntime& r) {
+  const int32_t cp = r.limitPos, cn = r.limitNeg;
+  for (int i = 0; i < n; i++) {
+    int32_t s = x[i];
+    x[i] = s >= 0 ? kneeClip(s, cp) : -kneeClip(-s, cn);
+  }
+}
+
+typedef void (*StageFn)(int32_t*, int, const DspRuntime&);
+static const StageFn STAGES[DSP_STAGE_COUNT] = { stageGain, stageNoise, stageEq, stageGate, stageAgc, stageLimit };
+
+void dspProcess(int32_t* x, int n) {
+  if (gRtDirty) {
+    portENTER_CRITICAL(&gRtMux);
+    const DspRuntime next = gRtPending;
+    gRtDirty = false;
+    portEXIT_CRITICAL(&gRtMux);
+    // filter state only survives if the cascade is unchanged
+    if (!gRtValid || next.nEq != gRt.nEq || memcmp(next.eq, gRt.eq, sizeof(next.eq)) != 0) memset(gEqState, 0, sizeof(gEqState));
+    gRt = next;
+    gRtValid = true;
+  }
+  if (!gRtValid || n <= 0) return;
+
+  for (int i = 0; i < gRt.count; i++) {
+    uint8_t st = gRt.order[i];
+    if (st >= DSP_STAGE_COUNT) continue;
+    uint32_t c0 = ESP.getCycleCount();
+    STAGES[st](x, n, gRt);
+    int32_t d = (int32_t)(ESP.getCycleCount() - c0);
+    gCycles[st] = (uint32_t)((int32_t)gCycles[st] + (d - (int32_t)gCycles[st]) / 8);   // smoothed
+  }
+}
+
+void dspGetStats(DspStats& out) {
+  out.totalCycles = 0;
+  for (int i = 0; i < DSP_STAGE_COUNT; i++) {
+    bool used = false;
+    for (int k = 0; k < gRt.count; k++) used |= (gRt.order[k] == i);
+    out.cycles[i] = used ? gCycles[i] : 0;
+    out.totalCycles += out.cycles[i];
+  }
+  out.agcGainDb = 20.0f * log10f(max(gAgcGain, (int32_t)1) / 65536.0f);
+  out.gateOpen = gGateGain > 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+
+// Block-based fixed-point audio chain. Samples are Q15 in int32 (headroom until the
+// limiter), biquad coefficients Q28, gains Q16. Stages run in a configurable order, one
+// block at a time; gate and AGC compute their gain once per block and ramp it across
+// the samples. Settings are written from the loop task and taken over by the DSP task
+// at the next block boundary.
+
+enum DspStage : uint8_t { DSP_GAIN, DSP_NOISE, DSP_EQ, DSP_GATE, DSP_AGC, DSP_LIMIT, DSP_STAGE_COUNT };
+enum DspFilter : uint8_t { DSP_F_OFF, DSP_F_NOTCH, DSP_F_LOWPASS, DSP_F_HIGHPASS, DSP_F_BANDPASS, DSP_F_PEAK };
+
+#define DSP_MAX_BIQUADS 4
+
+struct DspBiquad { DspFilter type; float hz, q, gainDb; };
+
+// Levels are in ADC units (0..4095 full scale, as the AUDIO commands use them)
+struct DspSettings {
+  uint8_t   order[DSP_STAGE_COUNT];  // stage ids in processing order
+  uint8_t   count;                   // stages in the chain
+  float     gain;                    // linear
+  bool      noiseOn;   float noiseMix;   int noiseFloor;
+  DspBiquad eq[DSP_MAX_BIQUADS];     // cascaded, DSP_F_OFF slots are skipped
+  bool      gateOn;    int gateThresh;   uint16_t gateHoldMs, gateReleaseMs;
+  bool      agcOn;     int agcTarget;    float agcMaxGainDb, agcRatio; uint16_t agcAttackMs, agcReleaseMs;
+  int       limit;                   // positive ceiling, 2048..4095 (mid-scale = 2048)
+};
+
+struct DspStats {
+  uint32_t cycles[DSP_STAGE_COUNT];  // per block, smoothed
+  uint32_t totalCycles;
+  float    agcGainDb;                // current AGC gain
+  bool     gateOpen;
+};
+
+void dspConfigure(const DspSettings& s, uint32_t sampleRate, int blockSamples); // loop side
+void dspProcess(int32_t* q15, int n);                                           // DSP task
+void dspGetStats(DspStats& out);
+
+const char* dspStageName(uint8_t stage);
+int         dspStageFromName(const char* name);     // -1 if unknown
+const char* dspFilterName(uint8_t type);
+int         dspFilterFromName(const char* name);    // -1 if unknown
@@ -1,8 +1,13 @@
 #include "AudioPassthrough.h"
+#include "AudioDsp.h"
+#include "AudioSynth.h"
+#include "Metrics.h"
 #include <SD.h>
+#include "esp_adc/adc_continuous.h"
+#include "hal/dac_ll.h"
 
 // extern from Motors.cpp
-extern bool motorsIsMoving();
+extern bool motorsIsActive();
 
 static uint8_t gVolume = AUDIO_FIXED_VOLUME;
 static float   gPTGain = 1.0f;
@@ -10,9 +15,19 @@ static int     gLimiter     = AUDIO_LIMIT;
 static bool    gNoiseOn     = INJECT_NOISE_WHEN_MOVING;
 static float   gNoiseMix    = INJECT_NOISE_MIX;
 static int     gNoiseFloor  = INJECT_NOISE_FLOOR;
-static bool    gNotchOn     = NOTCH_ON;
-static float   gNotchHz     = NOTCH_HZ;
-static float   gNotchQ      = NOTCH_Q;
+static DspBiquad gEq[DSP_MAX_BIQUADS] = {
+  { NOTCH_ON ? DSP_F_NOTCH : DSP_F_OFF, NOTCH_HZ, NOTCH_Q, 0 },   // slot 1 doubles as AUDIO NOTCH
+  { DSP_F_OFF, 1000, 0.707f, 0 }, { DSP_F_OFF, 1000, 0.707f, 0 }, { DSP_F_OFF, 1000, 0.707f, 0 },
+};
+static bool     gGateOn = AUDIO_GATE_ON;
+static int      gGateThresh = AUDIO_GATE_THRESH;
+static uint16_t gGateHoldMs = AUDIO_GATE_HOLD_MS, gGateReleaseMs = AUDIO_GATE_RELEASE_MS;
+static bool     gAgcOn = AUDIO_AGC_ON;
+static int      gAgcTarget = AUDIO_AGC_TARGET;
+static float    gAgcMaxGainDb = AUDIO_AGC_MAX_GAIN_DB, gAgcRatio = AUDIO_AGC_RATIO;
+static uint16_t gAgcAttackMs = AUDIO_AGC_ATTACK_MS, gAgcReleaseMs = AUDIO_AGC_RELEASE_MS;
+static uint8_t  gChain[DSP_STAGE_COUNT] = { DSP_GAIN, DSP_NOISE, DSP_EQ, DSP_GATE, DSP_AGC, DSP_LIMIT };
+static uint8_t  gChainLen = DSP_STAGE_COUNT;
 
 static bool  gBeepStartOn = BEEP_ON_TRACK_START;
 static bool  gBeepEndOn   = BEEP_ON_TRACK_END;
@@ -25,98 +40,260 @@ static uint8_t gBeepVolume    = BEEP_VOLUME;
 static bool gMuteWhenIdle = true;
 static int  gADCAttnDb = 11;
 
-// notch IIR
-static float b0_=1, b1_=0, b2_=1, a1_=0, a2_=0, z1_=0, z2_=0;
-static uint32_t lfsr = 0xA5A5A5A5u;
-
-static inline int16_t noise12() {
-  lfsr ^= lfsr << 13; lfsr ^= lfsr >> 17; lfsr ^= lfsr << 5;
-  return (int16_t)((lfsr >> 20) & 0x0FFF) - 2048;
-}
-static inline int softClip(int x) {
-  const int a = 2048;
-  long x3 = (long)x * x * x;
-  long y  = (long)x - (x3 / (long)(a * a));
-  return (int)y;
-}
-static void setupNotch(float fs, float f0, float Q) {
-  float w0 = 2.0f * PI * f0 / fs;
-  float alpha = sinf(w0) / (2.0f * Q);
-  float cosw0 = cosf(w0);
-  float b0n =  1.0f;
-  float b1n = -2.0f * cosw0;
-  float b2n =  1.0f;
-  float a0n =  1.0f + alpha;
-  float a1n = -2.0f * cosw0;
-  float a2n =  1.0f - alpha;
-  b0_ = b0n/a0n; b1_ = b1n/a0n; b2_ = b2n/a0n;
-  a1_ = a1n/a0n; a2_ = a2n/a0n;
-  z1_ = z2_ = 0;
+// Hands the current settings to the DSP chain (taken over at the next block boundary)
+static void applyDsp() {
+  DspSettings d = {};
+  memcpy(d.order, gChain, gChainLen);
+  d.count = gChainLen;
+  d.gain = (float)max<uint8_t>(gVolume, 1) / 128.0f * (gPTGain <= 0 ? 1.0f : gPTGain);
+  d.noiseOn = gNoiseOn; d.noiseMix = gNoiseMix; d.noiseFloor = gNoiseFloor;
+  memcpy(d.eq, gEq, sizeof(gEq));
+  d.gateOn = gGateOn; d.gateThresh = gGateThresh; d.gateHoldMs = gGateHoldMs; d.gateReleaseMs = gGateReleaseMs;
+  d.agcOn = gAgcOn; d.agcTarget = gAgcTarget; d.agcMaxGainDb = gAgcMaxGainDb; d.agcRatio = gAgcRatio;
+  d.agcAttackMs = gAgcAttackMs; d.agcReleaseMs = gAgcReleaseMs;
+  d.limit = gLimiter;
+  dspConfigure(d, AUDIO_SAMPLE_RATE, AUDIO_BLOCK_SAMPLES);
 }
 
-void audioSetADCAttenuation(int db) {
-  gADCAttnDb = db;
-  if (db == 0)      analogSetPinAttenuation(MIC_PIN, ADC_0db);
-  else if (db == 2) analogSetPinAttenuation(MIC_PIN, ADC_2_5db);
-  else if (db == 6) analogSetPinAttenuation(MIC_PIN, ADC_6db);
-  else              analogSetPinAttenuation(MIC_PIN, ADC_11db);
+// ===== Stream engine =====
+// ADC (GPIO MIC_PIN) runs in continuous DMA mode at AUDIO_SAMPLE_RATE. A task pinned to
+// AUDIO_TASK_CORE takes one DMA frame at a time, processes it as a block and pushes the
+// result into an output ring. A hardware timer at the same rate feeds the ring to the DAC,
+// so the output rate no longer depends on how fast loop() runs. The two clocks are not
+// locked: the task holds the ring level between the watermarks by dropping or repeating
+// one sample of a block (at most 1/AUDIO_BLOCK_SAMPLES, ~0.4 %, far more than crystal drift).
+#define AUDIO_FRAME_BYTES (AUDIO_BLOCK_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+#define AUDIO_RING_SIZE   (AUDIO_BLOCK_SAMPLES * 8)   // power of two
+#define AUDIO_RING_MASK   (AUDIO_RING_SIZE - 1)
+#define AUDIO_RING_LOW    (AUDIO_BLOCK_SAMPLES / 2)   // level when a block arrives: below, repeat one
+#define AUDIO_RING_HIGH   (AUDIO_BLOCK_SAMPLES * 2)   // above, drop one
+
+static adc_continuous_handle_t gAdc = nullptr;
+static TaskHandle_t gAudioTask = nullptr;
+static hw_timer_t*  gDacTimer = nullptr;
+
+static DRAM_ATTR uint8_t gRing[AUDIO_RING_SIZE];
+static volatile uint32_t gRingHead = 0;         // written by the producer
+static volatile uint32_t gRingTail = 0;         // written by the DAC ISR
+
+static volatile uint32_t gUnderruns = 0, gOverruns = 0, gBlocks = 0;
+static volatile uint32_t gDriftDrops = 0, gDriftRepeats = 0;
+static volatile uint32_t gDspUsLast = 0, gDspUsMax = 0;
+static uint32_t gRateT0Ms = 0, gRateBlocks0 = 0;
+static float    gMeasuredRate = 0;
+
+static const dac_channel_t DAC_CH = (DAC_PIN == 25) ? DAC_CHAN_0 : DAC_CHAN_1;
+
+static void IRAM_ATTR onDacTick() {
+  uint32_t t = gRingTail;
+  if (t == gRingHead) { gUnderruns++; return; }  // hold the last value
+  dac_ll_update_output_value(DAC_CH, gRing[t & AUDIO_RING_MASK]);
+  gRingTail = t + 1;
 }
 
-void audioInit() {
-  pinMode(DAC_PIN, OUTPUT);
-  dacWrite(DAC_PIN, 128);
+static inline uint32_t ringFree() { return AUDIO_RING_SIZE - (gRingHead - gRingTail); }
+static inline bool ringPush(uint8_t v) {
+  if (ringFree() == 0) return false;
+  gRing[gRingHead & AUDIO_RING_MASK] = v;
+  gRingHead = gRingHead + 1;
+  return true;
+}
 
-  analogReadResolution(12);
-  audioSetADCAttenuation(gADCAttnDb);
+static adc_atten_t attnFromDb(int db) {
+  if (db == 0) return ADC_ATTEN_DB_0;
+  if (db == 2) return ADC_ATTEN_DB_2_5;
+  if (db == 6) return ADC_ATTEN_DB_6;
+  return ADC_ATTEN_DB_12;
+}
 
-  if (gNotchOn) setupNotch(8000.0f, gNotchHz, gNotchQ);
+static bool adcConfigure() {
+  adc_unit_t unit; adc_channel_t ch;
+  if (adc_continuous_io_to_channel(MIC_PIN, &unit, &ch) != ESP_OK) return false;
 
-#if AUDIO_BOOT_TONE_TEST
-  audioToneTest(1000, 180, 120, DAC_PIN);
-#endif
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten     = attnFromDb(gADCAttnDb);
+  pattern.channel   = ch;
+  pattern.unit      = unit;
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_continuous_config_t cfg = {};
+  cfg.pattern_num    = 1;
+  cfg.adc_pattern    = &pattern;
+  cfg.sample_freq_hz = AUDIO_SAMPLE_RATE;
+  cfg.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format         = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+  return adc_continuous_config(gAdc, &cfg) == ESP_OK;
 }
 
-void audioLoop() {
-  if (gMuteWhenIdle && !motorsIsMoving()) {
-    dacWrite(DAC_PIN, 128);
-    return;
+static bool IRAM_ATTR onAdcPoolOverflow(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void*) {
+  gOverruns += AUDIO_BLOCK_SAMPLES;
+  return false;
+}
+
+static bool adcStart() {
+  if (!gAdc) {
+    adc_continuous_handle_cfg_t hcfg = {};
+    hcfg.max_store_buf_size = AUDIO_FRAME_BYTES * 4;
+    hcfg.conv_frame_size    = AUDIO_FRAME_BYTES;
+    if (adc_continuous_new_handle(&hcfg, &gAdc) != ESP_OK) { gAdc = nullptr; return false; }
+    adc_continuous_evt_cbs_t cbs = {};
+    cbs.on_pool_ovf = onAdcPoolOverflow;
+    adc_continuous_register_event_callbacks(gAdc, &cbs, nullptr);
+  } else {
+    adc_continuous_stop(gAdc);
   }
+  if (!adcConfigure()) return false;
+  return adc_continuous_start(gAdc) == ESP_OK;
+}
+
+// One block: 12-bit ADC -> Q15 -> DSP chain -> + synth -> 8-bit DAC
+static void processBlock(const uint16_t* in, uint8_t* out, int n) {
+  static int32_t x[AUDIO_BLOCK_SAMPLES];
+  if (gMuteWhenIdle && !motorsIsActive()) {
+    if (!synthBusy()) { memset(out, 128, n); return; }
+    memset(x, 0, n * sizeof(x[0]));   // beeps still play while the passthrough is muted
+  } else {
+    for (int i = 0; i < n; i++) x[i] = ((int32_t)in[i] - 2048) << 4;
+    dspProcess(x, n);
+  }
+  synthRender(x, n);
+  for (int i = 0; i < n; i++) {
+    int32_t v = (x[i] + 32768) >> 8;
+    out[i] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+  }
+}
+
+static void audioTask(void*) {
+  static uint8_t  raw[AUDIO_FRAME_BYTES];
+  static uint16_t in[AUDIO_BLOCK_SAMPLES];
+  static uint8_t  out[AUDIO_BLOCK_SAMPLES + 1];   // + the repeated sample
+
+  for (;;) {
+    uint32_t got = 0;
+    if (adc_continuous_read(gAdc, raw, sizeof(raw), &got, 100) != ESP_OK || got == 0) continue;
+
+    int n = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got && n < AUDIO_BLOCK_SAMPLES; i += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t* p = (const adc_digi_output_data_t*)&raw[i];
+      in[n++] = p->type1.data;
+    }
 
-  int s = analogRead(MIC_PIN) - 2048;
+    uint32_t t0 = micros();
+    processBlock(in, out, n);
+    uint32_t us = micros() - t0;
+    gDspUsLast = us;
+    if (us > gDspUsMax) gDspUsMax = us;
+    metricAdd(MET_DSP_US, us);
 
-  float g = (float)max<uint8_t>(gVolume,1) / 128.0f;
-  g *= (gPTGain <= 0 ? 1.0f : gPTGain);
-  s = (int)roundf((float)s * g);
+    // real sample rate, one histogram sample per second
+    static uint32_t rateT0 = millis(), rateN = 0;
+    rateN += n;
+    uint32_t el = millis() - rateT0;
+    if (el >= 1000) {
+      metricAdd(MET_AUDIO_HZ, (uint32_t)((uint64_t)rateN * 1000 / el));
+      rateT0 += el; rateN = 0;
+    }
+
+    // drift control; the first block starts the ring at the low watermark instead
+    uint32_t fill = gRingHead - gRingTail;
+    if (gBlocks == 0) {
+      for (int i = 0; i < AUDIO_RING_LOW; i++) ringPush(128);
+    } else if (fill > AUDIO_RING_HIGH && n > 1) {
+      n--; gDriftDrops = gDriftDrops + 1;
+    } else if (fill < AUDIO_RING_LOW && n > 0) {
+      out[n] = out[n - 1]; n++; gDriftRepeats = gDriftRepeats + 1;
+    }
+    for (int i = 0; i < n; i++) if (!ringPush(out[i])) { gOverruns += n - i; break; }
 
-  if (gNoiseOn && abs(s) < gNoiseFloor) {
-    int16_t n = noise12();
-    float mix = (gNoiseMix<0)?0:((gNoiseMix>1)?1:gNoiseMix);
-    s = (int)((1.0f - mix)*s + mix*n);
+    if (gBlocks == 0) gUnderruns = 0; // startup gap before the first block is expected
+    gBlocks = gBlocks + 1;
   }
+}
 
-  if (gNotchOn) {
-    float x = (float)s;
-    float y = b0_*x + z1_;
-    z1_ = b1_*x - a1_*y + z2_;
-    z2_ = b2_*x - a2_*y;
-    s = (int)y;
+void audioSetADCAttenuation(int db) {
+  gADCAttnDb = (db == 0 || db == 2 || db == 6) ? db : 11;
+  if (gAdc && !adcStart()) Serial.println(F("❌ Audio ADC reconfigure failed"));
+}
+
+void audioInit() {
+  pinMode(DAC_PIN, OUTPUT);
+  dacWrite(DAC_PIN, 128);  // powers the DAC pad; the timer ISR writes the register directly
+
+  applyDsp();
+  synthBegin(AUDIO_SAMPLE_RATE);
+
+  gDacTimer = timerBegin(1000000);
+  timerAttachInterrupt(gDacTimer, &onDacTick);
+  timerAlarm(gDacTimer, 1000000 / AUDIO_SAMPLE_RATE, true, 0);
+
+  if (!adcStart()) {
+    Serial.println(F("❌ Audio ADC DMA start failed"));
+  } else {
+    xTaskCreatePinnedToCore(audioTask, "audio", 4096, nullptr, AUDIO_TASK_PRIO, &gAudioTask, AUDIO_TASK_CORE);
   }
+  gRateT0Ms = millis();
 
-  s = softClip(s);
-  s = constrain(s + 2048, 0, gLimiter);
-  dacWrite(DAC_PIN, (uint8_t)(s >> 4));
+#if AUDIO_BOOT_TONE_TEST
+  audioToneTest(1000, 180, 120, DAC_PIN);
+#endif
+}
+
+void audioGetStats(AudioStats& out) {
+  uint32_t now = millis();
+  uint32_t blocks = gBlocks;
+  if (now - gRateT0Ms >= 1000) {
+    gMeasuredRate = (float)(blocks - gRateBlocks0) * AUDIO_BLOCK_SAMPLES * 1000.0f / (float)(now - gRateT0Ms);
+    gRateT0Ms = now; gRateBlocks0 = blocks;
+  }
+  out.sampleRate   = AUDIO_SAMPLE_RATE;
+  out.measuredRate = gMeasuredRate;
+  out.blocks       = blocks;
+  out.underruns    = gUnderruns;
+  out.overruns     = gOverruns;
+  out.driftDrops   = gDriftDrops;
+  out.driftRepeats = gDriftRepeats;
+  out.dspUsLast    = gDspUsLast;
+  out.dspUsMax     = gDspUsMax;
 }
 
-void audioSetVolume(uint8_t vol) { gVolume = vol; }
-void audioSetPTGain(float mult)  { gPTGain = constrain(mult, 0.1f, 12.0f); }
-void audioSetLimiter(int lim)    { gLimiter = constrain(lim, 0, 4095); }
+void audioSetVolume(uint8_t vol) { gVolume = vol; applyDsp(); }
+void audioSetPTGain(float mult)  { gPTGain = constrain(mult, 0.1f, 12.0f); applyDsp(); }
+void audioSetLimiter(int lim)    { gLimiter = constrain(lim, 2048, 4095); applyDsp(); }
 void audioSetNoise(bool on, float mix, int floor) {
   gNoiseOn = on; gNoiseMix = constrain(mix, 0.0f, 1.0f); gNoiseFloor = constrain(floor, 0, 4095);
   if (gNoiseOn && gNoiseMix < 0.01f) gNoiseMix = 0.01f;
+  applyDsp();
 }
 void audioSetNotch(bool on, float hz, float q) {
-  gNotchOn = on; gNotchHz = hz; gNotchQ = q;
-  if (gNotchOn) setupNotch(8000.0f, gNotchHz, gNotchQ);
+  audioSetEq(0, on ? DSP_F_NOTCH : DSP_F_OFF, hz, q, 0);
+}
+bool audioSetEq(int slot, DspFilter type, float hz, float q, float gainDb) {
+  if (slot < 0 || slot >= DSP_MAX_BIQUADS || hz <= 0 || q <= 0) return false;
+  gEq[slot] = { type, hz, q, constrain(gainDb, -24.0f, 24.0f) };
+  applyDsp();
+  return true;
+}
+void audioSetGate(bool on, int thresh, uint16_t holdMs, uint16_t releaseMs) {
+  gGateOn = on; gGateThresh = constrain(thresh, 0, 4095);
+  gGateHoldMs = holdMs; gGateReleaseMs = max<uint16_t>(releaseMs, 1);
+  applyDsp();
+}
+void audioSetAgc(bool on, int target, float maxGainDb, float ratio, uint16_t attackMs, uint16_t releaseMs) {
+  gAgcOn = on; gAgcTarget = constrain(target, 1, 4095);
+  gAgcMaxGainDb = constrain(maxGainDb, 0.0f, 40.0f); gAgcRatio = constrain(ratio, 1.0f, 50.0f);
+  gAgcAttackMs = attackMs; gAgcReleaseMs = releaseMs;
+  applyDsp();
+}
+bool audioSetChain(const uint8_t* stages, int count) {
+  if (count < 0 || count > DSP_STAGE_COUNT) return false;
+  for (int i = 0; i < count; i++) {
+    if (stages[i] >= DSP_STAGE_COUNT) return false;
+    for (int k = 0; k < i; k++) if (stages[k] == stages[i]) return false;   // each stage once
+  }
+  memcpy(gChain, stages, count);
+  gChainLen = count;
+  applyDsp();
+  return true;
 }
 void audioSetMuteWhenIdle(bool enable) { gMuteWhenIdle = enable; }
 
@@ -127,52 +304,135 @@ void audioResetToDefaults() {
   gNoiseOn = INJECT_NOISE_WHEN_MOVING;
   gNoiseMix = INJECT_NOISE_MIX;
   gNoiseFloor = INJECT_NOISE_FLOOR;
-  gNotchOn = NOTCH_ON;
-  gNotchHz = NOTCH_HZ;
-  gNotchQ  = NOTCH_Q;
+  gEq[0] = { NOTCH_ON ? DSP_F_NOTCH : DSP_F_OFF, NOTCH_HZ, NOTCH_Q, 0 };
+  for (int i = 1; i < DSP_MAX_BIQUADS; i++) gEq[i] = { DSP_F_OFF, 1000, 0.707f, 0 };
+  gGateOn = AUDIO_GATE_ON; gGateThresh = AUDIO_GATE_THRESH;
+  gGateHoldMs = AUDIO_GATE_HOLD_MS; gGateReleaseMs = AUDIO_GATE_RELEASE_MS;
+  gAgcOn = AUDIO_AGC_ON; gAgcTarget = AUDIO_AGC_TARGET;
+  gAgcMaxGainDb = AUDIO_AGC_MAX_GAIN_DB; gAgcRatio = AUDIO_AGC_RATIO;
+  gAgcAttackMs = AUDIO_AGC_ATTACK_MS; gAgcReleaseMs = AUDIO_AGC_RELEASE_MS;
+  const uint8_t chain[] = { DSP_GAIN, DSP_NOISE, DSP_EQ, DSP_GATE, DSP_AGC, DSP_LIMIT };
+  memcpy(gChain, chain, sizeof(chain)); gChainLen = sizeof(chain);
+  applyDsp();
   audioSetADCAttenuation(11);
 }
 
+// Line 1 keeps the original CSV layout (older firmware still reads it); the DSP chain
+// follows as key=value lines.
 bool audioSaveSettingsToSD() {
   File f = SD.open("/audio.cfg", FILE_WRITE);
   if (!f) return false;
+  const bool notchOn = gEq[0].type == DSP_F_NOTCH;
   f.printf("%u,%.3f,%d,%d,%.3f,%d,%d,%f,%f,%d,%u\n",
            gVolume, gPTGain, gLimiter, (int)gNoiseOn, gNoiseMix, gNoiseFloor,
-           (int)gNotchOn, gNotchHz, gNotchQ, gADCAttnDb, gBeepVolume);
+           (int)notchOn, gEq[0].hz, gEq[0].q, gADCAttnDb, gBeepVolume);
+  f.print("chain=");
+  for (int i = 0; i < gChainLen; i++) f.printf("%s%s", i ? "," : "", dspStageName(gChain[i]));
+  f.print('\n');
+  for (int i = 0; i < DSP_MAX_BIQUADS; i++) {
+    f.printf("eq%d=%s,%f,%f,%f\n", i + 1, dspFilterName(gEq[i].type), gEq[i].hz, gEq[i].q, gEq[i].gainDb);
+  }
+  f.printf("gate=%d,%d,%u,%u\n", (int)gGateOn, gGateThresh, gGateHoldMs, gGateReleaseMs);
+  f.printf("agc=%d,%d,%f,%f,%u,%u\n", (int)gAgcOn, gAgcTarget, gAgcMaxGainDb, gAgcRatio, gAgcAttackMs, gAgcReleaseMs);
   f.close();
   return true;
 }
+
+static void parseDspLine(char* line) {
+  char* eq = strchr(line, '=');
+  if (!eq) return;
+  *eq = 0;
+  const char* key = line; char* val = eq + 1;
+  if (strcmp(key, "chain") == 0) {
+    uint8_t st[DSP_STAGE_COUNT]; int n = 0;
+    for (char* t = strtok(val, ","); t && n < DSP_STAGE_COUNT; t = strtok(nullptr, ",")) {
+      int id = dspStageFromName(t);
+      if (id < 0) return;
+      st[n++] = (uint8_t)id;
+    }
+    audioSetChain(st, n);
+  } else if (strncmp(key, "eq", 2) == 0) {
+    char type[8]; float hz, q, g;
+    int slot = atoi(key + 2) - 1;
+    if (sscanf(val, "%7[^,],%f,%f,%f", type, &hz, &q, &g) == 4 && dspFilterFromName(type) >= 0) {
+      audioSetEq(slot, (DspFilter)dspFilterFromName(type), hz, q, g);
+    }
+  } else if (strcmp(key, "gate") == 0) {
+    int on, th; unsigned hold, rel;
+    if (sscanf(val, "%d,%d,%u,%u", &on, &th, &hold, &rel) == 4) audioSetGate(on != 0, th, hold, rel);
+  } else if (strcmp(key, "agc") == 0) {
+    int on, target; float maxDb, ratio; unsigned att, rel;
+    if (sscanf(val, "%d,%d,%f,%f,%u,%u", &on, &target, &maxDb, &ratio, &att, &rel) == 6) {
+      audioSetAgc(on != 0, target, maxDb, ratio, att, rel);
+    }
+  }
+}
+
 bool audioLoadSettingsFromSD() {
   File f = SD.open("/audio.cfg", FILE_READ);
   if (!f) return false;
-  String line = f.readStringUntil('\n'); f.close();
+  String line = f.readStringUntil('\n');
   int noiseOn=0, notchOn=0;
   int lim, floor, attn, beepV;
   int vol;
   float mix, hz, q, ptg;
   if (sscanf(line.c_str(), "%d,%f,%d,%d,%f,%d,%d,%f,%f,%d,%d",
-             &vol, &ptg, &lim, &noiseOn, &mix, &floor, &notchOn, &hz, &q, &attn, &beepV) == 11) {
-    gVolume = constrain(vol,0,255);
-    gPTGain = constrain(ptg, 0.1f, 12.0f);
-    gLimiter = constrain(lim,0,4095);
-    gNoiseOn = (noiseOn!=0);
-    gNoiseMix = constrain(mix,0.0f,1.0f);
-    gNoiseFloor = constrain(floor,0,4095);
-    gNotchOn = (notchOn!=0);
-    gNotchHz = hz; gNotchQ=q;
-    gBeepVolume = (uint8_t)constrain(beepV,0,255);
-    audioSetADCAttenuation(attn);
-    if (gNotchOn) setupNotch(8000.0f, gNotchHz, gNotchQ);
-    return true;
+             &vol, &ptg, &lim, &noiseOn, &mix, &floor, &notchOn, &hz, &q, &attn, &beepV) != 11) {
+    f.close();
+    return false;
   }
-  return false;
+  gVolume = constrain(vol,0,255);
+  gPTGain = constrain(ptg, 0.1f, 12.0f);
+  gLimiter = constrain(lim,2048,4095);
+  gNoiseOn = (noiseOn!=0);
+  gNoiseMix = constrain(mix,0.0f,1.0f);
+  gNoiseFloor = constrain(floor,0,4095);
+  gEq[0] = { notchOn ? DSP_F_NOTCH : DSP_F_OFF, hz, q, 0 };
+  gBeepVolume = (uint8_t)constrain(beepV,0,255);
+  audioSetADCAttenuation(attn);
+
+  // files from before the DSP chain end here and keep the remaining defaults
+  while (f.available()) {
+    String kv = f.readStringUntil('\n');
+    kv.trim();
+    char buf[96];
+    strlcpy(buf, kv.c_str(), sizeof(buf));
+    parseDspLine(buf);
+  }
+  f.close();
+  applyDsp();
+  return true;
 }
 bool audioDeleteSettingsFromSD() { return SD.remove("/audio.cfg"); }
 
 void audioPrintStatus(Stream& s) {
-  s.printf("Audio: vol=%u ptGain=%.2f limit=%d noise=%s mix=%.2f floor=%d notch=%s f=%.1fHz Q=%.1f idleMute=%s attn=%ddB beepVol=%u\n",
+  s.printf("Audio: vol=%u ptGain=%.2f limit=%d noise=%s mix=%.2f floor=%d idleMute=%s attn=%ddB beepVol=%u\n",
            gVolume, gPTGain, gLimiter, gNoiseOn?"ON":"OFF", gNoiseMix, gNoiseFloor,
-           gNotchOn?"ON":"OFF", gNotchHz, gNotchQ, gMuteWhenIdle?"ON":"OFF", gADCAttnDb, gBeepVolume);
+           gMuteWhenIdle?"ON":"OFF", gADCAttnDb, gBeepVolume);
+  for (int i = 0; i < DSP_MAX_BIQUADS; i++) {
+    if (gEq[i].type == DSP_F_OFF) continue;
+    s.printf("  EQ%d: %s f=%.1fHz Q=%.2f gain=%.1fdB\n", i + 1, dspFilterName(gEq[i].type), gEq[i].hz, gEq[i].q, gEq[i].gainDb);
+  }
+  DspStats ds; dspGetStats(ds);
+  s.printf("  Gate: %s thresh=%d hold=%ums release=%ums (%s)  AGC: %s target=%d max=%.1fdB ratio=%.1f attack=%ums release=%ums (gain %+.1fdB)\n",
+           gGateOn?"ON":"OFF", gGateThresh, gGateHoldMs, gGateReleaseMs, ds.gateOpen ? "open" : "closed",
+           gAgcOn?"ON":"OFF", gAgcTarget, gAgcMaxGainDb, gAgcRatio, gAgcAttackMs, gAgcReleaseMs, ds.agcGainDb);
+  const float cpuMhz = (float)ESP.getCpuFreqMHz();
+  s.print("  Chain:");
+  for (int i = 0; i < gChainLen; i++) {
+    s.printf(" %s=%.1fus", dspStageName(gChain[i]), ds.cycles[gChain[i]] / cpuMhz);
+  }
+  s.printf(" (total %.1fus)\n", ds.totalCycles / cpuMhz);
+  AudioStats st; audioGetStats(st);
+  s.printf("Audio stream: fs=%luHz measured=%.0fHz block=%d blocks=%lu underruns=%lu overruns=%lu drift=-%lu/+%lu dsp=%lu/%luus (last/max, budget %luus)\n",
+           (unsigned long)st.sampleRate, st.measuredRate, AUDIO_BLOCK_SAMPLES, (unsigned long)st.blocks,
+           (unsigned long)st.underruns, (unsigned long)st.overruns,
+           (unsigned long)st.driftDrops, (unsigned long)st.driftRepeats,
+           (unsigned long)st.dspUsLast, (unsigned long)st.dspUsMax,
+           (unsigned long)(1000000UL * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE));
+  SynthStats sy; synthGetStats(sy);
+  s.printf("Audio synth: notes=%lu active=%u dropped=%lu stolen=%lu\n",
+           (unsigned long)sy.notes, sy.active, (unsigned long)sy.dropped, (unsigned long)sy.stolen);
 }
 
 // Beeps
@@ -188,44 +448,31 @@ void audioBeepSetParams(float f, int d, int ed, float dec, uint8_t v) {
 void audioBeepSetVolume(uint8_t v) { gBeepVolume = v; }
 
 void audioToneTest(uint16_t freq, uint16_t ms, uint8_t vol, int dacPin) {
-  const int fs = 16000;
+  if (dacPin == DAC_PIN && gAudioTask) {
+    synthNote(freq, ms, vol / 255.0f * (120.0f / 128.0f));
+    return;
+  }
+  // another pin (wire test without the stream): blocking direct write
+  const int fs = AUDIO_SAMPLE_RATE;
   const float w = 2.0f * PI * freq;
   for (int i=0; i < (int)((ms/1000.0f)*fs); i++) {
     float t = (float)i/fs;
     int v = 128 + (int)(sinf(w*t) * (vol/255.0f) * 120.0f);
-    v = constrain(v, 0, 255);
-    dacWrite(dacPin, v);
+    dacWrite(dacPin, constrain(v, 0, 255));
     delayMicroseconds(1000000 / fs);
   }
-  dacWrite(DAC_PIN, 128);
+  dacWrite(dacPin, 128);
 }
 
+// beep + delayed echo as two queued notes; returns immediately
 static void playBeep(bool enabled) {
-  if (!enabled) return;
-  const int fs = 16000;
-  const float w = 2.0f * PI * gBeepFreqHz;
-  const float gain = (float)gBeepVolume / 255.0f * 0.7f;
-
-  const int Nmain  = (gBeepDurMs * fs)/1000;
-  const int Necho  = (gBeepDurMs * fs)/1000;
-  const int Ndelay = (gBeepEchoDelayMs * fs)/1000;
-  const int Ntotal = Nmain + Ndelay + Necho;
-
-  for (int i=0;i<Ntotal;i++) {
-    float t = (float)i / fs;
-    float sm = 0.0f;
-    if (i < Nmain) sm += sinf(w * t);
-    if (i >= Ndelay && i < (Ndelay+Necho)) {
-      float te = (float)(i - Ndelay) / fs;
-      sm += gBeepEchoDecay * sinf(w * te);
-    }
-    int v = 128 + (int)(sm*gain*127.0f);
-    v = constrain(v, 0, 255);
-    dacWrite(DAC_PIN, v);
-    delayMicroseconds(1000000 / fs);
-  }
-  dacWrite(DAC_PIN, 128);
+  if (!enabled || !gAudioTask) return;
+  const float amp = (float)gBeepVolume / 255.0f * 0.7f;
+  synthNote(gBeepFreqHz, gBeepDurMs, amp);
+  if (gBeepEchoDecay > 0) synthNote(gBeepFreqHz, gBeepDurMs, amp * gBeepEchoDecay, gBeepEchoDelayMs);
 }
 
 void audioBeepPlay() { playBeep(true); }
-void audioBeepTest() { playBeep(true); }
\ No newline at end of file
+void audioBeepTest() { playBeep(true); }
+void audioBeepTrackStart() { playBeep(gBeepStartOn); }
+void audioBeepTrackEnd()   { playBeep(gBeepEndOn); }
@@ -1,17 +1,32 @@
 #pragma once
 #include <Arduino.h>
 #include "config.h"
+#include "AudioDsp.h"
 
-// init/pass-through loop
+// init: starts ADC DMA, the DSP task and the DAC output timer (no polling needed)
 void audioInit();
-void audioLoop();
+
+struct AudioStats {
+  uint32_t sampleRate;     // configured
+  float    measuredRate;   // samples/s actually processed
+  uint32_t blocks;
+  uint32_t underruns;      // DAC ticks with an empty output ring
+  uint32_t overruns;       // samples dropped: output ring full or ADC pool overflow
+  uint32_t driftDrops, driftRepeats;   // ADC/DAC clock drift corrections, one sample each
+  uint32_t dspUsLast, dspUsMax;
+};
+void audioGetStats(AudioStats& out);
 
 // passthrough controls / status
 void audioSetVolume(uint8_t vol);
 void audioSetPTGain(float mult);
-void audioSetLimiter(int lim);
+void audioSetLimiter(int lim);                                  // 2048..4095
 void audioSetNoise(bool on, float mix, int floor);
-void audioSetNotch(bool on, float hz, float q);
+void audioSetNotch(bool on, float hz, float q);                 // = EQ slot 1 as a notch
+bool audioSetEq(int slot, DspFilter type, float hz, float q, float gainDb);  // slot 0..3
+void audioSetGate(bool on, int thresh, uint16_t holdMs, uint16_t releaseMs);
+void audioSetAgc(bool on, int target, float maxGainDb, float ratio, uint16_t attackMs, uint16_t releaseMs);
+bool audioSetChain(const uint8_t* stages, int count);          // DspStage ids, each at most once
 void audioSetADCAttenuation(int db); // 0,2,6,11 dB
 void audioSetMuteWhenIdle(bool enable);
 void audioResetToDefaults();
@@ -25,8 +40,10 @@ void audioBeepEnableStart(bool on);
 void audioBeepEnableEnd(bool on);
 void audioBeepSetParams(float freqHz, int durMs, int echoDelayMs, float echoDecay, uint8_t vol);
 void audioBeepSetVolume(uint8_t vol);
-void audioBeepPlay();
+void audioBeepPlay();           // all beeps are queued to the stream synth and return at once
 void audioBeepTest();
+void audioBeepTrackStart();     // if BEEP START is on
+void audioBeepTrackEnd();       // if BEEP END is on
 
-// quick tone generator (wire test)
+// quick tone generator (wire test; blocks only when writing a pin other than DAC_PIN)
 void audioToneTest(uint16_t freq = 1000, uint16_t ms = 800, uint8_t vol = 180, int dacPin = DAC_PIN);
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "AudioSynth.h"
+#include "config.h"
+
+#define SYNTH_TABLE_BITS 10
+#define SYNTH_TABLE_SIZE (1 << SYNTH_TABLE_BITS)
+#define SYNTH_QUEUE_MASK (SYNTH_QUEUE_DEPTH - 1)
+
+struct NoteEvent { uint32_t inc; int32_t amp; uint32_t delay, dur; };
+
+struct Voice {
+  bool     active;
+  uint32_t phase, inc;
+  int32_t  amp;             // Q15
+  uint32_t delay;           // samples until the note starts
+  uint32_t pos, dur;        // samples
+};
+
+static int16_t  sTable[SYNTH_TABLE_SIZE];   // one sine period, Q15
+static uint32_t sRate = 20000;
+static uint32_t sAttack = 1, sRelease = 1;  // samples
+static int32_t  sAttackStep = 32767, sReleaseStep = 32767;
+
+// single producer (loop task) / single consumer (DSP task)
+static NoteEvent sQueue[SYNTH_QUEUE_DEPTH];
+static volatile uint32_t sHead = 0, sTail = 0;
+
+static Voice sVoices[SYNTH_VOICES];
+static volatile uint8_t  sActive = 0;
+static volatile uint32_t sNotes = 0, sDropped = 0, sStolen = 0;
+
+void synthBegin(uint32_t sampleRate) {
+  sRate = sampleRate;
+  for (int i = 0; i < SYNTH_TABLE_SIZE; i++) {
+    sTable[i] = (int16_t)lroundf(32767.0f * sinf(2.0f * PI * i / SYNTH_TABLE_SIZE));
+  }
+  sAttack  = max<uint32_t>(1, SYNTH_ATTACK_MS * sampleRate / 1000);
+  sRelease = max<uint32_t>(1, SYNTH_RELEASE_MS * sampleRate / 1000);
+  sAttackStep  = 32767 / sAttack;
+  sReleaseStep = 32767 / sRelease;
+}
+
+bool synthNote(float hz, uint16_t durMs, float amp, uint16_t delayMs) {
+  if (sHead - sTail >= SYNTH_QUEUE_DEPTH) { sDropped = sDropped + 1; return false; }
+  hz = constrain(hz, 20.0f, sRate * 0.45f);
+  NoteEvent& e = sQueue[sHead & SYNTH_QUEUE_MASK];
+  e.inc   = (uint32_t)((double)hz * 4294967296.0 / sRate);
+  e.amp   = (int32_t)(constrain(amp, 0.0f, 1.0f) * 32767.0f);
+  e.delay = (uint32_t)delayMs * sRate / 1000;
+  e.dur   = max<uint32_t>(1, (uint32_t)durMs * sRate / 1000);
+  sHead = sHead + 1;
+  return true;
+}
+
+static void startVoice(const NoteEvent& e) {
+  Voice* v = nullptr;
+  for (auto& c : sVoices) if (!c.active) { v = &c; break; }
+  if (!v) {   // steal the note that has played longest
+    v = &sVoices[0];
+    for (auto& c : sVoices) if (c.pos > v->pos) v = &c;
+    sStolen = sStolen + 1;
+  }
+  *v = { true, 0, e.inc, e.amp, e.delay, 0, e.dur };
+  sNotes = sNotes + 1;
+}
+
+static inline int32_t envelope(uint32_t pos, uint32_t dur) {
+  int32_t env = pos >= sAttack ? 32767 : (int32_t)pos * sAttackStep;
+  uint32_t rem = dur - pos;
+  if (rem < sRelease) env = min(env, (int32_t)rem * sReleaseStep);
+  return env;
+}
+
+void synthRender(int32_t* x, int n) {
+  while (sTail != sHead) {
+    startVoice(sQueue[sTail & SYNTH_QUEUE_MASK]);
+    sTail = sTail + 1;
+  }
+
+  uint8_t active = 0;
+  for (auto& v : sVoices) {
+    if (!v.active) continue;
+    if (v.delay >= (uint32_t)n) { v.delay -= n; active++; continue; }
+    int i = (int)v.delay;
+    v.delay = 0;
+
+    uint32_t phase = v.phase, pos = v.pos;
+    const uint32_t inc = v.inc, dur = v.dur;
+    const int32_t amp = v.amp;
+    for (; i < n && pos < dur; i++, pos++, phase += inc) {
+      int32_t s = sTable[phase >> (32 - SYNTH_TABLE_BITS)];
+      int32_t g = (envelope(pos, dur) * amp) >> 15;
+      x[i] += (s * g) >> 15;
+    }
+    v.phase = phase; v.pos = pos;
+    if (pos >= dur) v.active = false;
+    else active++;
+  }
+  sActive = active;
+}
+
+bool synthBusy() {
+  return sHead != sTail || sActive > 0;
+}
+
+void synthGetStats(SynthStats& out) {
+  out.notes = sNotes; out.dropped = sDropped; out.stolen = sStolen; out.active = sActive;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+
+// Wavetable tone generator mixed into the audio stream. Notes are queued from the loop
+// task in constant time and rendered block by block in the DSP task, so beeps never
+// stall tracking. Output is Q15, added on top of the processed passthrough.
+
+void synthBegin(uint32_t sampleRate);
+
+// amp 0..1 of full scale; delayMs postpones the start (echoes). False if the queue is full.
+bool synthNote(float hz, uint16_t durMs, float amp, uint16_t delayMs = 0);
+
+void synthRender(int32_t* q15, int n);   // DSP task: adds active voices to the block
+bool synthBusy();                        // notes queued or playing
+
+struct SynthStats { uint32_t notes, dropped, stolen; uint8_t active; };
+void synthGetStats(SynthStats& out);
@@ -1,15 +1,18 @@
 #include "Commands.h"
+#include "TimeSync.h"
 #include <strings.h>
 
-// Resolve references defined in the .ino:
-extern String currentUTC;
-extern unsigned long isoToUnix(const String& iso);
+#define CMD_LINE_MAX    384   // one serial line / one UDP batch
+#define CMD_MAX_TOKENS  12
 
 namespace Commands {
 
   // ---------- Module state ----------
   static Stream* io = nullptr;
-  static String line;
+  static char    line[CMD_LINE_MAX];      // serial line being received
+  static size_t  lineLen = 0;
+  static bool    lineOverflow = false;
+  static char    batch[CMD_LINE_MAX];     // working copy for inject()
 
   static bool (*reqSatCb)() = nullptr;
   static void (*statusPrinter)(Stream&) = nullptr;
@@ -21,171 +24,262 @@ namespace Commands {
   static void (*gotoAzCb)(float) = nullptr;
   static void (*gotoElCb)(float) = nullptr;
 
-  // ---------- utils ----------
-  static String token(const String& s, int idx) {
-    int start=0, end=0, found=-1;
-    while (true) {
-      while (start<(int)s.length() && s[start]==' ') start++;
-      if (start >= (int)s.length()) break;
-      end = s.indexOf(' ', start);
-      if (end < 0) end = s.length();
-      found++;
-      if (found==idx) return s.substring(start,end);
-      start = end+1;
+  // ---------- tokens ----------
+  // A command is split in place into whitespace-separated tokens; v[0] and v[1] select the
+  // table entry, handlers read their arguments by position.
+  struct Args { char* v[CMD_MAX_TOKENS]; int n; };
+
+  static const char* arg(const Args& a, int i)            { return i < a.n ? a.v[i] : ""; }
+  static bool  has(const Args& a, int i)                   { return i < a.n; }
+  static bool  argIs(const Args& a, int i, const char* w)  { return strcasecmp(arg(a,i), w) == 0; }
+  static bool  argOn(const Args& a, int i)                 { return argIs(a,i,"ON"); }
+  static long  argInt(const Args& a, int i, long def = 0)  { return has(a,i) ? atol(a.v[i]) : def; }
+  static float argFloat(const Args& a, int i, float def = 0) { return has(a,i) ? (float)atof(a.v[i]) : def; }
+
+  static int tokenize(char* s, Args& a) {
+    a.n = 0;
+    while (*s && a.n < CMD_MAX_TOKENS) {
+      while (*s == ' ' || *s == '\t') s++;
+      if (!*s) break;
+      a.v[a.n++] = s;
+      while (*s && *s != ' ' && *s != '\t') s++;
+      if (*s) *s++ = '\0';
     }
-    return String();
+    return a.n;
   }
-  static String upcopy(const String& s){ String u=s; u.toUpperCase(); return u; }
 
-  static void help() {
-    if (!io) return;
-    io->println(F("Commands:"));
-    io->println(F("  HELP / ?"));
-    io->println(F("  START / STOP"));
-    io->println(F("  HOME / HOME SET"));
-    io->println(F("  STEP AZ <steps> / STEP EL <steps>"));
-    io->println(F("  GOTO AZ <deg> / GOTO EL <deg>"));
-    io->println(F("  LASER OFF|ON|TRACK"));
-    io->println(F("  SAT NEW"));
-    io->println(F("  AUDIO VOL <0-255>"));
-    io->println(F("  AUDIO GAIN <mult>"));
-    io->println(F("  AUDIO LIMIT <0-4095>"));
-    io->println(F("  AUDIO IDLEMUTE ON|OFF"));
-    io->println(F("  AUDIO ADCATTN <0|2|6|11>"));
-    io->println(F("  AUDIO NOISE <ON|OFF> [mix 0-1] [floor 0-4095]"));
-    io->println(F("  AUDIO NOTCH <ON|OFF> [hz] [q]"));
-    io->println(F("  AUDIO RESET DEFAULTS / SAVE / LOAD / DELETE"));
-    io->println(F("  BEEP VOL <0-255>"));
-    io->println(F("  BEEP START <ON|OFF> / BEEP END <ON|OFF>"));
-    io->println(F("  BEEP SET <freqHz> <durMs> <echoMs> <decay0-1> <vol0-255>"));
-    io->println(F("  BEEP TEST"));
-#if USE_TESTRUN
-    io->println(F("  TEST START <az0> <az1> <peakEl> <durSec> [holdSec] [LOOP]"));
-    io->println(F("  TEST PRESET <1|2|3>"));
-    io->println(F("  TEST STOP / TEST STATUS"));
-#endif
-    io->println(F("  STATUS"));
+  // case-insensitive FNV-1a, evaluated at compile time for the table
+  static constexpr uint32_t kw(const char* s) {
+    if (!s || !*s) return 0;
+    uint32_t h = 2166136261u;
+    for (; *s; s++) {
+      char c = (*s >= 'a' && *s <= 'z') ? (char)(*s - 32) : *s;
+      h = (h ^ (uint8_t)c) * 16777619u;
+    }
+    return h;
   }
 
-  // Make the handler NON-static so we can call it from CommandsInject too
-  void handleImpl(const String& raw) {
-    if (!io) return;
-    String s=raw; s.trim(); if(!s.length()) return;
-    String up = upcopy(s);
+  // ---------- handlers ----------
+  static void help();
 
-    if (up=="HELP" || up=="?") { help(); return; }
+  static void cmdHelp(Args&)  { help(); }
+  static void cmdStart(Args&) { if (startCb && startCb()) io->println(F("OK START")); else io->println(F("ERR START")); }
+  static void cmdStop(Args&)  { if (stopCb) stopCb(); else io->println(F("ERR STOP")); }
+  static void cmdHome(Args&)  { motorsSetTrackingActive(false); motorsReturnToNull(); io->println(F("OK HOME")); }
+  static void cmdHomeSet(Args&) { motorsZeroHere(); io->println(F("OK HOME SET")); }
 
-    if (up=="START") { if (startCb && startCb()) io->println(F("OK START")); else io->println(F("ERR START")); return; }
-    if (up=="STOP")  { if (stopCb) stopCb(); else io->println(F("ERR STOP")); return; }
+  static void cmdStepAz(Args& a) { if (stepAzCb) stepAzCb((int32_t)argInt(a,2)); else io->println(F("ERR STEP AZ")); }
+  static void cmdStepEl(Args& a) { if (stepElCb) stepElCb((int32_t)argInt(a,2)); else io->println(F("ERR STEP EL")); }
+  static void cmdStepErr(Args&)  { io->println(F("ERR STEP AZ|EL <steps>")); }
+  static void cmdGotoAz(Args& a) { if (gotoAzCb) gotoAzCb(argFloat(a,2)); else io->println(F("ERR GOTO AZ")); }
+  static void cmdGotoEl(Args& a) { if (gotoElCb) gotoElCb(argFloat(a,2)); else io->println(F("ERR GOTO EL")); }
+  static void cmdGotoErr(Args&)  { io->println(F("ERR GOTO AZ|EL <deg>")); }
 
-    if (up=="HOME") { motorsSetTrackingActive(false); motorsReturnToNull(); io->println(F("OK HOME")); return; }
-    if (up=="HOME SET") { motorsZeroHere(); io->println(F("OK HOME SET")); return; }
+  static void cmdLaser(Args& a) {
+    if (argIs(a,1,"OFF"))   { motorsSetLaserMode(LASER_OFF);   io->println(F("OK LASER OFF"));   return; }
+    if (argIs(a,1,"ON"))    { motorsSetLaserMode(LASER_ON);    io->println(F("OK LASER ON"));    return; }
+    if (argIs(a,1,"TRACK")) { motorsSetLaserMode(LASER_TRACK); io->println(F("OK LASER TRACK")); return; }
+    io->println(F("ERR LASER <OFF|ON|TRACK>"));
+  }
 
-    if (up.startsWith("STEP ")) {
-      String axis = token(up,1);
-      long steps = token(s,2).toInt();
-      if (axis=="AZ") { if (stepAzCb) stepAzCb((int32_t)steps); else io->println(F("ERR STEP AZ")); }
-      else if (axis=="EL") { if (stepElCb) stepElCb((int32_t)steps); else io->println(F("ERR STEP EL")); }
-      else io->println(F("ERR STEP AZ|EL <steps>"));
-      return;
-    }
+  static void cmdSatNew(Args&) {
+    if (reqSatCb) io->println(reqSatCb()?F("OK SAT NEW"):F("ERR SAT NEW"));
+    else io->println(F("ERR no SAT NEW callback set"));
+  }
 
-    if (up.startsWith("GOTO ")) {
-      String axis = token(up,1);
-      float deg = token(s,2).toFloat();
-      if (axis=="AZ") { if (gotoAzCb) gotoAzCb(deg); else io->println(F("ERR GOTO AZ")); }
-      else if (axis=="EL") { if (gotoElCb) gotoElCb(deg); else io->println(F("ERR GOTO EL")); }
-      else io->println(F("ERR GOTO AZ|EL <deg>"));
-      return;
+  // AUDIO
+  static void cmdAudioVol(Args& a)   { int v=constrain((int)argInt(a,2),0,255); audioSetVolume(v); io->printf("OK VOL=%d\n", v); }
+  static void cmdAudioGain(Args& a)  { float mult=argFloat(a,2); if(mult<=0){io->println(F("ERR AUDIO GAIN <mult>"));return;} audioSetPTGain(mult); io->printf("OK AUDIO GAIN %.2f\n", mult); }
+  static void cmdAudioLimit(Args& a) { int lim=constrain((int)argInt(a,2),2048,4095); audioSetLimiter(lim); io->printf("OK LIMIT=%d\n", lim); }
+  static void cmdAudioIdleMute(Args& a) { bool en=argOn(a,2); audioSetMuteWhenIdle(en); io->printf("OK AUDIO IDLEMUTE %s\n", en?"ON":"OFF"); }
+  static void cmdAudioAdcAttn(Args& a) {
+    int db=(int)argInt(a,2);
+    if(db!=0&&db!=2&&db!=6&&db!=11){io->println(F("ERR AUDIO ADCATTN 0|2|6|11"));return;}
+    audioSetADCAttenuation(db); io->printf("OK AUDIO ADCATTN %d\n", db);
+  }
+  static void cmdAudioNoise(Args& a) {
+    bool on=argOn(a,2);
+    float mix=constrain(argFloat(a,3,INJECT_NOISE_MIX),0.0f,1.0f);
+    int floor=constrain((int)argInt(a,4,INJECT_NOISE_FLOOR),0,4095);
+    audioSetNoise(on,mix,floor); io->printf("OK NOISE %s mix=%.2f floor=%d\n", on?"ON":"OFF", mix, floor);
+  }
+  static void cmdAudioNotch(Args& a) {
+    bool on=argOn(a,2);
+    float hz=argFloat(a,3,NOTCH_HZ), q=argFloat(a,4,NOTCH_Q);
+    audioSetNotch(on,hz,q); io->printf("OK NOTCH %s f=%.1f q=%.2f\n", on?"ON":"OFF", hz, q);
+  }
+  static void cmdAudioEq(Args& a) {
+    int slot=(int)argInt(a,2); int type=dspFilterFromName(arg(a,3));
+    float hz=argFloat(a,4), q=argFloat(a,5,0.707f), g=argFloat(a,6);
+    if(type==DSP_F_OFF && hz<=0) hz=1000;
+    if(type<0 || !audioSetEq(slot-1,(DspFilter)type,hz,q,g)){io->println(F("ERR AUDIO EQ <1-4> OFF|NOTCH|LP|HP|BP|PEAK <hz> [q] [gainDb]"));return;}
+    io->printf("OK EQ%d %s f=%.1f q=%.2f gain=%.1fdB\n", slot, dspFilterName(type), hz, q, g);
+  }
+  static void cmdAudioGate(Args& a) {
+    bool on=argOn(a,2);
+    int th=(int)argInt(a,3,AUDIO_GATE_THRESH);
+    int hold=constrain((int)argInt(a,4,AUDIO_GATE_HOLD_MS),0,10000), rel=constrain((int)argInt(a,5,AUDIO_GATE_RELEASE_MS),1,10000);
+    audioSetGate(on,th,hold,rel); io->printf("OK GATE %s thresh=%d hold=%dms release=%dms\n", on?"ON":"OFF", th, hold, rel);
+  }
+  static void cmdAudioAgc(Args& a) {
+    bool on=argOn(a,2);
+    int target=(int)argInt(a,3,AUDIO_AGC_TARGET);
+    float maxDb=argFloat(a,4,AUDIO_AGC_MAX_GAIN_DB), ratio=argFloat(a,5,AUDIO_AGC_RATIO);
+    int att=constrain((int)argInt(a,6,AUDIO_AGC_ATTACK_MS),0,10000), rel=constrain((int)argInt(a,7,AUDIO_AGC_RELEASE_MS),0,10000);
+    audioSetAgc(on,target,maxDb,ratio,att,rel);
+    io->printf("OK AGC %s target=%d max=%.1fdB ratio=%.1f attack=%dms release=%dms\n", on?"ON":"OFF", target, maxDb, ratio, att, rel);
+  }
+  static void cmdAudioChain(Args& a) {
+    uint8_t st[DSP_STAGE_COUNT]; int n=0; bool ok=true;
+    for (int i=2; i<a.n; i++) {
+      int id=dspStageFromName(a.v[i]);
+      if(id<0 || n>=DSP_STAGE_COUNT){ ok=false; break; }
+      st[n++]=(uint8_t)id;
     }
+    if(!ok || !audioSetChain(st,n)){io->println(F("ERR AUDIO CHAIN <GAIN|NOISE|EQ|GATE|AGC|LIMIT ...> (each once)"));return;}
+    io->print(F("OK CHAIN")); for(int i=0;i<n;i++) io->printf(" %s", dspStageName(st[i])); io->println();
+  }
+  static void cmdAudioReset(Args& a) {
+    if (!argIs(a,2,"DEFAULTS")) { io->println(F("ERR AUDIO RESET DEFAULTS")); return; }
+    audioResetToDefaults(); io->println(F("OK AUDIO DEFAULTS"));
+  }
+  static void cmdAudioSave(Args&)   { io->println(audioSaveSettingsToSD()?F("OK AUDIO SAVE"):F("ERR AUDIO SAVE")); }
+  static void cmdAudioLoad(Args&)   { io->println(audioLoadSettingsFromSD()?F("OK AUDIO LOAD"):F("ERR AUDIO LOAD")); }
+  static void cmdAudioDelete(Args&) { io->println(audioDeleteSettingsFromSD()?F("OK AUDIO DELETE"):F("ERR AUDIO DELETE")); }
 
-    if (up.startsWith("LASER ")) {
-      String m = token(up,1);
-      if (m=="OFF") { motorsSetLaserMode(LASER_OFF); io->println(F("OK LASER OFF")); return; }
-      if (m=="ON")  { motorsSetLaserMode(LASER_ON);  io->println(F("OK LASER ON"));  return; }
-      if (m=="TRACK"){motorsSetLaserMode(LASER_TRACK);io->println(F("OK LASER TRACK")); return; }
-      io->println(F("ERR LASER <OFF|ON|TRACK>")); return;
-    }
+  // BEEP
+  static void cmdBeepVol(Args& a)   { int v=constrain((int)argInt(a,2),0,255); audioBeepSetVolume((uint8_t)v); io->printf("OK BEEP VOL %d\n", v); }
+  static void cmdBeepStart(Args& a) { bool on=argOn(a,2); audioBeepEnableStart(on); io->printf("OK BEEP START %s\n", on?"ON":"OFF"); }
+  static void cmdBeepEnd(Args& a)   { bool on=argOn(a,2); audioBeepEnableEnd(on);   io->printf("OK BEEP END %s\n", on?"ON":"OFF"); }
+  static void cmdBeepSet(Args& a) {
+    if (a.n < 7) { io->println(F("ERR BEEP SET <freqHz> <durMs> <echoMs> <decay0-1> <vol0-255>")); return; }
+    float f=argFloat(a,2), dec=argFloat(a,5); int d=(int)argInt(a,3), ed=(int)argInt(a,4), v=(int)argInt(a,6);
+    audioBeepSetParams(max(50.0f,f), max(10,d), max(0,ed), constrain(dec,0.0f,1.0f), (uint8_t)constrain(v,0,255));
+    io->println(F("OK BEEP SET"));
+  }
+  static void cmdBeepTest(Args&) { audioBeepTest(); io->println(F("OK BEEP TEST")); }
 
-    // AUDIO
-    if (up.startsWith("AUDIO VOL "))    { int v=token(s,2).toInt(); v=constrain(v,0,255); audioSetVolume(v); io->printf("OK VOL=%d\n", v); return; }
-    if (up.startsWith("AUDIO GAIN "))   { float mult=token(s,2).toFloat(); if(mult<=0){io->println(F("ERR AUDIO GAIN <mult>"));return;} audioSetPTGain(mult); io->printf("OK AUDIO GAIN %.2f\n", mult); return; }
-    if (up.startsWith("AUDIO LIMIT "))  { int lim=token(s,2).toInt(); lim=constrain(lim,0,4095); audioSetLimiter(lim); io->printf("OK LIMIT=%d\n", lim); return; }
-    if (up.startsWith("AUDIO IDLEMUTE ")){ bool en=token(s,2).equalsIgnoreCase("ON"); audioSetMuteWhenIdle(en); io->printf("OK AUDIO IDLEMUTE %s\n", en?"ON":"OFF"); return; }
-    if (up.startsWith("AUDIO ADCATTN ")){ int db=token(s,2).toInt(); if(db!=0&&db!=2&&db!=6&&db!=11){io->println(F("ERR AUDIO ADCATTN 0|2|6|11"));return;} audioSetADCAttenuation(db); io->printf("OK AUDIO ADCATTN %d\n", db); return; }
-    if (up.startsWith("AUDIO NOISE "))  {
-      String onTok=token(s,2); bool on=onTok.equalsIgnoreCase("ON");
-      float mix=INJECT_NOISE_MIX; int floor=INJECT_NOISE_FLOOR; String t3=token(s,3),t4=token(s,4);
-      if(t3.length()) mix=t3.toFloat(); if(t4.length()) floor=t4.toInt();
-      mix=constrain(mix,0.0f,1.0f); floor=constrain(floor,0,4095);
-      audioSetNoise(on,mix,floor); io->printf("OK NOISE %s mix=%.2f floor=%d\n", on?"ON":"OFF", mix, floor); return;
-    }
-    if (up.startsWith("AUDIO NOTCH "))  {
-      String onTok=token(s,2); bool on=onTok.equalsIgnoreCase("ON");
-      float hz=NOTCH_HZ, q=NOTCH_Q; String t3=token(s,3),t4=token(s,4);
-      if(t3.length()) hz=t3.toFloat(); if(t4.length()) q=t4.toFloat();
-      audioSetNotch(on,hz,q); io->printf("OK NOTCH %s f=%.1f q=%.2f\n", on?"ON":"OFF", hz, q); return;
-    }
-    if (up=="AUDIO RESET DEFAULTS") { audioResetToDefaults(); io->println(F("OK AUDIO DEFAULTS")); return; }
-    if (up=="AUDIO SAVE")   { io->println(audioSaveSettingsToSD()?F("OK AUDIO SAVE"):F("ERR AUDIO SAVE")); return; }
-    if (up=="AUDIO LOAD")   { io->println(audioLoadSettingsFromSD()?F("OK AUDIO LOAD"):F("ERR AUDIO LOAD")); return; }
-    if (up=="AUDIO DELETE") { io->println(audioDeleteSettingsFromSD()?F("OK AUDIO DELETE"):F("ERR AUDIO DELETE")); return; }
-
-    // BEEP
-    if (up.startsWith("BEEP VOL "))     { int v=token(s,2).toInt(); v=constrain(v,0,255); audioBeepSetVolume((uint8_t)v); io->printf("OK BEEP VOL %d\n", v); return; }
-    if (up.startsWith("BEEP START "))   { bool on=token(s,2).equalsIgnoreCase("ON"); audioBeepEnableStart(on); io->printf("OK BEEP START %s\n", on?"ON":"OFF"); return; }
-    if (up.startsWith("BEEP END "))     { bool on=token(s,2).equalsIgnoreCase("ON"); audioBeepEnableEnd(on);   io->printf("OK BEEP END %s\n", on?"ON":"OFF");   return; }
-    if (up.startsWith("BEEP SET "))     {
-      float f; int d,ed; float dec; int v;
-      if (sscanf(s.c_str()+9, "%f %d %d %f %d",&f,&d,&ed,&dec,&v)==5) {
-        audioBeepSetParams(max(50.0f,f), max(10,d), max(0,ed), constrain(dec,0.0f,1.0f), (uint8_t)constrain(v,0,255));
-        io->println(F("OK BEEP SET"));
-      } else io->println(F("ERR BEEP SET <freqHz> <durMs> <echoMs> <decay0-1> <vol0-255>"));
-      return;
-    }
-    if (up=="BEEP TEST") { audioBeepTest(); io->println(F("OK BEEP TEST")); return; }
+#if USE_TESTRUN
+  static void cmdTestStart(Args& a) {
+    if (a.n < 6) { io->println(F("ERR TEST START <az0> <az1> <peakEl> <durSec> [holdSec] [LOOP]")); return; }
+    bool loop=argIs(a,7,"LOOP");
+    TestRun::configure(argFloat(a,2),argFloat(a,3),argFloat(a,4),(uint32_t)argInt(a,5),(uint32_t)argInt(a,6),loop);
+    TestRun::enable(true);
+    if (!timeSyncIsSynced()) TestRun::startNow(); else TestRun::startAt((time_t)timeSyncNowUnix());
+    io->println(F("OK TEST START"));
+  }
+  static void cmdTestStop(Args&)   { TestRun::enable(false); io->println(F("OK TEST STOP")); }
+  static void cmdTestStatus(Args&) { TestRun::printStatus(*io); }
+  static void cmdTestPreset(Args& a) {
+    int id=(int)argInt(a,2);
+    if (id==1) TestRun::configure(220,320,45,180,10,true);
+    else if (id==2) TestRun::configure( 90,270,70,240, 0,false);
+    else if (id==3) TestRun::configure(350, 30,30,120, 5,true);
+    else { io->println(F("ERR TEST PRESET 1|2|3")); return; }
+    TestRun::enable(true);
+    if (!timeSyncIsSynced()) TestRun::startNow(); else TestRun::startAt((time_t)timeSyncNowUnix());
+    io->printf("OK TEST PRESET %d\n", id);
+  }
+#endif
 
-    if (up=="SAT NEW") {
-      if (reqSatCb) io->println(reqSatCb()?F("OK SAT NEW"):F("ERR SAT NEW"));
-      else io->println(F("ERR no SAT NEW callback set"));
-      return;
-    }
+  static void cmdStatus(Args&) { if (statusPrinter) statusPrinter(*io); else io->println(F("STATUS printer not set")); }
+
+  // ---------- command table ----------
+  // Entries with a sub keyword win over the bare keyword; usage==nullptr hides an entry from HELP.
+  struct Cmd {
+    const char* name; const char* sub;
+    uint32_t    h0, h1;
+    void      (*fn)(Args&);
+    const char* usage;
+  };
+  #define CMD(name, sub, fn, usage) { name, sub, kw(name), kw(sub), fn, usage }
 
+  static constexpr Cmd TABLE[] = {
+    CMD("HELP",  "",         cmdHelp,       "HELP / ?"),
+    CMD("?",     "",         cmdHelp,       nullptr),
+    CMD("START", "",         cmdStart,      "START / STOP"),
+    CMD("STOP",  "",         cmdStop,       nullptr),
+    CMD("HOME",  "SET",      cmdHomeSet,    nullptr),
+    CMD("HOME",  "",         cmdHome,       "HOME / HOME SET"),
+    CMD("STEP",  "AZ",       cmdStepAz,     "STEP AZ <steps> / STEP EL <steps>"),
+    CMD("STEP",  "EL",       cmdStepEl,     nullptr),
+    CMD("STEP",  "",         cmdStepErr,    nullptr),
+    CMD("GOTO",  "AZ",       cmdGotoAz,     "GOTO AZ <deg> / GOTO EL <deg>"),
+    CMD("GOTO",  "EL",       cmdGotoEl,     nullptr),
+    CMD("GOTO",  "",         cmdGotoErr,    nullptr),
+    CMD("LASER", "",         cmdLaser,      "LASER OFF|ON|TRACK"),
+    CMD("SAT",   "NEW",      cmdSatNew,     "SAT NEW"),
+    CMD("AUDIO", "VOL",      cmdAudioVol,   "AUDIO VOL <0-255>"),
+    CMD("AUDIO", "GAIN",     cmdAudioGain,  "AUDIO GAIN <mult>"),
+    CMD("AUDIO", "LIMIT",    cmdAudioLimit, "AUDIO LIMIT <2048-4095>"),
+    CMD("AUDIO", "IDLEMUTE", cmdAudioIdleMute, "AUDIO IDLEMUTE ON|OFF"),
+    CMD("AUDIO", "ADCATTN",  cmdAudioAdcAttn,  "AUDIO ADCATTN <0|2|6|11>"),
+    CMD("AUDIO", "NOISE",    cmdAudioNoise, "AUDIO NOISE <ON|OFF> [mix 0-1] [floor 0-4095]"),
+    CMD("AUDIO", "NOTCH",    cmdAudioNotch, "AUDIO NOTCH <ON|OFF> [hz] [q]          (EQ slot 1)"),
+    CMD("AUDIO", "EQ",       cmdAudioEq,    "AUDIO EQ <1-4> OFF|NOTCH|LP|HP|BP|PEAK <hz> [q] [gainDb]"),
+    CMD("AUDIO", "GATE",     cmdAudioGate,  "AUDIO GATE <ON|OFF> [thresh] [holdMs] [releaseMs]"),
+    CMD("AUDIO", "AGC",      cmdAudioAgc,   "AUDIO AGC <ON|OFF> [target] [maxGainDb] [ratio] [attackMs] [releaseMs]"),
+    CMD("AUDIO", "CHAIN",    cmdAudioChain, "AUDIO CHAIN <stage ...>  stages: GAIN NOISE EQ GATE AGC LIMIT"),
+    CMD("AUDIO", "RESET",    cmdAudioReset, "AUDIO RESET DEFAULTS / SAVE / LOAD / DELETE"),
+    CMD("AUDIO", "SAVE",     cmdAudioSave,  nullptr),
+    CMD("AUDIO", "LOAD",     cmdAudioLoad,  nullptr),
+    CMD("AUDIO", "DELETE",   cmdAudioDelete, nullptr),
+    CMD("BEEP",  "VOL",      cmdBeepVol,    "BEEP VOL <0-255>"),
+    CMD("BEEP",  "START",    cmdBeepStart,  "BEEP START <ON|OFF> / BEEP END <ON|OFF>"),
+    CMD("BEEP",  "END",      cmdBeepEnd,    nullptr),
+    CMD("BEEP",  "SET",      cmdBeepSet,    "BEEP SET <freqHz> <durMs> <echoMs> <decay0-1> <vol0-255>"),
+    CMD("BEEP",  "TEST",     cmdBeepTest,   "BEEP TEST"),
 #if USE_TESTRUN
-    if (up.startsWith("TEST START ")) {
-      float az0=0, az1=0, pel=0; long dur=0, hold=0; char loopTxt[8]={0};
-      int n=sscanf(s.c_str()+11,"%f %f %f %ld %ld %7s",&az0,&az1,&pel,&dur,&hold,loopTxt);
-      bool loop=(n>=6 && strcasecmp(loopTxt,"LOOP")==0);
-      if (n<4){ io->println(F("ERR TEST START <az0> <az1> <peakEl> <durSec> [holdSec] [LOOP]")); return; }
-      if (n<5) hold=0;
-      TestRun::configure(az0,az1,pel,(uint32_t)dur,(uint32_t)hold,loop);
-      TestRun::enable(true);
-      unsigned long ut=isoToUnix(currentUTC);
-      if (!ut) TestRun::startNow(); else TestRun::startAt((time_t)ut);
-      io->println(F("OK TEST START")); return;
-    }
-    if (up=="TEST STOP")   { TestRun::enable(false); io->println(F("OK TEST STOP")); return; }
-    if (up=="TEST STATUS") { TestRun::printStatus(*io); return; }
-    if (up.startsWith("TEST PRESET ")) {
-      int id=token(s,2).toInt();
-      if (id==1) TestRun::configure(220,320,45,180,10,true);
-      else if (id==2) TestRun::configure( 90,270,70,240, 0,false);
-      else if (id==3) TestRun::configure(350, 30,30,120, 5,true);
-      else { io->println(F("ERR TEST PRESET 1|2|3")); return; }
-      TestRun::enable(true);
-      unsigned long ut=isoToUnix(currentUTC);
-      if (!ut) TestRun::startNow(); else TestRun::startAt((time_t)ut);
-      io->printf("OK TEST PRESET %d\n", id); return;
-    }
+    CMD("TEST",  "START",    cmdTestStart,  "TEST START <az0> <az1> <peakEl> <durSec> [holdSec] [LOOP]"),
+    CMD("TEST",  "PRESET",   cmdTestPreset, "TEST PRESET <1|2|3>"),
+    CMD("TEST",  "STOP",     cmdTestStop,   "TEST STOP / TEST STATUS"),
+    CMD("TEST",  "STATUS",   cmdTestStatus, nullptr),
 #endif
+    CMD("STATUS", "",        cmdStatus,     "STATUS"),
+  };
+  #undef CMD
+  static const int TABLE_N = sizeof(TABLE) / sizeof(TABLE[0]);
+
+  static void help() {
+    if (!io) return;
+    io->println(F("Commands:"));
+    for (int i = 0; i < TABLE_N; i++) if (TABLE[i].usage) { io->print(F("  ")); io->println(TABLE[i].usage); }
+    io->println(F("  (several commands per line/packet: separate with ';')"));
+  }
 
-    if (up=="STATUS") { if (statusPrinter) statusPrinter(*io); else io->println(F("STATUS printer not set")); return; }
+  static const Cmd* lookup(const Args& a) {
+    const uint32_t h0 = kw(a.v[0]), h1 = a.n > 1 ? kw(a.v[1]) : 0;
+    const Cmd* bare = nullptr;
+    for (int i = 0; i < TABLE_N; i++) {
+      const Cmd& c = TABLE[i];
+      if (c.h0 != h0 || strcasecmp(c.name, a.v[0]) != 0) continue;
+      if (!c.h1) { if (!bare) bare = &c; continue; }
+      if (h1 == c.h1 && strcasecmp(c.sub, a.v[1]) == 0) return &c;
+    }
+    return bare;
+  }
 
-    help();
+  // one command, tokenized in place
+  static void dispatch(char* cmd) {
+    Args a;
+    if (!tokenize(cmd, a)) return;
+    const Cmd* c = lookup(a);
+    if (c) c->fn(a);
+    else help();
+  }
+
+  // ';' or newline separated commands, split in place
+  static void runBatch(char* s) {
+    while (s) {
+      char* next = strpbrk(s, ";\r\n");
+      if (next) *next++ = '\0';
+      dispatch(s);
+      s = next;
+    }
   }
 
   // ---------- public API ----------
-  void begin(Stream& s) { io=&s; line.reserve(256); }
+  void begin(Stream& s) { io=&s; }
   void setRequestSatelliteCallback(bool (*cb)()) { reqSatCb=cb; }
   void setStatusPrinter(void (*cb)(Stream& s))   { statusPrinter=cb; }
   void setStartStopCallbacks(bool (*sCb)(), void (*pCb)()) { startCb=sCb; stopCb=pCb; }
@@ -193,9 +287,16 @@ namespace Commands {
   void setGotoCallbacks(void (*az)(float), void (*el)(float)) { gotoAzCb=az; gotoElCb=el; }
   void println(const String& s){ if(io) io->println(s); }
 
-  // Single, public injection function (UDP/web)
+  void inject(const char* text, size_t len) {
+    if (!io || !text) return;
+    if (len >= sizeof(batch)) { io->println(F("ERR command too long")); return; }
+    memcpy(batch, text, len);
+    batch[len] = '\0';
+    runBatch(batch);
+  }
+
   void CommandsInject(const String& cmdLine) {
-    handleImpl(cmdLine);
+    inject(cmdLine.c_str(), cmdLine.length());
   }
 
   void poll() {
@@ -203,8 +304,13 @@ namespace Commands {
     while (io->available()) {
       char c=(char)io->read();
       if (c=='\r') continue;
-      if (c=='\n') { handleImpl(line); line=""; }
-      else { line+=c; if (line.length()>512) line.remove(0,256); }
+      if (c=='\n') {
+        if (lineOverflow) io->println(F("ERR command too long"));
+        else { line[lineLen] = '\0'; runBatch(line); }
+        lineLen = 0; lineOverflow = false;
+      }
+      else if (lineLen < sizeof(line) - 1) line[lineLen++] = c;
+      else lineOverflow = true;
     }
   }
-} // namespace
\ No newline at end of file
+} // namespace
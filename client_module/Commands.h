@@ -19,6 +19,7 @@ namespace Commands {
   void setStepCallbacks(void (*stepAz)(int32_t), void (*stepEl)(int32_t));
   void setGotoCallbacks(void (*gotoAz)(float), void (*gotoEl)(float));
 
-  // single, public injection point for UDP/web/other inputs
+  // single, public injection point for UDP/web/other inputs; ';' separates batched commands
+  void inject(const char* text, size_t len);
   void CommandsInject(const String& line);
 }
\ No newline at end of file
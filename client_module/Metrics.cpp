@@ -0,0 +1,70 @@
+#include "Metrics.h"
+
+static inline int bucketOf(uint32_t v) {
+  if (v < 4) return (int)v;
+  int o = 31 - __builtin_clz(v);                 // octave, >= 2
+  if (o > 23) return METRIC_BUCKETS - 1;
+  return 4 + (o - 2) * 4 + (int)((v >> (o - 2)) & 3);
+}
+
+uint32_t metricBucketFloor(int i) {
+  if (i < 4) return (uint32_t)i;
+  int o = (i - 4) / 4 + 2;
+  return (uint32_t)(4 | ((i - 4) % 4)) << (o - 2);
+}
+
+void MetricHist::add(uint32_t v) {
+  bucket[bucketOf(v)]++;
+  count++;
+  sum += v;
+  if (v > max) max = v;
+}
+
+uint32_t MetricHist::percentile(float p) const {
+  if (count == 0) return 0;
+  uint32_t want = (uint32_t)ceilf(p * count);
+  if (want == 0) want = 1;
+  uint32_t seen = 0;
+  for (int i = 0; i < METRIC_BUCKETS - 1; i++) {
+    seen += bucket[i];
+    if (seen >= want) return min(metricBucketFloor(i + 1) - 1, max);
+  }
+  return max;
+}
+
+void MetricHist::reset() {
+  count = max = 0;
+  sum = 0;
+  memset(bucket, 0, sizeof(bucket));
+}
+
+static MetricHist sHist[MET_COUNT] = {
+  { "loop_us" }, { "wait_ms" }, { "findsat_us" }, { "lag_mdeg" }, { "audio_hz" }, { "dsp_us" },
+};
+
+void metricAdd(MetricId id, uint32_t v) { sHist[id].add(v); }
+const MetricHist& metricGet(MetricId id) { return sHist[id]; }
+
+size_t metricsFormatSummary(char* out, size_t n) {
+  size_t len = 0;
+  if (n) out[0] = '\0';
+  for (const MetricHist& h : sHist) {
+    if (h.count == 0) continue;
+    int w = snprintf(out + len, n - len, "%s%s=%lu/%lu/%lu/%lu/%lu", len ? " " : "", h.name,
+                     (unsigned long)h.count, (unsigned long)h.percentile(0.5f),
+                     (unsigned long)h.percentile(0.9f), (unsigned long)h.percentile(0.99f),
+                     (unsigned long)h.max);
+    if (w < 0 || len + w >= n) { out[len] = '\0'; break; }   // keep whole entries only
+    len += w;
+  }
+  return len;
+}
+
+void metricsPrintStatus(Stream& s) {
+  s.println(F("Metrics (count p50 p90 p99 max):"));
+  for (const MetricHist& h : sHist) {
+    s.printf("  %-11s %8lu %8lu %8lu %8lu %8lu\n", h.name, (unsigned long)h.count,
+             (unsigned long)h.percentile(0.5f), (unsigned long)h.percentile(0.9f),
+             (unsigned long)h.percentile(0.99f), (unsigned long)h.max);
+  }
+}
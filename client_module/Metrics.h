@@ -0,0 +1,46 @@
+#pragma once
+#include <Arduino.h>
+
+// Runtime metrics: fixed-bucket histograms (no allocation, constant-time add) fed from
+// cycle-counter timers in the hot paths. Buckets are log-linear, four per octave (about
+// ±12%), for values up to 2^24 in each metric's own unit. Every histogram has a single
+// writer task; a reader may catch a sample half-added, which is fine for monitoring.
+// Summaries ride on the registrar PING. The histogram part matches server_module/Metrics.h.
+
+#define METRIC_BUCKETS   (4 + 22 * 4)   // 0..3 exact, then 4 buckets per octave up to 2^24
+
+struct MetricHist {
+  const char* name;                     // "<what>_<unit>", e.g. "loop_us"
+  uint32_t count, max;
+  uint64_t sum;
+  uint32_t bucket[METRIC_BUCKETS];
+
+  void     add(uint32_t v);
+  uint32_t percentile(float p) const;   // upper edge of the bucket holding quantile p, capped at max
+  void     reset();
+};
+
+uint32_t metricBucketFloor(int i);      // smallest value counted in bucket i
+
+// Elapsed time from the CPU cycle counter (wraps after ~17 s at 240 MHz)
+struct CycleTimer {
+  uint32_t t0 = ESP.getCycleCount();
+  uint32_t us() const { return (ESP.getCycleCount() - t0) / ESP.getCpuFreqMHz(); }
+};
+
+enum MetricId {
+  MET_LOOP_US,      // loop() body, idle delays excluded
+  MET_WAIT_MS,      // ready in WAIT until an assignment starts
+  MET_FINDSAT_US,   // one Sgp4::findsat
+  MET_LAG_MDEG,     // steady-state pointing error while tracking (satellite vs. mount, on the sky)
+  MET_AUDIO_HZ,     // samples processed by the audio task, per second
+  MET_DSP_US,       // one audio block through DSP + synth
+  MET_COUNT
+};
+
+void metricAdd(MetricId id, uint32_t v);
+const MetricHist& metricGet(MetricId id);
+
+// "name=count/p50/p90/p99/max ..." (space separated, only metrics with samples)
+size_t metricsFormatSummary(char* out, size_t n);
+void   metricsPrintStatus(Stream& s);
@@ -1,25 +1,165 @@
 #include "Motors.h"
+#include "PosJournal.h"
+#include "Metrics.h"
 #include <SD.h>
 #include <math.h>
+#include "soc/gpio_struct.h"
 
 // ==== State ====
 static volatile bool sTrackingActive = false;
-
-static float sAzDeg = 0.0f;   // current mechanical estimate (can be outside 0..360 but bounded)
-static float sElDeg = 0.0f;
 static LaserMode sLaserMode = LASER_DEFAULT_MODE;
 
-// backtrack history for AZ: record signed step deltas
-#define AZ_HIST_MAX 600
-static int16_t azHist[AZ_HIST_MAX];
-static int azHistLen = 0;
+// Cable wrap: AZ position is kept as the net signed step count from the cable's null
+// (unbounded, persisted by the journal), so the twist is known in O(1) for any session
+// length: turns = sAz.pos / AZ_STEPS_PER_REV. Targets are kept inside +-AZ_WRAP_LIMIT_DEG.
+#define AZ_STEPS_PER_REV ((int32_t)roundf(360.0f * AZ_STEPS_PER_DEG))
 
-// EL driver half-step sequence
-static const uint8_t EL_SEQ[8][4] = {
+// EL driver half-step sequence (read from the step ISR, keep it in DRAM)
+static const DRAM_ATTR uint8_t EL_SEQ[8][4] = {
   {1,0,0,0},{1,1,0,0},{0,1,0,0},{0,1,1,0},
   {0,0,1,0},{0,0,1,1},{0,0,0,1},{1,0,0,1}
 };
-static int elPhase = 0;
+
+// ===== Step engine =====
+// A hardware timer fires STEP_TICK_HZ times per second. Each axis runs its own
+// trapezoidal profile toward 'target' in integer math (the ISR must not touch the FPU):
+//   vel   : steps per tick, unsigned Q32 (2^32 = one step every tick)
+//   accel : vel increment per tick, Q32
+//   phase : Q32 accumulator, a carry emits one step
+struct Axis {
+  volatile int32_t  pos;        // steps, unbounded
+  volatile int32_t  target;     // steps
+  volatile uint32_t vel;
+  volatile uint32_t vmax;       // current cruise limit (coordinated moves lower it)
+  uint32_t          vmaxFull;   // axis limit from config
+  uint32_t          accel;
+  uint32_t          phase;
+  int8_t            dir;        // +1/-1 while moving, 0 at rest
+};
+
+static Axis sAz, sEl;
+static int  sElPhase = 0;
+static bool sAzPulseHigh = false;
+static hw_timer_t* sStepTimer = nullptr;
+static portMUX_TYPE sStepMux = portMUX_INITIALIZER_UNLOCKED;
+
+// persistence bookkeeping (loop side)
+static uint32_t sLastJournalMs = 0;
+
+static inline void IRAM_ATTR fastWrite(uint8_t pin, bool high) {
+  if (pin < 32) {
+    if (high) GPIO.out_w1ts = (1UL << pin);
+    else      GPIO.out_w1tc = (1UL << pin);
+  } else {
+    if (high) GPIO.out1_w1ts.val = (1UL << (pin - 32));
+    else      GPIO.out1_w1tc.val = (1UL << (pin - 32));
+  }
+}
+
+static inline uint32_t q32PerTick(float stepsPerSec) {
+  double v = (double)stepsPerSec / (double)STEP_TICK_HZ * 4294967296.0;
+  if (v > 2147483648.0) v = 2147483648.0; // at most one step every other tick
+  return (uint32_t)v;
+}
+static inline uint32_t q32PerTick2(float stepsPerSec2) {
+  double a = (double)stepsPerSec2 / ((double)STEP_TICK_HZ * (double)STEP_TICK_HZ) * 4294967296.0;
+  return a < 1.0 ? 1u : (uint32_t)a;
+}
+
+// Advance one axis by one tick; returns the step direction taken (0 = no step)
+static inline int8_t IRAM_ATTR axisTick(Axis& a) {
+  int32_t togo = a.target - a.pos;
+
+  if (a.vel == 0) {
+    if (togo == 0) { a.dir = 0; a.phase = 0; return 0; }
+    a.dir = (togo > 0) ? 1 : -1;
+  }
+
+  uint32_t dist = (uint32_t)(togo >= 0 ? togo : -togo);
+  bool wrongWay = (togo > 0 && a.dir < 0) || (togo < 0 && a.dir > 0) || togo == 0;
+  // braking distance v^2/(2a) compared without a division
+  uint64_t vv = ((uint64_t)a.vel * a.vel) >> 32;
+  bool brake = wrongWay || vv >= 2ull * a.accel * dist || a.vel > a.vmax;
+
+  if (brake) a.vel = (a.vel > a.accel) ? a.vel - a.accel : 0;
+  else       a.vel = (a.vmax - a.vel > a.accel) ? a.vel + a.accel : a.vmax;
+
+  if (a.vel == 0) {
+    a.phase = 0;
+    if (togo == 0) a.dir = 0;
+    return 0;
+  }
+
+  uint32_t before = a.phase;
+  a.phase += a.vel;
+  if (a.phase >= before) return 0;   // no carry, no step
+
+  if (wrongWay && togo == 0) return 0; // never step past the target
+  a.pos += a.dir;
+  return a.dir;
+}
+
+static void IRAM_ATTR onStepTick() {
+  portENTER_CRITICAL_ISR(&sStepMux);
+
+  if (sAzPulseHigh) { fastWrite(AZ_STEP_PIN, false); sAzPulseHigh = false; }
+
+  int8_t azDir = sAz.dir;
+  int8_t s = axisTick(sAz);
+  if (s) {
+    if (azDir != s) fastWrite(AZ_DIR_PIN, s > 0); // first step of a move: DIR was set last tick at the latest
+    fastWrite(AZ_STEP_PIN, true);
+    sAzPulseHigh = true;
+  } else if (sAz.dir && sAz.dir != azDir) {
+    fastWrite(AZ_DIR_PIN, sAz.dir > 0);          // direction set ahead of the first pulse
+  }
+
+  s = axisTick(sEl);
+  if (s) {
+    sElPhase = (sElPhase + s) & 7;
+    fastWrite(EL_IN1, EL_SEQ[sElPhase][0]);
+    fastWrite(EL_IN2, EL_SEQ[sElPhase][1]);
+    fastWrite(EL_IN3, EL_SEQ[sElPhase][2]);
+    fastWrite(EL_IN4, EL_SEQ[sElPhase][3]);
+  }
+
+  portEXIT_CRITICAL_ISR(&sStepMux);
+}
+
+static void axisSetup(Axis& a, float maxDps, float accelDps2, float stepsPerDeg, unsigned minStepPeriodUs) {
+  float vmax = maxDps * stepsPerDeg;
+  float hwMax = 1000000.0f / (float)minStepPeriodUs;
+  if (vmax > hwMax) vmax = hwMax;
+  a.pos = a.target = 0;
+  a.vel = 0;
+  a.vmaxFull = a.vmax = q32PerTick(vmax);
+  a.accel = q32PerTick2(accelDps2 * stepsPerDeg);
+  a.phase = 0;
+  a.dir = 0;
+}
+
+static inline float   azDegNow() { return (float)sAz.pos / AZ_STEPS_PER_DEG; }
+static inline float   elDegNow() { return (float)sEl.pos / EL_STEPS_PER_DEG; }
+static inline float   azDegTarget() { return (float)sAz.target / AZ_STEPS_PER_DEG; }
+
+// Queue new targets; with 'coordinated' both axes are slowed so they arrive together
+static void setTargets(int32_t azTarget, int32_t elTarget, bool coordinated) {
+  uint32_t azV = sAz.vmaxFull, elV = sEl.vmaxFull;
+  if (coordinated) {
+    // cruise time per axis ~ distance / vmax; stretch the shorter one
+    float azD = fabsf((float)(azTarget - sAz.pos)), elD = fabsf((float)(elTarget - sEl.pos));
+    float azT = azD / (float)sAz.vmaxFull, elT = elD / (float)sEl.vmaxFull;
+    float t = max(azT, elT);
+    if (t > 0) {
+      if (azT < t) azV = max<uint32_t>((uint32_t)(azD / t), sAz.accel);
+      if (elT < t) elV = max<uint32_t>((uint32_t)(elD / t), sEl.accel);
+    }
+  }
+  portENTER_CRITICAL(&sStepMux);
+  sAz.target = azTarget; sAz.vmax = azV;
+  sEl.target = elTarget; sEl.vmax = elV;
+  portEXIT_CRITICAL(&sStepMux);
+}
 
 // Keep any angle in [0..360)
 static inline float norm360(float a){
@@ -36,21 +176,24 @@ static inline float unwrapNearest(float targetWrappedDeg, float refDeg){
   return tw + 360.0f * k;
 }
 
-// Keep sAzDeg bounded to [-AZ_STATE_LIMIT_DEG, +AZ_STATE_LIMIT_DEG]
-#ifndef AZ_STATE_LIMIT_DEG
-#define AZ_STATE_LIMIT_DEG 360.0f
-#endif
-
-static inline void clampAzState(){
-  while (sAzDeg >  AZ_STATE_LIMIT_DEG) sAzDeg -= 360.0f;
-  while (sAzDeg < -AZ_STATE_LIMIT_DEG) sAzDeg += 360.0f;
+// AZ target in steps for a wrapped azimuth: the equivalent angle nearest to 'refDeg'
+// that stays inside the wrap limits (the other way round if the nearest one would not)
+static int32_t azStepsWithinWrap(float targetWrappedDeg, float refDeg) {
+  float t = unwrapNearest(targetWrappedDeg, refDeg);
+  if (t >  AZ_WRAP_LIMIT_DEG) t -= 360.0f * ceilf((t - AZ_WRAP_LIMIT_DEG) / 360.0f);
+  if (t < -AZ_WRAP_LIMIT_DEG) t += 360.0f * ceilf((-AZ_WRAP_LIMIT_DEG - t) / 360.0f);
+  t = constrain(t, -AZ_WRAP_LIMIT_DEG, AZ_WRAP_LIMIT_DEG);   // only if the limit is below 180
+  return (int32_t)roundf(t * AZ_STEPS_PER_DEG);
 }
 
+static inline int32_t azWrapLimitSteps() { return (int32_t)(AZ_WRAP_LIMIT_DEG * AZ_STEPS_PER_DEG); }
+
 static inline void laserUpdateRuntime() {
   if (sLaserMode == LASER_OFF) { digitalWrite(LASER_PIN, LOW); return; }
   if (sLaserMode == LASER_ON)  { digitalWrite(LASER_PIN, HIGH); return; }
   // TRACK mode: only on when within EL limits and tracking active
-  if (sTrackingActive && sElDeg >= EL_MIN_DEG && sElDeg <= EL_MAX_DEG) digitalWrite(LASER_PIN, HIGH);
+  float el = elDegNow();
+  if (sTrackingActive && el >= EL_MIN_DEG && el <= EL_MAX_DEG) digitalWrite(LASER_PIN, HIGH);
   else digitalWrite(LASER_PIN, LOW);
 }
 
@@ -71,150 +214,238 @@ void motorsInit() {
   pinMode(LASER_PIN, OUTPUT);
   digitalWrite(LASER_PIN, LOW);
 
+  axisSetup(sAz, AZ_MAX_SPEED_DPS, AZ_ACCEL_DPS2, AZ_STEPS_PER_DEG, 2 * AZ_STEP_DELAY_US);
+  axisSetup(sEl, EL_MAX_SPEED_DPS, EL_ACCEL_DPS2, EL_STEPS_PER_DEG, EL_STEP_DELAY_US);
+
   motorsLoadPosition();
   laserUpdateRuntime();
+
+  sStepTimer = timerBegin(1000000);                      // 1 MHz timebase
+  timerAttachInterrupt(sStepTimer, &onStepTick);
+  timerAlarm(sStepTimer, 1000000 / STEP_TICK_HZ, true, 0);
 }
 
 void motorsSetTrackingActive(bool on){ sTrackingActive = on; laserUpdateRuntime(); }
-bool motorsIsMoving(){ return sTrackingActive; }
-
-// ===== Low-level steppers =====
-static void azStepSigned(int32_t steps, unsigned int usDelay) {
-  if (steps == 0) return;
-  digitalWrite(AZ_DIR_PIN, steps > 0 ? HIGH : LOW);
-  int32_t n = abs(steps);
-  for (int32_t i=0;i<n;i++) {
-    digitalWrite(AZ_STEP_PIN, HIGH); delayMicroseconds(usDelay);
-    digitalWrite(AZ_STEP_PIN, LOW);  delayMicroseconds(usDelay);
-  }
-  sAzDeg += (float)steps / AZ_STEPS_PER_DEG; // signed already
-  clampAzState();                             // keep state within [-AZ_STATE_LIMIT_DEG..+AZ_STATE_LIMIT_DEG]
-  if (azHistLen < AZ_HIST_MAX) azHist[azHistLen++] = (int16_t)steps;
-}
-
-static void elWritePhase(int ph) {
-  digitalWrite(EL_IN1, EL_SEQ[ph][0]);
-  digitalWrite(EL_IN2, EL_SEQ[ph][1]);
-  digitalWrite(EL_IN3, EL_SEQ[ph][2]);
-  digitalWrite(EL_IN4, EL_SEQ[ph][3]);
-}
-
-static void elStepSigned(int32_t steps, unsigned int usDelay) {
-  if (steps == 0) return;
-  int dir = (steps > 0) ? 1 : -1;
-  int32_t n = abs(steps);
-  for (int32_t i=0;i<n;i++) {
-    elPhase = (elPhase + dir) & 7;
-    elWritePhase(elPhase);
-    delayMicroseconds(usDelay);
+bool motorsIsTrackingActive(){ return sTrackingActive; }
+
+bool motorsIsMoving() {
+  return sAz.vel || sEl.vel || sAz.pos != sAz.target || sEl.pos != sEl.target;
+}
+
+bool motorsIsActive() { return sTrackingActive || motorsIsMoving(); }
+
+void motorsLoop() {
+  bool moving = motorsIsMoving();
+  if (moving) laserUpdateRuntime();
+
+  // journal the live position while moving, the final one at rest (unchanged = no-op)
+  if (!moving || millis() - sLastJournalMs >= JOURNAL_MOVING_MS) {
+    sLastJournalMs = millis();
+    motorsSavePosition();
   }
-  sElDeg += (float)steps / EL_STEPS_PER_DEG;
+  journalLoop(!moving);
 }
 
 // ===== Manual =====
-void motorsManualStepAZ(int32_t steps) { azStepSigned(steps, AZ_STEP_DELAY_US); motorsSavePosition(); }
+void motorsManualStepAZ(int32_t steps) {
+  int32_t next = sAz.target + steps;
+  if (abs(next) > azWrapLimitSteps() && abs(next) > abs(sAz.target)) return; // unwinding is always allowed
+  setTargets(sAz.target + steps, sEl.target, false);
+}
 void motorsManualStepEL(int32_t steps) {
-  float next = sElDeg + (float)steps / EL_STEPS_PER_DEG;
+  float next = (float)(sEl.target + steps) / EL_STEPS_PER_DEG;
   if (next < EL_MIN_DEG || next > EL_MAX_DEG) return;
-  elStepSigned(steps, EL_STEP_DELAY_US);
-  motorsSavePosition();
+  setTargets(sAz.target, sEl.target + steps, false);
 }
 
 // ===== Absolute moves =====
 void motorsGotoAzDeg(float azDeg) {
-  // unwrap the target to the nearest equivalent angle around current state
-  float target = unwrapNearest(azDeg, sAzDeg);
-  float d = target - sAzDeg;
-  int32_t steps = (int32_t)roundf(d * AZ_STEPS_PER_DEG);
-  azStepSigned(steps, AZ_STEP_DELAY_US);
-  motorsSavePosition();
+  // nearest equivalent angle around where AZ is heading, within the wrap limits
+  setTargets(azStepsWithinWrap(azDeg, azDegTarget()), sEl.target, false);
 }
 
 void motorsGotoElDeg(float elDeg) {
   if (elDeg < EL_MIN_DEG) elDeg = EL_MIN_DEG;
   if (elDeg > EL_MAX_DEG) elDeg = EL_MAX_DEG;
-  float d = elDeg - sElDeg;
-  int32_t steps = (int32_t)roundf(d * EL_STEPS_PER_DEG);
-  elStepSigned(steps, EL_STEP_DELAY_US);
-  motorsSavePosition();
+  setTargets(sAz.target, (int32_t)roundf(elDeg * EL_STEPS_PER_DEG), false);
 }
 
 // ===== Tracking =====
-void motorsTrackTo(float targetAzDeg, float targetElDeg) {
-  sTrackingActive = true;
-
-  // clamp EL
-  if (targetElDeg < EL_MIN_DEG) targetElDeg = EL_MIN_DEG;
-  if (targetElDeg > EL_MAX_DEG) targetElDeg = EL_MAX_DEG;
-
-  // compute deltas limited by speed
-  static unsigned long last = 0;
-  unsigned long now = millis();
-  float dt = (last==0)?0.02f:((now-last)/1000.0f);
-  if (dt < 0.01f) dt = 0.01f;
-  last = now;
+// Control law (TRACK_FEED_FORWARD): the target is predicted ahead by the measured
+// actuation latency (sampled -> step targets queued), then each axis runs at the target's
+// rate plus a proportional correction of the remaining error, bounded to
+// TRACK_CORR_MAX_DPS. The step engine gets that speed as its cruise limit and an integer
+// step target just far enough ahead to keep moving until the next update (and to stop
+// there if none comes), so it cruises with the satellite instead of braking to a stop at
+// every sample. Further off than TRACK_ACQUIRE_DEG (lock, wrap unwind) it slews to the
+// predicted point.
+static float    sLatencyUs = 0;        // EMA: target sampled -> targets queued
+static float    sIntervalUs = 0;       // EMA: between tracking updates
+static uint32_t sLastTrackUs = 0;
+static uint32_t sSettledSinceMs = 0;   // 0: not within TRACK_ACQUIRE_DEG
+static double   sErrSumSq = 0;         // steady-state pointing error of this pass
+static float    sErrMaxDeg = 0;
+static uint32_t sErrCount = 0;
+
+static inline float wrap180(float d) {
+  d = fmodf(d, 360.0f);
+  if (d > 180.0f) d -= 360.0f; else if (d < -180.0f) d += 360.0f;
+  return d;
+}
 
-  // AZ: unwrap target to the nearest turn around current state (prevents multi-rev chasing)
-  float targetAzUnwrapped = unwrapNearest(targetAzDeg, sAzDeg);
-  float dAz = targetAzUnwrapped - sAzDeg;
+#if TRACK_FEED_FORWARD
+// Step target and cruise limit for one axis 'errDeg' behind a target moving at 'rateDps'
+static void followAxis(const Axis& a, float stepsPerDeg, float accelDps2, float errDeg, float rateDps,
+                       float horizonS, int32_t& target, uint32_t& vmax) {
+  float u = rateDps + constrain(TRACK_KP_PER_S * errDeg, -TRACK_CORR_MAX_DPS, TRACK_CORR_MAX_DPS);
+  float ahead = fabsf(u) * horizonS + u * u / (2.0f * accelDps2);   // deg until the next update, plus braking
+  int32_t d = (int32_t)ceilf(ahead * stepsPerDeg);
+  target = a.pos + (u >= 0 ? d : -d);
+  vmax = min(max(q32PerTick(fabsf(u) * stepsPerDeg), a.accel), a.vmaxFull);
+}
+#endif
 
-  float maxAzMove = AZ_MAX_SPEED_DPS * dt;
-  if (dAz >  maxAzMove) dAz =  maxAzMove;
-  if (dAz < -maxAzMove) dAz = -maxAzMove;
+void motorsTrackReset() {
+  sLastTrackUs = 0;
+  sIntervalUs = 0;
+  sSettledSinceMs = 0;
+  sErrSumSq = 0; sErrMaxDeg = 0; sErrCount = 0;
+}
 
-  float dEl = targetElDeg - sElDeg;
-  float maxElMove = EL_MAX_SPEED_DPS * dt;
-  if (dEl >  maxElMove) dEl =  maxElMove;
-  if (dEl < -maxElMove) dEl = -maxElMove;
+void motorsTrackTo(float targetAzDeg, float targetElDeg, float azDps, float elDps, uint32_t sampledUs) {
+  sTrackingActive = true;
 
-  int32_t azSteps = (int32_t)roundf(dAz * AZ_STEPS_PER_DEG);
-  int32_t elSteps = (int32_t)roundf(dEl * EL_STEPS_PER_DEG);
+  uint32_t nowUs = micros();
+  if (sLastTrackUs && nowUs - sLastTrackUs < 1000000u) {
+    sIntervalUs += ((float)(nowUs - sLastTrackUs) - sIntervalUs) * 0.125f;
+  } else {
+    sIntervalUs = 0;          // first update, or tracking resumed after a gap
+    sSettledSinceMs = 0;
+  }
+  sLastTrackUs = nowUs;
+
+  // pointing error now: where the satellite is at this instant vs. where the axes are
+  float age = (float)(nowUs - sampledUs) * 1e-6f;
+  float azNow = targetAzDeg + azDps * age, elNow = targetElDeg + elDps * age;
+  float errAz = wrap180(azNow - azDegNow()), errEl = elNow - elDegNow();
+  float errDeg = hypotf(errAz * cosf(elNow * DEG_TO_RAD), errEl);
+  bool near = errDeg < TRACK_ACQUIRE_DEG;
+  if (!near) sSettledSinceMs = 0;
+  else if (!sSettledSinceMs) sSettledSinceMs = millis() | 1;
+  if (near && millis() - sSettledSinceMs >= TRACK_SETTLE_MS) {
+    sErrSumSq += (double)errDeg * errDeg;
+    sErrMaxDeg = fmaxf(sErrMaxDeg, errDeg);
+    sErrCount++;
+    metricAdd(MET_LAG_MDEG, (uint32_t)(errDeg * 1000.0f));
+  }
 
-  if (azSteps) azStepSigned(azSteps, AZ_STEP_DELAY_US);
-  if (elSteps) elStepSigned(elSteps, EL_STEP_DELAY_US);
+#if TRACK_FEED_FORWARD
+  // predicted to when the step engine acts on this update
+  float lead = (sLatencyUs + 500000.0f / STEP_TICK_HZ) * 1e-6f;
+  float azPred = targetAzDeg + azDps * lead, elPred = targetElDeg + elDps * lead;
+#else
+  float azPred = targetAzDeg, elPred = targetElDeg;
+#endif
+  if (elPred < EL_MIN_DEG) { elPred = EL_MIN_DEG; elDps = fmaxf(elDps, 0.0f); }
+  if (elPred > EL_MAX_DEG) { elPred = EL_MAX_DEG; elDps = fminf(elDps, 0.0f); }
+
+  // AZ: nearest turn around the current position (prevents multi-rev chasing); at a wrap
+  // limit this unwinds through the other side instead of twisting the cable further
+  int32_t azT = azStepsWithinWrap(azPred, azDegNow());
+  int32_t elT = (int32_t)roundf(elPred * EL_STEPS_PER_DEG);
+
+#if TRACK_FEED_FORWARD
+  float eAz = (float)(azT - sAz.pos) / AZ_STEPS_PER_DEG, eEl = (float)(elT - sEl.pos) / EL_STEPS_PER_DEG;
+  if (fabsf(eAz) < TRACK_ACQUIRE_DEG && fabsf(eEl) < TRACK_ACQUIRE_DEG) {
+    float horizonS = constrain(2.0f * sIntervalUs * 1e-6f, 0.02f, TRACK_HORIZON_MAX_MS * 1e-3f);
+    int32_t azF, elF;
+    uint32_t azV, elV;
+    followAxis(sAz, AZ_STEPS_PER_DEG, AZ_ACCEL_DPS2, eAz, azDps, horizonS, azF, azV);
+    followAxis(sEl, EL_STEPS_PER_DEG, EL_ACCEL_DPS2, eEl, elDps, horizonS, elF, elV);
+    azF = constrain(azF, -azWrapLimitSteps(), azWrapLimitSteps());
+    elF = constrain(elF, (int32_t)roundf(EL_MIN_DEG * EL_STEPS_PER_DEG), (int32_t)roundf(EL_MAX_DEG * EL_STEPS_PER_DEG));
+    portENTER_CRITICAL(&sStepMux);
+    sAz.target = azF; sAz.vmax = azV;
+    sEl.target = elF; sEl.vmax = elV;
+    portEXIT_CRITICAL(&sStepMux);
+  } else {
+    setTargets(azT, elT, false);
+  }
+#else
+  setTargets(azT, elT, false);
+#endif
+  sLatencyUs += ((float)(micros() - sampledUs) - sLatencyUs) * 0.125f;
 
   laserUpdateRuntime();
 }
 
-void motorsReturnToNull() {
-  // EL first to horizon (down/up to 0)
-  motorsGotoElDeg(0.0f);
+void motorsPrintTrackStatus(Stream& s) {
+  s.printf("Tracking: %s, latency %.2f ms, update %.1f ms; steady-state error rms %.3f° max %.3f° (%lu samples)\n",
+           TRACK_FEED_FORWARD ? "feed-forward" : "step-to-sample",
+           sLatencyUs * 1e-3f, sIntervalUs * 1e-3f,
+           sErrCount ? sqrt(sErrSumSq / sErrCount) : 0.0, sErrMaxDeg, (unsigned long)sErrCount);
+}
 
-  // AZ backtrack reverse history
-  for (int i = azHistLen - 1; i >= 0; --i) {
-    int16_t st = azHist[i];
-    if (st) azStepSigned(-st, AZ_STEP_DELAY_US);
+// Pre-position for a pass: AZ to the equivalent of 'azDeg' nearest where AZ is heading
+// among those from which the pass's AZ turn [turnMinDeg, turnMaxDeg] stays inside the
+// wrap limits; EL to the rise elevation; both arrive together. False if no start fits.
+bool motorsPrePosition(float azDeg, float elDeg, float turnMinDeg, float turnMaxDeg) {
+  float ref = azDegTarget(), base = unwrapNearest(azDeg, ref);
+  float best = 0; bool found = false;
+  for (int k = -2; k <= 2; k++) {
+    float t = base + 360.0f * k;
+    if (t + turnMinDeg < -AZ_WRAP_LIMIT_DEG || t + turnMaxDeg > AZ_WRAP_LIMIT_DEG) continue;
+    if (!found || fabsf(t - ref) < fabsf(best - ref)) { best = t; found = true; }
   }
-  azHistLen = 0;
+  if (!found) return false;
 
-  // normalize state
-  sAzDeg = 0.0f; sElDeg = 0.0f;
-  motorsSavePosition();
+  if (elDeg < EL_MIN_DEG) elDeg = EL_MIN_DEG;
+  if (elDeg > EL_MAX_DEG) elDeg = EL_MAX_DEG;
+  setTargets((int32_t)roundf(best * AZ_STEPS_PER_DEG), (int32_t)roundf(elDeg * EL_STEPS_PER_DEG), true);
+  laserUpdateRuntime();
+  return true;
+}
+
+// Cable-safe return to null: one profiled move that unwinds the net AZ twist, EL to the
+// horizon, both arriving together. Returns immediately.
+void motorsReturnToNull() {
+  setTargets(0, 0, true);
   laserUpdateRuntime();
 }
 
+float motorsAzWrapTurns() { return (float)sAz.pos / (float)AZ_STEPS_PER_REV; }
+
 void motorsZeroHere() {
-  sAzDeg = 0.0f; sElDeg = 0.0f;
-  azHistLen = 0;
+  portENTER_CRITICAL(&sStepMux);
+  sAz.pos = sAz.target = 0; sAz.vel = 0;
+  sEl.pos = sEl.target = 0; sEl.vel = 0;
+  portEXIT_CRITICAL(&sStepMux);
   motorsSavePosition();
 }
 
+// Cheap (RTC memory); PosJournal batches the NVS writes
 void motorsSavePosition() {
-  clampAzState(); // keep stored value tidy/bounded
-  File f = SD.open("/pos.dat", FILE_WRITE);
-  if (!f) return;
-  f.printf("%.4f,%.4f\n", sAzDeg, sElDeg);
-  f.close();
+  journalAppend(sAz.pos, sEl.pos);
 }
 
 void motorsLoadPosition() {
-  File f = SD.open("/pos.dat", FILE_READ);
-  if (!f) { sAzDeg=0; sElDeg=0; return; }
-  String line = f.readStringUntil('\n');
-  f.close();
-  float az=0,el=0;
-  if (sscanf(line.c_str(), "%f,%f", &az, &el)==2) {
-    sAzDeg=az; sElDeg=el;
-    clampAzState();
-  } else { sAzDeg=0; sElDeg=0; }
+  int32_t azSteps = 0, elSteps = 0;
+  if (!journalBegin(azSteps, elSteps)) {
+    // first boot after the journal was introduced: take over the old /pos.dat once
+    float az=0,el=0;
+    File f = SD.open("/pos.dat", FILE_READ);
+    if (f) {
+      String line = f.readStringUntil('\n');
+      f.close();
+      if (sscanf(line.c_str(), "%f,%f", &az, &el)!=2) { az=0; el=0; }
+    }
+    azSteps = (int32_t)roundf(az * AZ_STEPS_PER_DEG);
+    elSteps = (int32_t)roundf(el * EL_STEPS_PER_DEG);
+  }
+  // the journal keeps the full twist; anything beyond the limits is left to HOME to unwind
+  portENTER_CRITICAL(&sStepMux);
+  sAz.pos = sAz.target = azSteps;
+  sEl.pos = sEl.target = elSteps;
+  portEXIT_CRITICAL(&sStepMux);
+  journalAppend(azSteps, elSteps);
 }
@@ -3,8 +3,11 @@
 #include "config.h"
 
 void motorsInit();
+void motorsLoop();                 // call from loop(): homing completion, position journal
 void motorsSetTrackingActive(bool on);
-bool motorsIsMoving();
+bool motorsIsTrackingActive();
+bool motorsIsMoving();             // true while either axis is stepping or has distance to go
+bool motorsIsActive();             // tracking or moving
 
 void motorsManualStepAZ(int32_t steps);
 void motorsManualStepEL(int32_t steps);
@@ -12,15 +15,26 @@ void motorsManualStepEL(int32_t steps);
 void motorsGotoAzDeg(float azDeg);
 void motorsGotoElDeg(float elDeg);
 
-// tracking move (rate-limited & smoothed)
-void motorsTrackTo(float targetAzDeg, float targetElDeg);
+// All moves are queued to the timer-driven step engine and return immediately.
 
-// cable-safe return to null following backtrack
+// tracking update: the target's position and rates (deg/s) as sampled at micros() ==
+// sampledUs. Predicts ahead by the measured actuation latency and runs feed-forward plus a
+// bounded correction (TRACK_* in config.h); speed/acceleration limited by the step engine
+void motorsTrackTo(float targetAzDeg, float targetElDeg, float azDps, float elDps, uint32_t sampledUs);
+void motorsTrackReset();                    // new pass: restart the error statistics
+void motorsPrintTrackStatus(Stream& s);     // control law, latency, steady-state pointing error
+
+// slew to where a pass rises, on the side of the cable wrap that leaves room for the pass's
+// AZ turn (degrees relative to the rise azimuth); false if no start fits (home instead)
+bool motorsPrePosition(float azDeg, float elDeg, float turnMinDeg, float turnMaxDeg);
+
+// cable-safe return to null: one move that unwinds the net AZ twist (AZ and EL move together)
 void motorsReturnToNull();
 void motorsZeroHere();
+float motorsAzWrapTurns();         // net AZ turns from the cable's null (signed)
 
-void motorsSavePosition();
-void motorsLoadPosition();
+void motorsSavePosition();         // journal the current position (RTC memory, see PosJournal.h)
+void motorsLoadPosition();         // newest journal record (or a legacy /pos.dat)
 
 void motorsSetLaserMode(LaserMode m);
 LaserMode motorsGetLaserMode();
\ No newline at end of file
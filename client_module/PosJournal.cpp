@@ -0,0 +1,99 @@
+#include "PosJournal.h"
+#include "config.h"
+#include <Preferences.h>
+#include "esp_rom_crc.h"
+#include "esp_system.h"
+
+// RTC slow memory is not cleared by software/watchdog/panic/brownout resets, only by a
+// power cycle: then every slot fails its CRC and the NVS checkpoint takes over.
+static RTC_NOINIT_ATTR PosRecord sRing[JOURNAL_RTC_SLOTS];
+
+static Preferences sNvs;
+static bool        sNvsOk = false;
+static PosRecord   sNewest = {};          // last appended (RAM copy)
+static int         sNext = 0;             // ring slot for the next append
+static uint32_t    sFlushedSeq = 0;       // newest record in NVS
+static uint32_t    sLastAppendMs = 0;
+static uint32_t    sLastFlushMs = 0;
+static uint32_t    sAppends = 0, sFlushes = 0;
+
+static uint32_t recordCrc(const PosRecord& r) {
+  return esp_rom_crc32_le(0, (const uint8_t*)&r, offsetof(PosRecord, crc));
+}
+
+static bool recordValid(const PosRecord& r) {
+  return r.seq != 0 && r.crc == recordCrc(r);
+}
+
+void journalFlush() {
+  if (!sNvsOk || sNewest.seq == sFlushedSeq) return;
+  if (sNvs.putBytes("pos", &sNewest, sizeof(sNewest)) == sizeof(sNewest)) {
+    sFlushedSeq = sNewest.seq;
+    sFlushes++;
+  }
+  sLastFlushMs = millis();
+}
+
+static void onShutdown() { journalFlush(); }
+
+bool journalBegin(int32_t& azSteps, int32_t& elSteps) {
+  sNvsOk = sNvs.begin("posjournal", false);
+  esp_register_shutdown_handler(&onShutdown);
+
+  // newest valid record from the RTC ring, then from the NVS checkpoint
+  const char* from = nullptr;
+  int newestSlot = -1;
+  for (int i = 0; i < JOURNAL_RTC_SLOTS; i++) {
+    if (recordValid(sRing[i]) && (!from || sRing[i].seq > sNewest.seq)) {
+      sNewest = sRing[i];
+      newestSlot = i;
+      from = "RTC";
+    }
+  }
+  PosRecord nv = {};
+  if (sNvsOk && sNvs.getBytes("pos", &nv, sizeof(nv)) == sizeof(nv) && recordValid(nv)) {
+    sFlushedSeq = nv.seq;
+    if (!from || nv.seq > sNewest.seq) { sNewest = nv; from = "NVS"; }
+  }
+  sNext = (newestSlot + 1) % JOURNAL_RTC_SLOTS;
+  sLastFlushMs = millis();
+
+  if (!from) {
+    Serial.println(F("📍 Position journal empty"));
+    return false;
+  }
+  Serial.printf("📍 Position from %s journal #%lu (AZ %ld, EL %ld steps)\n",
+                from, (unsigned long)sNewest.seq, (long)sNewest.azSteps, (long)sNewest.elSteps);
+  azSteps = sNewest.azSteps;
+  elSteps = sNewest.elSteps;
+  return true;
+}
+
+void journalAppend(int32_t azSteps, int32_t elSteps) {
+  if (sNewest.seq && sNewest.azSteps == azSteps && sNewest.elSteps == elSteps) return;
+  PosRecord r;
+  r.seq = sNewest.seq + 1;
+  r.azSteps = azSteps;
+  r.elSteps = elSteps;
+  r.crc = recordCrc(r);
+  sRing[sNext] = r;
+  sNext = (sNext + 1) % JOURNAL_RTC_SLOTS;
+  sNewest = r;
+  sLastAppendMs = millis();
+  sAppends++;
+}
+
+void journalLoop(bool atRest) {
+  if (sNewest.seq == sFlushedSeq) return;
+  uint32_t now = millis();
+  // at rest: once the position has settled; moving/tracking: bounded loss on power cut
+  if ((atRest && now - sLastAppendMs >= JOURNAL_IDLE_FLUSH_MS) || now - sLastFlushMs >= JOURNAL_MAX_FLUSH_MS) {
+    journalFlush();
+  }
+}
+
+void journalPrintStatus(Stream& s) {
+  s.printf("Journal: #%lu (NVS #%lu%s) appends=%lu nvs_writes=%lu\n",
+           (unsigned long)sNewest.seq, (unsigned long)sFlushedSeq, sNvsOk ? "" : ", NVS unavailable",
+           (unsigned long)sAppends, (unsigned long)sFlushes);
+}
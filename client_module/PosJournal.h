@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+
+// Position journal: AZ/EL step counts as sequence-numbered, CRC-checked records.
+// Appends go to a ring in RTC slow memory (survives resets, costs microseconds);
+// the newest record is checkpointed to NVS in batches, when the rig is at rest
+// or at the latest every JOURNAL_MAX_FLUSH_MS, and on esp_restart().
+
+struct PosRecord {
+  uint32_t seq;       // 0 = empty
+  int32_t  azSteps;   // unbounded (keeps the cable wrap)
+  int32_t  elSteps;
+  uint32_t crc;       // esp_rom_crc32_le over the fields above
+};
+
+bool journalBegin(int32_t& azSteps, int32_t& elSteps);  // newest valid record; false if none
+void journalAppend(int32_t azSteps, int32_t elSteps);   // no-op if unchanged
+void journalLoop(bool atRest);                          // batched NVS checkpoint
+void journalFlush();                                    // checkpoint now
+void journalPrintStatus(Stream& s);
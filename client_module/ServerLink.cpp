@@ -0,0 +1,147 @@
+#include "ServerLink.h"
+#include "config.h"
+#include "TimeSync.h"
+#include <WiFi.h>
+#include <WiFiClient.h>
+
+static WiFiClient sSock;
+static char       sName[24];
+static bool       sUp = false;
+static bool       sUseGateway = false;   // alternate MASTER_IP / gateway between attempts
+static uint32_t   sLastAttemptMs = 0, sLastRxMs = 0, sLastTxMs = 0;
+static uint8_t    sRx[sizeof(NetFrameHeader) + NET_LINK_MAX_PAYLOAD];
+static uint16_t   sRxLen = 0;
+
+static NetAssign  sQueue[LINK_QUEUE_DEPTH];
+static int        sQueued = 0;
+
+static bool sendFrame(uint8_t type, const void* payload, uint16_t len) {
+  if (!sUp) return false;
+  uint8_t buf[sizeof(NetFrameHeader) + NET_LINK_MAX_PAYLOAD];
+  NetFrameHeader h = { len, type, NET_LINK_VERSION };
+  memcpy(buf, &h, sizeof(h));
+  if (len) memcpy(buf + sizeof(h), payload, len);
+  size_t n = sizeof(h) + len;
+  if (sSock.write(buf, n) != n) return false;
+  sLastTxMs = millis();
+  return true;
+}
+
+static void drop(const char* why) {
+  if (sUp) Serial.printf("🔌 Link down: %s\n", why);
+  sSock.stop();
+  sUp = false;
+  sRxLen = 0;
+  sQueued = 0;   // the server forgets our queue on reconnect as well
+}
+
+static void sendAck(uint32_t id, NetAckStatus st) {
+  NetAck a = {}; a.id = id; a.status = st;
+  sendFrame(NET_MSG_ACK, &a, sizeof(a));
+}
+
+static void onFrame(const NetFrameHeader& h, const uint8_t* p) {
+  if (h.type != NET_MSG_ASSIGN) return;   // heartbeat
+  if (h.len < sizeof(NetAssign)) return;
+  NetAssign a; memcpy(&a, p, sizeof(a));
+  a.name[sizeof(a.name)-1] = 0; a.line1[sizeof(a.line1)-1] = 0; a.line2[sizeof(a.line2)-1] = 0;
+  if (sQueued >= LINK_QUEUE_DEPTH) { sendAck(a.id, NET_ACK_FULL); return; }
+  sQueue[sQueued++] = a;
+  sendAck(a.id, NET_ACK_QUEUED);
+#if DEBUG
+  Serial.printf("[LINK] #%lu %s queued (%d/%d)\n", (unsigned long)a.id, a.name, sQueued, LINK_QUEUE_DEPTH);
+#endif
+}
+
+static void readFrames() {
+  for (;;) {
+    size_t need = sizeof(NetFrameHeader);
+    NetFrameHeader h;
+    if (sRxLen >= need) {
+      memcpy(&h, sRx, sizeof(h));
+      if (h.len > NET_LINK_MAX_PAYLOAD) { drop("oversized frame"); return; }
+      need += h.len;
+      if (sRxLen == need) {
+        onFrame(h, sRx + sizeof(h));
+        sRxLen = 0;
+        continue;
+      }
+    }
+    if (sSock.available() <= 0) return;
+    int n = sSock.read(sRx + sRxLen, need - sRxLen);
+    if (n <= 0) return;
+    sRxLen += n;
+    sLastRxMs = millis();
+  }
+}
+
+static void tryConnect() {
+  IPAddress ip; ip.fromString(MASTER_IP);
+  if (sUseGateway) {
+    IPAddress gw = WiFi.gatewayIP();
+    if (gw && gw != ip) ip = gw;
+  }
+  sUseGateway = !sUseGateway;
+
+  if (!sSock.connect(ip, NET_LINK_PORT, LINK_CONNECT_TIMEOUT_MS)) {
+#if DEBUG
+    Serial.printf("[LINK] connect %s:%d failed\n", ip.toString().c_str(), NET_LINK_PORT);
+#endif
+    return;
+  }
+  sSock.setNoDelay(true);
+  sUp = true;
+  sRxLen = 0;
+  sQueued = 0;
+  sLastRxMs = sLastTxMs = millis();
+
+  NetHello m = {};
+  strlcpy(m.name, sName, sizeof(m.name));
+  m.queueDepth = LINK_QUEUE_DEPTH;
+  sendFrame(NET_MSG_HELLO, &m, sizeof(m));
+  Serial.printf("🔗 Link up to %s:%d\n", ip.toString().c_str(), NET_LINK_PORT);
+}
+
+void linkBegin(const char* moduleName) {
+  strlcpy(sName, moduleName, sizeof(sName));
+}
+
+void linkLoop(bool mayConnect) {
+  if (sUp && !sSock.connected()) drop("closed by server");
+  if (!sUp) {
+    if (!mayConnect || WiFi.status() != WL_CONNECTED) return;
+    if (millis() - sLastAttemptMs < LINK_RECONNECT_MS) return;
+    sLastAttemptMs = millis();
+    tryConnect();
+    return;
+  }
+  readFrames();
+  if (!sUp) return;
+  if (millis() - sLastRxMs > LINK_TIMEOUT_MS) { drop("server silent"); return; }
+  if (millis() - sLastTxMs > LINK_HEARTBEAT_MS) {
+    if (!sendFrame(NET_MSG_HEARTBEAT, nullptr, 0)) drop("write failed");
+  }
+}
+
+bool linkConnected() { return sUp; }
+int  linkQueued()    { return sQueued; }
+
+void linkDone(uint32_t id, NetDoneReason reason) {
+  NetDone d = {}; d.id = id; d.reason = reason;
+  sendFrame(NET_MSG_DONE, &d, sizeof(d));
+}
+
+bool linkTakeAssignment(NetAssign& out) {
+  while (sQueued > 0) {
+    out = sQueue[0];
+    for (int i = 0; i < sQueued - 1; i++) sQueue[i] = sQueue[i+1];
+    sQueued--;
+    // a queued pass that ended while we were busy with the previous one
+    if (out.losUnix && timeSyncIsSynced() && timeSyncNowUnix() > (double)out.losUnix) {
+      linkDone(out.id, NET_DONE_EXPIRED);
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+#include "NetProto.h"
+
+// Persistent connection to the server's module link (NET_LINK_PORT).
+// The server pushes assignments into a small local queue; nothing is polled.
+
+void linkBegin(const char* moduleName);
+// connect/reconnect, read pushes, heartbeat. A connect attempt blocks for up to
+// LINK_CONNECT_TIMEOUT_MS: mayConnect = false skips it (while a pass is being tracked).
+void linkLoop(bool mayConnect = true);
+bool linkConnected();
+bool linkTakeAssignment(NetAssign& out);       // pops the next usable one (expired ones are reported)
+void linkDone(uint32_t id, NetDoneReason reason);
+int  linkQueued();
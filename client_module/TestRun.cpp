@@ -38,24 +38,25 @@ namespace TestRun {
     startAt(nowSec);
   }
 
-  bool getAzEl(time_t utcNow, float& azOut, float& elOut){
+  bool getAzEl(double utcNow, float& azOut, float& elOut, float& azDpsOut, float& elDpsOut){
     if (!gEnabled) return false;
-    if (!gStarted) startAt(utcNow);
+    if (!gStarted) startAt((time_t)utcNow);
 
-    long dt = (long)utcNow - (long)gStartUnix;
+    double dt = utcNow - (double)gStartUnix;
     if (dt < 0) dt = 0;
 
-    if ((uint32_t)dt > (gDurSec + gHoldSec)) {
+    if (dt > (double)(gDurSec + gHoldSec)) {
       if (gLoop) {
-        gStartUnix = utcNow;
-        dt = 0;
+        gStartUnix = (time_t)utcNow;
+        dt = utcNow - (double)gStartUnix;
       } else {
         elOut = -5.0f; azOut = gAzEnd;
+        azDpsOut = elDpsOut = 0.0f;
         return false;
       }
     }
 
-    float t = constrain((float)dt / (float)gDurSec, 0.0f, 1.0f);
+    float t = constrain((float)(dt / gDurSec), 0.0f, 1.0f);
 
     float a0 = gAzStart;
     float d  = gAzEnd - gAzStart;
@@ -64,10 +65,12 @@ namespace TestRun {
     float az = norm360(a0 + d * t);
 
     float el = gPeakEl * (1.0f - cosf(2.0f * PI * t)) * 0.5f;
-    if ((uint32_t)dt > gDurSec) { az = gAzEnd; el = 0.0f; }
+    azDpsOut = d / (float)gDurSec;
+    elDpsOut = gPeakEl * PI * sinf(2.0f * PI * t) / (float)gDurSec;
+    if (dt > gDurSec) { az = gAzEnd; el = 0.0f; azDpsOut = elDpsOut = 0.0f; }
 
     azOut = az; elOut = el;
-    return el >= 0.0f || (uint32_t)dt <= (gDurSec + gHoldSec);
+    return el >= 0.0f || dt <= (double)(gDurSec + gHoldSec);
   }
 
   void printStatus(Stream& s){
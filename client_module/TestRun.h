@@ -8,6 +8,7 @@ namespace TestRun {
   void configure(float azStart, float azEnd, float peakElDeg, uint32_t durSec, uint32_t holdSec = 0, bool loop=false);
   void startAt(time_t unixStart);
   void startNow();
-  bool getAzEl(time_t utcNow, float& azOut, float& elOut);
+  // fractional seconds; rates (deg/s) are exact for the synthetic pass
+  bool getAzEl(double utcNow, float& azOut, float& elOut, float& azDpsOut, float& elDpsOut);
   void printStatus(Stream& s);
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "TimeSync.h"
+#include "NetProto.h"
+#include "config.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <time.h>
+#include "esp_timer.h"
+
+static WiFiUDP sUdp;
+
+// clock model: unix(L) = anchorUnix + dL + dL*freq + (slew applied so far), dL = L - anchorLocal
+static bool    sSynced = false;
+static int64_t sAnchorLocalUs = 0;
+static int64_t sAnchorUnixUs = 0;
+static double  sFreq = 0.0;          // fractional frequency correction
+static int64_t sSlewUs = 0;          // phase correction still to be applied
+
+// request in flight
+static bool     sPending = false;
+static uint16_t sSeq = 0;
+static uint32_t sSentMs = 0;
+
+// sample window: offset against the raw local timer, so clock corrections don't invalidate it
+struct Sample { int64_t rawOffsetUs, delayUs, localUs; };
+static Sample  sSamples[TIME_SYNC_FILTER_N];
+static int     sSampleCount = 0, sSampleNext = 0;
+static int64_t sLastUsedLocalUs = -1;
+static int64_t sLastApplyLocalUs = 0;
+
+// stats
+static int64_t  sLastOffsetUs = 0, sLastDelayUs = 0;
+static uint32_t sReplies = 0, sSteps = 0, sLastReplyMs = 0;
+
+static int64_t clockAt(int64_t localUs) {
+  int64_t dl = localUs - sAnchorLocalUs;
+  int64_t t = sAnchorUnixUs + dl + (int64_t)((double)dl * sFreq);
+  int64_t maxSlew = dl / TIME_SYNC_SLEW_DIV;
+  int64_t s = sSlewUs;
+  if (s > maxSlew) s = maxSlew;
+  if (s < -maxSlew) s = -maxSlew;
+  return t + s;
+}
+
+// move the anchor to 'localUs' without changing the clock's value there
+static void reanchor(int64_t localUs) {
+  int64_t dl = localUs - sAnchorLocalUs;
+  int64_t maxSlew = dl / TIME_SYNC_SLEW_DIV;
+  int64_t s = sSlewUs;
+  if (s > maxSlew) s = maxSlew;
+  if (s < -maxSlew) s = -maxSlew;
+  sAnchorUnixUs = sAnchorUnixUs + dl + (int64_t)((double)dl * sFreq) + s;
+  sSlewUs -= s;
+  sAnchorLocalUs = localUs;
+}
+
+bool    timeSyncIsSynced() { return sSynced; }
+int64_t timeSyncNowUs()    { return clockAt(esp_timer_get_time()); }
+double  timeSyncNowUnix()  { return (double)timeSyncNowUs() * 1e-6; }
+
+static void stepTo(int64_t unixUs, int64_t localUs) {
+  sAnchorLocalUs = localUs;
+  sAnchorUnixUs = unixUs;
+  sSlewUs = 0;
+  sLastApplyLocalUs = localUs;
+  if (sSynced) sSteps++;
+  sSynced = true;
+}
+
+void timeSyncSeedUnix(uint32_t unix) {
+  if (sSynced || unix == 0) return;
+  stepTo((int64_t)unix * 1000000LL + 500000LL, esp_timer_get_time()); // mid-second guess
+}
+
+// Steer the clock with the best sample in the window (each sample is used at most once)
+static void discipline() {
+  int best = -1;
+  for (int i = 0; i < sSampleCount; i++) {
+    if (best < 0 || sSamples[i].delayUs < sSamples[best].delayUs) best = i;
+  }
+  if (best < 0 || sSamples[best].localUs <= sLastUsedLocalUs) return;
+  const Sample& b = sSamples[best];
+  sLastUsedLocalUs = b.localUs;
+
+  int64_t now = esp_timer_get_time();
+  int64_t err = (now + b.rawOffsetUs) - clockAt(now);   // server minus us
+  sLastOffsetUs = err;
+
+  if (!sSynced || err > TIME_SYNC_STEP_US || err < -TIME_SYNC_STEP_US) {
+    stepTo(now + b.rawOffsetUs, now);
+    return;
+  }
+
+  reanchor(now);
+  // error beyond the slew we already knew about built up over the interval -> frequency.
+  // Short intervals are dominated by delay jitter, so only trim over long baselines.
+  int64_t interval = now - sLastApplyLocalUs;
+  if (interval >= TIME_SYNC_FREQ_BASE_S * 1000000LL) {
+    sFreq += 0.5 * (double)(err - sSlewUs) / (double)interval;
+    const double lim = TIME_SYNC_MAX_PPM * 1e-6;
+    if (sFreq > lim) sFreq = lim;
+    if (sFreq < -lim) sFreq = -lim;
+    sLastApplyLocalUs = now;
+  }
+  sSlewUs = err / 2;   // phase: correct half per sample to average out jitter
+}
+
+static void onReply(const NetTimePacket& p, int64_t localRx) {
+  if (!sPending || p.seq != sSeq) return;   // stale or duplicate
+  sPending = false;
+
+  int64_t t4 = clockAt(localRx);
+  int64_t delay = (t4 - p.t1Us) - (p.t3Us - p.t2Us);
+  int64_t offset = ((p.t2Us - p.t1Us) + (p.t3Us - t4)) / 2;
+  sLastDelayUs = delay;
+  sReplies++;
+  sLastReplyMs = millis();
+  if (delay < 0 || delay > TIME_SYNC_MAX_DELAY_US) return;
+
+  Sample& s = sSamples[sSampleNext];
+  s.localUs = localRx;
+  s.delayUs = delay;
+  s.rawOffsetUs = (t4 + offset) - localRx;   // server time minus raw local timer
+  sSampleNext = (sSampleNext + 1) % TIME_SYNC_FILTER_N;
+  if (sSampleCount < TIME_SYNC_FILTER_N) sSampleCount++;
+
+  discipline();
+}
+
+static void sendRequest() {
+  NetTimePacket p = {};
+  p.magic = NET_TIME_MAGIC;
+  p.type = NET_TIME_REQUEST;
+  p.version = NET_TIME_VERSION;
+  p.seq = ++sSeq;
+
+  IPAddress server; server.fromString(MASTER_IP);
+  sUdp.beginPacket(server, UDP_PORT);
+  p.t1Us = clockAt(esp_timer_get_time());
+  sUdp.write((const uint8_t*)&p, sizeof(p));
+  sUdp.endPacket();
+  sPending = true;
+  sSentMs = millis();
+}
+
+void timeSyncBegin() {
+  sUdp.begin(UDP_PORT);   // replies and server beacons
+}
+
+void timeSyncLoop() {
+  for (;;) {
+    int sz = sUdp.parsePacket();
+    if (sz <= 0) break;
+    int64_t localRx = esp_timer_get_time();
+    NetTimePacket p;
+    if (sz != (int)sizeof(p) || sUdp.read((uint8_t*)&p, sizeof(p)) != (int)sizeof(p)) continue;
+    if (p.magic != NET_TIME_MAGIC || p.version != NET_TIME_VERSION) continue;
+
+    if (p.type == NET_TIME_REPLY) onReply(p, localRx);
+    else if (p.type == NET_TIME_BEACON && !sSynced) stepTo(p.t3Us, localRx);
+  }
+
+  if (WiFi.status() != WL_CONNECTED) return;
+  uint32_t period = sSampleCount ? TIME_SYNC_INTERVAL_MS : TIME_SYNC_FAST_MS;
+  if (sPending && millis() - sSentMs < TIME_SYNC_TIMEOUT_MS) return;
+  if (millis() - sSentMs >= period) sendRequest();
+}
+
+void timeSyncFormatUtc(char* buf, size_t n) {
+  if (!sSynced) { strlcpy(buf, "-", n); return; }
+  int64_t us = timeSyncNowUs();
+  time_t sec = (time_t)(us / 1000000LL);
+  struct tm t; gmtime_r(&sec, &t);
+  snprintf(buf, n, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+           t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec,
+           (int)((us / 1000) % 1000));
+}
+
+void timeSyncPrintStatus(Stream& s) {
+  char iso[32]; timeSyncFormatUtc(iso, sizeof(iso));
+  s.printf("UTC: %s (%s)\n", iso, sSynced ? "synced" : "not synced");
+  s.printf("Time sync: offset=%+.3fms delay=%.3fms freq=%+.1fppm replies=%lu steps=%lu last=%lums ago\n",
+           sLastOffsetUs / 1000.0, sLastDelayUs / 1000.0, sFreq * 1e6,
+           (unsigned long)sReplies, (unsigned long)sSteps,
+           (unsigned long)(sReplies ? millis() - sLastReplyMs : 0));
+}
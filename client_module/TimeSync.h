@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+
+// Disciplined client clock.
+// Two-way exchange with the server (see NetProto.h) measures offset and round-trip delay;
+// the lowest-delay sample of the last few steers a monotonic microsecond clock
+// (step on large errors, slew + frequency trim on small ones).
+
+void    timeSyncBegin();
+void    timeSyncLoop();                 // send requests, read replies/beacons; call every loop()
+bool    timeSyncIsSynced();             // true once the clock has been set
+int64_t timeSyncNowUs();                // unix microseconds (meaningful once synced)
+double  timeSyncNowUnix();              // unix seconds with fraction
+void    timeSyncSeedUnix(uint32_t unix);// coarse set from a whole-second source, only if not synced
+void    timeSyncFormatUtc(char* buf, size_t n); // "YYYY-MM-DDTHH:MM:SS.mmmZ"
+void    timeSyncPrintStatus(Stream& s);
@@ -1,4 +1,6 @@
 #include "Tracking.h"
+#include "config.h"
+#include "Metrics.h"
 #include <Sgp4.h>   // SparkFun SGP4
 #include <math.h>
 
@@ -6,25 +8,250 @@ static Sgp4 sat;
 static double sLat=0, sLon=0, sAlt=0;
 static String sName, sL1, sL2;
 
+static void findsat(double jd) {
+  CycleTimer t;
+  sat.findsat(jd);
+  metricAdd(MET_FINDSAT_US, t.us());
+}
+
+// ===== Pass cache =====
+// SGP4 is evaluated every TRACK_CACHE_STEP_S; pointing in between is a cubic Hermite
+// spline over the topocentric unit vector (east, north, up). The vector is smooth through
+// zenith where azimuth is not; tangents are central differences of neighbouring nodes.
+struct Node { float e, n, u; float de, dn, du; };   // tangents per step
+static Node   sNodes[TRACK_CACHE_MAX_NODES];
+static double sCacheT0 = 0;
+static int    sCacheNodes = 0;   // planned
+static int    sFilled = 0;       // nodes with a position
+static int    sReady = 0;        // nodes with a tangent (interval k usable if k+1 < sReady)
+static int    sChecked = 0;      // next interval to verify
+
+static float    sMaxErrDeg = 0;
+static uint32_t sChecks = 0, sHits = 0, sMisses = 0;
+static uint32_t sBuildUs = 0;
+
+static inline double unixToJd(double t) { return t / 86400.0 + 2440587.5; }
+
+static void toEnu(float azDeg, float elDeg, float& e, float& n, float& u) {
+  float az = azDeg * (float)DEG_TO_RAD, el = elDeg * (float)DEG_TO_RAD;
+  float ce = cosf(el);
+  e = ce * sinf(az); n = ce * cosf(az); u = sinf(el);
+}
+
+static void fromEnu(float e, float n, float u, float& azDeg, float& elDeg) {
+  elDeg = atan2f(u, sqrtf(e*e + n*n)) * (float)RAD_TO_DEG;   // asin(u) loses precision near zenith
+  azDeg = atan2f(e, n) * (float)RAD_TO_DEG;
+  if (azDeg < 0) azDeg += 360.0f;
+}
+
+// Az/El rates (deg/s) of a unit vector moving at (de, dn, du) per second; the AZ rate
+// grows without bound towards zenith, where it is left to the step engine's speed limit
+static void enuRates(float e, float n, float u, float de, float dn, float du,
+                     float& azDps, float& elDps) {
+  float h2 = e*e + n*n, h = sqrtf(h2);
+  if (h < 1e-6f) { azDps = elDps = 0; return; }
+  azDps = (n*de - e*dn) / h2 * (float)RAD_TO_DEG;
+  float dh = (e*de + n*dn) / h;
+  elDps = (h*du - u*dh) / (h2 + u*u) * (float)RAD_TO_DEG;
+}
+
+// Derivative of the spline over interval k (per step)
+static void interpolateRate(int k, float s, float& de, float& dn, float& du) {
+  const Node& a = sNodes[k];
+  const Node& b = sNodes[k+1];
+  float s2 = s*s;
+  float g00 = 6*s2 - 6*s, g10 = 3*s2 - 4*s + 1, g01 = -6*s2 + 6*s, g11 = 3*s2 - 2*s;
+  de = g00*a.e + g10*a.de + g01*b.e + g11*b.de;
+  dn = g00*a.n + g10*a.dn + g01*b.n + g11*b.dn;
+  du = g00*a.u + g10*a.du + g01*b.u + g11*b.du;
+}
+
+static void interpolate(int k, float s, float& e, float& n, float& u) {
+  const Node& a = sNodes[k];
+  const Node& b = sNodes[k+1];
+  float s2 = s*s, s3 = s2*s;
+  float h00 = 2*s3 - 3*s2 + 1, h10 = s3 - 2*s2 + s, h01 = -2*s3 + 3*s2, h11 = s3 - s2;
+  e = h00*a.e + h10*a.de + h01*b.e + h11*b.de;
+  n = h00*a.n + h10*a.dn + h01*b.n + h11*b.dn;
+  u = h00*a.u + h10*a.du + h01*b.u + h11*b.du;
+}
+
+static void startCache(double fromUnix, double toUnix) {
+  sCacheT0 = fromUnix;
+  sFilled = sReady = sChecked = 0;
+  sMaxErrDeg = 0; sChecks = sHits = sMisses = 0; sBuildUs = 0;
+  if (fromUnix <= 0) { sCacheNodes = 0; return; }
+  if (toUnix <= fromUnix) toUnix = fromUnix + TRACK_CACHE_SPAN_S;
+  int n = (int)ceil((toUnix - fromUnix) / TRACK_CACHE_STEP_S) + 2;
+  sCacheNodes = constrain(n, 3, TRACK_CACHE_MAX_NODES);
+}
+
+// one unit of work: verify a finished interval or propagate the next node
+static void cacheStep() {
+  if (sChecked + 1 < sReady && (sChecked % TRACK_CACHE_CHECK_EVERY) == 0) {
+    findsat(unixToJd(sCacheT0 + (sChecked + 0.5) * TRACK_CACHE_STEP_S));
+    float e0, n0, u0, e1, n1, u1;
+    toEnu((float)sat.satAz, (float)sat.satEl, e0, n0, u0);
+    interpolate(sChecked, 0.5f, e1, n1, u1);
+    float r = sqrtf(e1*e1 + n1*n1 + u1*u1);
+    float de = e1/r - e0, dn = n1/r - n0, du = u1/r - u0;
+    float err = 2.0f * asinf(fminf(1.0f, 0.5f * sqrtf(de*de + dn*dn + du*du))) * (float)RAD_TO_DEG;
+    if (err > sMaxErrDeg) sMaxErrDeg = err;
+    sChecks++;
+    sChecked++;
+    return;
+  }
+  if (sChecked + 1 < sReady) { sChecked++; return; }
+  if (sFilled >= sCacheNodes) return;
+
+  int i = sFilled;
+  findsat(unixToJd(sCacheT0 + (double)i * TRACK_CACHE_STEP_S));
+  Node& p = sNodes[i];
+  toEnu((float)sat.satAz, (float)sat.satEl, p.e, p.n, p.u);
+  sFilled++;
+
+  if (i == 1) {             // forward difference at the start
+    Node& a = sNodes[0];
+    a.de = p.e - a.e; a.dn = p.n - a.n; a.du = p.u - a.u;
+  } else if (i >= 2) {      // central difference for the previous node
+    Node& m = sNodes[i-1]; const Node& a = sNodes[i-2];
+    m.de = 0.5f * (p.e - a.e); m.dn = 0.5f * (p.n - a.n); m.du = 0.5f * (p.u - a.u);
+  }
+  sReady = (i >= 1) ? i : 0;
+  if (sFilled == sCacheNodes && i >= 1) { // backward difference at the end
+    const Node& a = sNodes[i-1];
+    p.de = p.e - a.e; p.dn = p.n - a.n; p.du = p.u - a.u;
+    sReady = sFilled;
+  }
+}
+
+static bool cacheDone() { return sFilled >= sCacheNodes && sChecked + 1 >= sReady; }
+
+// ===== Pass sweep (pre-positioning) =====
+// Direct SGP4 every PREPOSITION_SAMPLE_S from the assignment to past LOS, a few samples
+// per trackingLoop() like the cache: the rise point and the unwrapped AZ turn after it.
+static TrackSweep sSweep = SWEEP_IDLE;
+static double sSweepT = 0, sSweepTo = 0;
+static bool   sSweepUp = false;
+static float  sRiseAz = 0, sRiseEl = 0, sPrevAz = 0, sTurn = 0, sTurnMin = 0, sTurnMax = 0;
+
+static void sweepStep() {
+  findsat(unixToJd(sSweepT));
+  float az = sat.satAz, el = sat.satEl;
+  sSweepT += PREPOSITION_SAMPLE_S;
+  if (el < 0.0f) {
+    if (sSweepUp) { sSweep = SWEEP_RISES; return; }   // set again
+  } else if (!sSweepUp) {
+    sSweepUp = true; sRiseAz = az; sRiseEl = el; sPrevAz = az;
+  } else {
+    float d = az - sPrevAz;
+    if (d > 180.0f) d -= 360.0f; else if (d < -180.0f) d += 360.0f;
+    sTurn += d; sPrevAz = az;
+    if (sTurn < sTurnMin) sTurnMin = sTurn;
+    if (sTurn > sTurnMax) sTurnMax = sTurn;
+  }
+  if (sSweepT > sSweepTo) sSweep = sSweepUp ? SWEEP_RISES : SWEEP_NO_RISE;
+}
+
+void trackingSweepStart(double fromUnix, double toUnix) {
+  sSweepT = fromUnix; sSweepTo = toUnix;
+  sSweepUp = false;
+  sTurn = sTurnMin = sTurnMax = 0;
+  sSweep = (toUnix >= fromUnix) ? SWEEP_RUNNING : SWEEP_NO_RISE;
+}
+
+void trackingSweepStop() { if (sSweep == SWEEP_RUNNING) sSweep = SWEEP_IDLE; }
+
+TrackSweep trackingSweepResult(float& riseAzDeg, float& riseElDeg, float& turnMinDeg, float& turnMaxDeg) {
+  riseAzDeg = sRiseAz; riseElDeg = sRiseEl;
+  turnMinDeg = sTurnMin; turnMaxDeg = sTurnMax;
+  return sSweep;
+}
+
+// The sweep goes first within the budget: the slew to the rise point waits on it
+void trackingLoop() {
+  bool cache = sCacheNodes > 0 && !cacheDone();
+  if (sSweep != SWEEP_RUNNING && !cache) return;
+  uint32_t start = micros();
+  while (sSweep == SWEEP_RUNNING && micros() - start < TRACK_CACHE_BUDGET_US) sweepStep();
+  if (!cache) return;
+  uint32_t cacheStart = micros();
+  while (!cacheDone() && micros() - start < TRACK_CACHE_BUDGET_US) cacheStep();
+  sBuildUs += micros() - cacheStart;
+}
+
 void trackingInit(const char* name, const char* tle1, const char* tle2,
-                  double lat, double lon, double alt) {
+                  double lat, double lon, double alt,
+                  double fromUnix, double toUnix) {
   sLat=lat; sLon=lon; sAlt=alt;
   sName = name; sL1=tle1; sL2=tle2;
 
-  sat.site(lat * DEG_TO_RAD, lon * DEG_TO_RAD, alt); // SparkFun expects radians for site lat/lon
+  sat.site(lat, lon, alt); // degrees / meters, same as the server's pass scheduler
   char nm[32]; strncpy(nm, name, sizeof(nm)); nm[sizeof(nm)-1]=0;
   char l1[130]; strncpy(l1, tle1, sizeof(l1)); l1[sizeof(l1)-1]=0;
   char l2[130]; strncpy(l2, tle2, sizeof(l2)); l2[sizeof(l2)-1]=0;
   sat.init(nm, l1, l2);
+
+  sSweep = SWEEP_IDLE;
+  startCache(fromUnix, toUnix);
 }
 
-bool trackingGetAzEl(unsigned long unixTime, float& azDeg, float& elDeg) {
-  sat.findsat((unsigned long)unixTime);
+// Pointing at unixTime from the cache, or direct SGP4; rates only if azDps is given
+static bool lookAt(double unixTime, float& azDeg, float& elDeg, float* azDps, float* elDps) {
+  if (sCacheNodes > 0) {
+    double x = (unixTime - sCacheT0) / TRACK_CACHE_STEP_S;
+    int k = (int)floor(x);
+    if (k >= 0 && k + 1 < sReady) {
+      float e, n, u;
+      interpolate(k, (float)(x - k), e, n, u);
+      fromEnu(e, n, u, azDeg, elDeg);
+      if (azDps) {
+        float de, dn, du;
+        interpolateRate(k, (float)(x - k), de, dn, du);
+        enuRates(e, n, u, de / TRACK_CACHE_STEP_S, dn / TRACK_CACHE_STEP_S, du / TRACK_CACHE_STEP_S, *azDps, *elDps);
+      }
+      sHits++;
+      return (elDeg >= 0.0f);
+    }
+    sMisses++;
+    // ran off the end of a finished window (long pass / no LOS): roll it forward
+    if (k + 1 >= sCacheNodes && sFilled >= sCacheNodes) {
+      startCache(unixTime - TRACK_CACHE_STEP_S, unixTime + TRACK_CACHE_SPAN_S);
+    }
+  }
+
+  // not cached (yet): direct SGP4
+  if (azDps) {
+    findsat(unixToJd(unixTime + TRACK_RATE_DT_S));
+    float az1 = sat.satAz, el1 = sat.satEl;
+    findsat(unixToJd(unixTime));
+    float d = az1 - sat.satAz;
+    if (d > 180.0f) d -= 360.0f; else if (d < -180.0f) d += 360.0f;
+    *azDps = d / (float)TRACK_RATE_DT_S;
+    *elDps = (el1 - sat.satEl) / (float)TRACK_RATE_DT_S;
+  } else {
+    findsat(unixToJd(unixTime)); // Julian date keeps the sub-second part
+  }
   // SparkFun Sgp4 gives az/el in degrees already:
   azDeg = sat.satAz;
   elDeg = sat.satEl;
   return (elDeg >= 0.0f); // is visible above horizon
 }
 
+bool trackingGetAzEl(double unixTime, float& azDeg, float& elDeg) {
+  return lookAt(unixTime, azDeg, elDeg, nullptr, nullptr);
+}
+
+bool trackingGetAzElRate(double unixTime, float& azDeg, float& elDeg, float& azDps, float& elDps) {
+  return lookAt(unixTime, azDeg, elDeg, &azDps, &elDps);
+}
+
 void trackingGetCurrentSite(double& lat, double& lon, double& alt) { lat=sLat; lon=sLon; alt=sAlt; }
-void trackingGetCurrentTLE(String& name, String& l1, String& l2){ name=sName; l1=sL1; l2=sL2; }
\ No newline at end of file
+void trackingGetCurrentTLE(String& name, String& l1, String& l2){ name=sName; l1=sL1; l2=sL2; }
+
+void trackingPrintStatus(Stream& s) {
+  if (sCacheNodes == 0) { s.println(F("Pass cache: off")); return; }
+  s.printf("Pass cache: %d/%d nodes @%ds, max err %.4f° (%lu checks), hits=%lu misses=%lu, build %lums\n",
+           sFilled, sCacheNodes, TRACK_CACHE_STEP_S, sMaxErrDeg, (unsigned long)sChecks,
+           (unsigned long)sHits, (unsigned long)sMisses, (unsigned long)(sBuildUs / 1000));
+}
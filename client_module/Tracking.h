@@ -1,9 +1,25 @@
 #pragma once
 #include <Arduino.h>
 
+// Sets the satellite and site and starts a pass cache covering [fromUnix, toUnix]
+// (toUnix <= fromUnix: TRACK_CACHE_SPAN_S). fromUnix = 0: no cache, direct SGP4 only.
 void trackingInit(const char* name, const char* tle1, const char* tle2,
-                  double lat, double lon, double alt);
-bool trackingGetAzEl(unsigned long unixTime, float& azDeg, float& elDeg);
+                  double lat, double lon, double alt,
+                  double fromUnix = 0, double toUnix = 0);
+void trackingLoop();   // runs the pass sweep, then fills the pass cache, a few SGP4 calls per call (time-budgeted)
+bool trackingGetAzEl(double unixTime, float& azDeg, float& elDeg);   // fractional seconds
+// Same, plus the target's angular rates (deg/s) for feed-forward tracking: the derivative
+// of the cached spline, or a short difference of direct SGP4 before the cache is ready
+bool trackingGetAzElRate(double unixTime, float& azDeg, float& elDeg, float& azDps, float& elDps);
+// Pass sweep for pre-positioning: scans [fromUnix, toUnix] with direct SGP4 every
+// PREPOSITION_SAMPLE_S, incrementally from trackingLoop() within the same budget as the
+// cache. Result: where the satellite first is above the horizon, and how far AZ turns from
+// there until it sets (unwrapped, min <= 0 <= max). trackingInit() resets it to idle.
+enum TrackSweep : uint8_t { SWEEP_IDLE, SWEEP_RUNNING, SWEEP_RISES, SWEEP_NO_RISE };
+void trackingSweepStart(double fromUnix, double toUnix);
+void trackingSweepStop();   // back to idle if still running
+TrackSweep trackingSweepResult(float& riseAzDeg, float& riseElDeg, float& turnMinDeg, float& turnMaxDeg);
 
 void trackingGetCurrentSite(double& lat, double& lon, double& alt);
-void trackingGetCurrentTLE(String& name, String& l1, String& l2);
\ No newline at end of file
+void trackingGetCurrentTLE(String& name, String& l1, String& l2);
+void trackingPrintStatus(Stream& s);
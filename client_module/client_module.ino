@@ -6,14 +6,16 @@
 #include <WiFiClient.h>
 #include <SPI.h>
 #include <SD.h>
-#include <ArduinoJson.h>
-#include <time.h>
 
 #include "config.h"
 #include "Motors.h"
+#include "PosJournal.h"
 #include "Tracking.h"
 #include "AudioPassthrough.h"
 #include "Commands.h"
+#include "TimeSync.h"
+#include "ServerLink.h"
+#include "Metrics.h"
 #if USE_TESTRUN
 #include "TestRun.h"
 #endif
@@ -21,24 +23,27 @@
 
 // --- Sockets ---
 WiFiClient client;
-WiFiUDP udp;         // time sync (UDP_PORT, e.g. 4210)
 WiFiUDP udpCmd;      // command listener (UDP_CMD_PORT, e.g. 4212)
 WiFiUDP udpReg;      // registrar HELLO/PING (SERVER_REG_PORT, e.g. 4213)
 
 // --- State ---
 String  gModuleName;      // MODULE-xxxxxx
-char    udpBuffer[256];
 
-String currentUTC;
 String curSatName, curTLE1, curTLE2;
 
 double obsLat = 0.0, obsLon = 0.0, obsAlt = 0.0;
 
+// Predicted pass window from the server scheduler (0 = not provided)
+unsigned long curAosUnix = 0, curLosUnix = 0;
+static const unsigned long AOS_GRACE_S = 60; // wait this long past predicted AOS before giving up
+
 enum Mode { MODE_WAIT, MODE_TRACK, MODE_HOME, MODE_STOP } mode = MODE_WAIT;
 static bool gHasLock = false; // becomes true after first valid above-horizon point
+static bool gPrepositioned = false;   // slew to the rise point issued for this assignment
+static uint32_t gPrepositions = 0, gWrapHomings = 0;
 
-unsigned long lastSatRequest = 0;
-const unsigned long satRequestIntervalMs = 50;
+uint32_t curAssignId = 0;   // server assignment being worked on (0 = none)
+static unsigned long gWaitSinceMs = 0;   // ready for an assignment since (0 = not waiting)
 
 SPIClass spiSD(VSPI);
 
@@ -49,24 +54,6 @@ static const float EL_MIN = 0.0f;     // horizon
 static const float EL_MAX = 180.0f;   // horizon stp
 
 // ===== Helpers =====
-unsigned long isoToUnix(const String &iso) {
-  if (iso.length() < 19) return 0;
-  int y = iso.substring(0,4).toInt();
-  int M = iso.substring(5,7).toInt();
-  int d = iso.substring(8,10).toInt();
-  int h = iso.substring(11,13).toInt();
-  int m = iso.substring(14,16).toInt();
-  int s = iso.substring(17,19).toInt();
-
-  struct tm t = {};
-  t.tm_year = y - 1900; t.tm_mon = M - 1; t.tm_mday = d;
-  t.tm_hour = h; t.tm_min = m; t.tm_sec = s; t.tm_isdst = 0;
-
-  setenv("TZ", "UTC", 1); tzset();
-  time_t ut = mktime(&t);           // mktime with TZ=UTC behaves like timegm
-  return (unsigned long)ut;
-}
-
 // Network
 void printWiFiDebug() {
   Serial.println(F("[NET] ---------"));
@@ -76,143 +63,100 @@ void printWiFiDebug() {
   Serial.printf("[NET] Subnet    : %s\n", WiFi.subnetMask().toString().c_str());
   Serial.printf("[NET] DNS       : %s\n", WiFi.dnsIP().toString().c_str());
   Serial.printf("[NET] RSSI      : %d dBm\n", WiFi.RSSI());
-  Serial.printf("[NET] Master IP : %s:%d\n", MASTER_IP, TCP_PORT);
+  Serial.printf("[NET] Master IP : %s:%d (link %s)\n", MASTER_IP, NET_LINK_PORT, linkConnected() ? "up" : "down");
   Serial.println(F("[NET] ---------"));
 }
 
-// Fetch one JSON line from host:port (server closes after sending)
-bool fetchSatelliteLineFrom(IPAddress hostIP, uint16_t port, String& outJsonLine) {
-  WiFiClient c;
-  c.setTimeout(2000); // ms
-  outJsonLine = "";
-
-  for (int attempt = 1; attempt <= 3; attempt++) {
-    if (!c.connect(hostIP, port)) {
-      Serial.printf("❌ TCP connect failed to %s:%u (attempt %d/3)\n",
-                    hostIP.toString().c_str(), port, attempt);
-      delay(150);
-      continue;
-    }
-    outJsonLine = c.readStringUntil('\n'); // server sends one line then closes
-    c.stop();
-    if (outJsonLine.length() == 0) {
-      Serial.printf("❌ TCP got 0 bytes from %s:%u (attempt %d/3)\n",
-                    hostIP.toString().c_str(), port, attempt);
-      delay(150);
-      continue;
-    }
-    Serial.printf("[TCP] %uB from %s:%u\n", (unsigned)outJsonLine.length(),
-                  hostIP.toString().c_str(), port);
-    return true;
+// Start on an assignment pushed by the server (see ServerLink)
+static void startAssignment(const NetAssign& a) {
+  curAssignId = a.id;
+  curSatName = a.name;
+  curTLE1    = a.line1;
+  curTLE2    = a.line2;
+  timeSyncSeedUnix(a.serverUnix); // until the first time sync reply
+  obsLat     = a.siteLat;
+  obsLon     = a.siteLon;
+  obsAlt     = a.siteAlt;
+  curAosUnix = a.aosUnix;
+  curLosUnix = a.losUnix;
+
+  // pass cache from now until LOS (or TRACK_CACHE_SPAN_S when the server sent no pass)
+  double from = 0, to = 0;
+  if (timeSyncIsSynced()) {
+    from = timeSyncNowUnix() - TRACK_CACHE_STEP_S;
+    if (curLosUnix > from) to = (double)curLosUnix + TRACK_CACHE_STEP_S;
   }
-  return false;
-}
+  trackingInit(curSatName.c_str(), curTLE1.c_str(), curTLE2.c_str(), obsLat, obsLon, obsAlt, from, to);
 
-static void processUDPTime() {
-  int sz = udp.parsePacket();
-  if (!sz) return;
-  int len = udp.read(udpBuffer, sizeof(udpBuffer)-1);
-  if (len <= 0) return;
-  udpBuffer[len] = 0;
-
-  StaticJsonDocument<256> doc;
-  if (deserializeJson(doc, udpBuffer)) return;
-  String iso = doc["current_time_utc"].as<String>();
-  if (iso.length()) {
-    currentUTC = iso;
 #if DEBUG
-    static unsigned long lastLog = 0;
-    unsigned long now = millis();
-    if (now - lastLog > 5000) {
-      Serial.print(F("⏰ UTC "));
-      Serial.println(currentUTC);
-      lastLog = now;
-    }
+  Serial.printf("📡 Tracking #%lu: %s\n", (unsigned long)curAssignId, curSatName.c_str());
 #endif
-  }
-}
-
-// Uses MASTER_IP first, then falls back to AP gateway if needed
-static bool requestSatelliteFromServer() {
-  String line;
-  IPAddress ipMaster; ipMaster.fromString(MASTER_IP);
-  bool ok = fetchSatelliteLineFrom(ipMaster, TCP_PORT, line);
-
-  if (!ok) {
-    IPAddress gw = WiFi.gatewayIP();
-    if (gw && gw != ipMaster) {
-      Serial.printf("[NET] Fallback: trying gateway %s:%u\n", gw.toString().c_str(), TCP_PORT);
-      ok = fetchSatelliteLineFrom(gw, TCP_PORT, line);
-    }
-  }
-
-  if (!ok) {
-    static unsigned long lastDump = 0;
-    if (millis() - lastDump > 10000) { printWiFiDebug(); lastDump = millis(); }
-    return false;
-  }
 
-  StaticJsonDocument<2048> d;
-  DeserializationError err = deserializeJson(d, line);
-  if (err) {
-#if DEBUG
-    Serial.print(F("❌ JSON error: "));
-    Serial.println(err.c_str());
-    Serial.println(line);
-#endif
-    return false;
-  }
+  // Do NOT enable tracking/laser yet. Wait for first valid above-horizon point.
+  gHasLock = false;
+  gPrepositioned = false;
+  motorsSetTrackingActive(false); // keeps laser/speaker off until lock
+  mode = MODE_TRACK;
+}
 
-  if (d.containsKey("error")) {
-#if DEBUG
-    Serial.printf("⚠️ Server replied error: %s\n", d["error"].as<const char*>());
+// Slew (laser off) to where the assigned pass rises, with AZ on the side of the cable wrap
+// that leaves room for the whole pass. Homes only if no start keeps the pass in the budget.
+// Called every loop before the lock: starts the pass sweep, which trackingLoop() runs a few
+// samples at a time, and acts once it is complete.
+static void prepositionForPass(double ut) {
+#if USE_TESTRUN
+  if (TestRun::isEnabled()) { gPrepositioned = true; return; }
 #endif
-    return false;
+  float az, el, turnMin, turnMax;
+  switch (trackingSweepResult(az, el, turnMin, turnMax)) {
+    case SWEEP_IDLE:
+      trackingSweepStart(ut, (curLosUnix > ut) ? (double)curLosUnix + PREPOSITION_LOS_MARGIN_S
+                                               : ut + TRACK_CACHE_SPAN_S);
+      return;
+    case SWEEP_RUNNING: return;
+    case SWEEP_NO_RISE: gPrepositioned = true; return;   // does not rise in the window
+    case SWEEP_RISES:   gPrepositioned = true; break;
   }
-
-  curSatName = d["name"].as<String>();
-  curTLE1    = d["tle"]["line-1"].as<String>();
-  curTLE2    = d["tle"]["line-2"].as<String>();
-  currentUTC = d["current_time_utc"].as<String>();
-  obsLat     = d["latitude"].as<double>();
-  obsLon     = d["longitude"].as<double>();
-  obsAlt     = 0.0;
-
-  trackingInit(curSatName.c_str(), curTLE1.c_str(), curTLE2.c_str(), obsLat, obsLon, obsAlt);
-
+  if (motorsPrePosition(az, el, turnMin, turnMax)) { gPrepositions++; return; }
+  gWrapHomings++;
 #if DEBUG
-  Serial.print(F("📡 Tracking: "));
-  Serial.println(curSatName);
-  Serial.print(F("⏰ UTC "));
-  Serial.println(currentUTC);
+  Serial.printf("🧵 Pass turns %.0f..%+.0f deg, beyond the cable wrap -> home\n", turnMin, turnMax);
 #endif
+  motorsReturnToNull();
+}
 
-  // Do NOT enable tracking/laser yet. Wait for first valid above-horizon point.
-  gHasLock = false;
-  motorsSetTrackingActive(false); // keeps laser/speaker off until lock
-  mode = MODE_TRACK;
-  return true;
+// Leave the current assignment (if any) and tell the server why
+static void finishAssignment(NetDoneReason reason) {
+  if (curAssignId) linkDone(curAssignId, reason);
+  curAssignId = 0;
 }
 
 // ===== Command callbacks =====
-static bool onStartCmd() { motorsSetTrackingActive(false); mode = MODE_WAIT; lastSatRequest = 0; Serial.println(F("OK START (resuming)")); return true; }
-static void onStopCmd()  { motorsSetTrackingActive(false); mode = MODE_STOP; Serial.println(F("OK STOP (paused)")); }
+static bool onStartCmd() { motorsSetTrackingActive(false); mode = MODE_WAIT; Serial.println(F("OK START (resuming)")); return true; }
+static void onStopCmd()  { motorsSetTrackingActive(false); finishAssignment(NET_DONE_SKIPPED); mode = MODE_STOP; Serial.println(F("OK STOP (paused)")); }
 static void onStepAzCmd(int32_t steps) { motorsManualStepAZ(steps); Serial.printf("OK STEP AZ %ld\n",(long)steps); }
 static void onStepElCmd(int32_t steps) { motorsManualStepEL(steps); Serial.printf("OK STEP EL %ld\n",(long)steps); }
 static void onGotoAzCmd(float az) { motorsGotoAzDeg(az); Serial.printf("OK GOTO AZ %.2f\n", az); }
 static void onGotoElCmd(float el) { motorsGotoElDeg(el); Serial.printf("OK GOTO EL %.2f\n", el); }
-static bool onRequestSatelliteCmd() { mode = MODE_WAIT; lastSatRequest = 0; return true; }
+static bool onRequestSatelliteCmd() { motorsSetTrackingActive(false); finishAssignment(NET_DONE_SKIPPED); mode = MODE_WAIT; return true; }
 
 static void onStatusPrint(Stream& s) {
   s.println(F("=== STATUS ==="));
   s.printf("Mode: %s\n", (mode==MODE_STOP)?"STOP":(mode==MODE_WAIT)?"WAIT":(mode==MODE_TRACK)?"TRACK":"HOME");
-  s.printf("UTC: %s\n", currentUTC.c_str());
+  timeSyncPrintStatus(s);
+  s.printf("Link: %s, queued %d, assignment #%lu\n", linkConnected() ? "up" : "down", linkQueued(), (unsigned long)curAssignId);
   double lat, lon, alt; trackingGetCurrentSite(lat, lon, alt);
   s.printf("Site: lat=%.6f lon=%.6f alt=%.1f\n", lat, lon, alt);
   s.printf("Laser: %s\n",(motorsGetLaserMode()==LASER_OFF)?"OFF":(motorsGetLaserMode()==LASER_ON)?"ON":"TRACK");
+  s.printf("Cable wrap: %+.2f turns (limit %.0f deg)\n", motorsAzWrapTurns(), AZ_WRAP_LIMIT_DEG);
+  s.printf("Pre-position: %lu slews, %lu wrap homings\n", (unsigned long)gPrepositions, (unsigned long)gWrapHomings);
+  motorsPrintTrackStatus(s);
   audioPrintStatus(s);
   String n,l1,l2; trackingGetCurrentTLE(n,l1,l2);
   s.printf("TLE: %s\n", n.c_str());
+  trackingPrintStatus(s);
+  journalPrintStatus(s);
+  metricsPrintStatus(s);
 }
 
 // ===== Setup =====
@@ -267,12 +211,13 @@ void setup() {
     Serial.printf("👋 Sent HELLO as %s to %s:%d\n",
                   gModuleName.c_str(), serverIP.toString().c_str(), SERVER_REG_PORT);
   }
+  linkBegin(gModuleName.c_str()); // assignments are pushed over the module link
 
-  udp.begin(UDP_PORT);        // time sync listener
+  timeSyncBegin();            // time sync (UDP_PORT)
   udpCmd.begin(UDP_CMD_PORT); // command listener
   Serial.printf("🎛️  Listening for commands on UDP %d\n", UDP_CMD_PORT);
 #if DEBUG
-  Serial.println(F("🕒 Listening UDP time"));
+  Serial.println(F("🕒 Time sync on UDP"));
 #endif
 
   // Commands
@@ -293,35 +238,64 @@ void setup() {
 #endif
 
   mode = MODE_WAIT;
-  lastSatRequest = 0;
+}
+
+// ===== UDP commands (see NetProto.h) =====
+// Acked before running, so the server's latency figure is the network round trip.
+#define CMD_SEEN_SLOTS 16
+static uint32_t gCmdSeenEpoch[CMD_SEEN_SLOTS], gCmdSeenSeq[CMD_SEEN_SLOTS];
+static int gCmdSeenNext = 0;
+
+static bool cmdAlreadyRun(uint32_t epoch, uint32_t seq) {
+  for (int i = 0; i < CMD_SEEN_SLOTS; i++) if (gCmdSeenSeq[i] == seq && gCmdSeenEpoch[i] == epoch) return true;
+  gCmdSeenEpoch[gCmdSeenNext] = epoch;
+  gCmdSeenSeq[gCmdSeenNext] = seq;
+  gCmdSeenNext = (gCmdSeenNext + 1) % CMD_SEEN_SLOTS;
+  return false;
+}
+
+static void pollUdpCommands() {
+  static char buf[sizeof(NetCmdHeader) + NET_CMD_MAX_TEXT + 1];
+  while (udpCmd.parsePacket() > 0) {
+    int n = udpCmd.read((uint8_t*)buf, sizeof(buf) - 1);
+    if (n <= 0) continue;
+    NetCmdHeader h;
+    if (n >= (int)sizeof(h)) memcpy(&h, buf, sizeof(h));
+    if (n >= (int)sizeof(h) && h.magic == NET_CMD_MAGIC) {
+      if (h.type != NET_CMD_EXEC || h.len > n - (int)sizeof(h)) continue;
+      NetCmdHeader ack = { NET_CMD_MAGIC, NET_CMD_ACK, NET_CMD_VERSION, 0, h.epoch, h.seq };
+      udpCmd.beginPacket(udpCmd.remoteIP(), udpCmd.remotePort());
+      udpCmd.write((const uint8_t*)&ack, sizeof(ack));
+      udpCmd.endPacket();
+      if (cmdAlreadyRun(h.epoch, h.seq)) continue;   // retransmit of a command we already ran
+      char* text = buf + sizeof(h);
+      text[h.len] = '\0';
+      Commands::inject(text, h.len);
+      Serial.printf("CMD[udp #%lu]: %s\n", (unsigned long)h.seq, text);
+    } else {
+      // plain text (no ack)
+      buf[n] = '\0';
+      Commands::inject(buf, n);
+      Serial.printf("CMD[udp]: %s\n", buf);
+    }
+  }
 }
 
 // ===== Loop =====
-void loop() {
+// One pass of the main loop; returns how long to idle afterwards (ms), so the
+// loop_us metric measures work only.
+static uint32_t loopStep() {
   // Serial commands (from USB)
   Commands::poll();
 
-  // Time sync & audio
-  processUDPTime();
-  audioLoop();
+  // Time sync & motion bookkeeping (audio runs in its own task)
+  timeSyncLoop();
+  linkLoop(!(mode == MODE_TRACK && gHasLock));   // no blocking reconnect mid-pass
+  motorsLoop();
+  trackingLoop();
 
   // UDP command listener (from server UI / /send endpoint)
-  {
-    int sz = udpCmd.parsePacket();
-    if (sz > 0) {
-      static char cmdbuf[256];
-      int n = udpCmd.read(cmdbuf, sizeof(cmdbuf) - 1);
-      if (n > 0) {
-        cmdbuf[n] = '\0';
-        String cmd = String(cmdbuf);
-        cmd.trim();
-        if (cmd.length()) {
-          Commands::CommandsInject(cmd);
-          Serial.printf("CMD[udp]: %s\n", cmd.c_str());
-        }
-      }
-    }
-  }
+  pollUdpCommands();
 
   // Periodic PING to server registrar
   static unsigned long lastPing = 0;
@@ -330,48 +304,54 @@ void loop() {
     IPAddress serverIP; serverIP.fromString(MASTER_IP);
     udpReg.beginPacket(serverIP, SERVER_REG_PORT);
     udpReg.print("PING "); udpReg.print(gModuleName);
+    char summary[320];
+    if (metricsFormatSummary(summary, sizeof(summary))) { udpReg.print(' '); udpReg.print(summary); }
     udpReg.endPacket();
   }
 
   // STOP mode: idle
-  if (mode == MODE_STOP) { delay(10); return; }
+  if (mode == MODE_STOP) { gWaitSinceMs = 0; return 10; }
 
-  // WAIT mode: ask for a satellite every satRequestIntervalMs
+  // WAIT mode: start the next assignment the server has pushed
   if (mode == MODE_WAIT) {
     motorsSetTrackingActive(false); // laser off between sats
-    if (millis() - lastSatRequest > satRequestIntervalMs) {
-      if (!requestSatelliteFromServer()) {
-#if DEBUG
-        Serial.println(F("…waiting for satellite"));
-#endif
-      }
-      lastSatRequest = millis();
-    }
-    delay(5);
-    return;
+    if (motorsIsMoving()) return 5; // let a HOME or GOTO finish before the next pass
+    if (!gWaitSinceMs) gWaitSinceMs = millis() | 1;
+    NetAssign a;
+    if (!linkTakeAssignment(a)) return 5;
+    metricAdd(MET_WAIT_MS, millis() - gWaitSinceMs);
+    gWaitSinceMs = 0;
+    startAssignment(a);
+    return 0;
   }
 
   // TRACK mode: compute Az/El and move; enable laser only after first valid point
   if (mode == MODE_TRACK) {
-    unsigned long ut = isoToUnix(currentUTC);
-    if (!ut) { delay(10); return; }
+    if (!timeSyncIsSynced()) return 10;
+    uint32_t sampledUs = micros();
+    double ut = timeSyncNowUnix();
+
+    // Before the lock: head for the rise point while the pass is still below the horizon
+    if (!gHasLock && !gPrepositioned) prepositionForPass(ut);
 
-    float az=0, el=0;
+    float az=0, el=0, azDps=0, elDps=0;
     bool ok = false;
 
 #if USE_TESTRUN
-    if (TestRun::isEnabled()) ok = TestRun::getAzEl((time_t)ut, az, el);
-    else                      ok = trackingGetAzEl(ut, az, el);
+    if (TestRun::isEnabled()) ok = TestRun::getAzEl(ut, az, el, azDps, elDps);
+    else                      ok = trackingGetAzElRate(ut, az, el, azDps, elDps);
 #else
-    ok = trackingGetAzEl(ut, az, el);
+    ok = trackingGetAzElRate(ut, az, el, azDps, elDps);
 #endif
 
     if (ok && el >= EL_MIN && el <= EL_MAX) {
       // First valid point above horizon? Acquire lock and allow laser
       if (!gHasLock) {
         gHasLock = true;
+        trackingSweepStop();           // already up: no rise point to head for
+        motorsTrackReset();
         motorsSetTrackingActive(true); // this may enable laser if LASER_TRACK mode
-        audioBeepPlay();               // “start tracking” beep (if enabled)
+        audioBeepTrackStart();         // “start tracking” beep (if enabled)
 #if DEBUG
         Serial.println(F("🔒 Lock acquired (laser allowed under TRACK mode)"));
 #endif
@@ -382,37 +362,50 @@ void loop() {
       bool big = (fabs(az-la)>0.5f) || (fabs(el-le)>0.5f);
       if (now-lastLog>1000 || big) { Serial.printf("[TRK] AZ=%.2f  EL=%.2f\n", az, el); lastLog=now; la=az; le=el; }
 #endif
-      motorsTrackTo(az, el);
-      return;
+      motorsTrackTo(az, el, azDps, elDps, sampledUs);
+      return 0;
     }
 
+    // Predicted pass not risen yet: keep waiting (pre-positioned) instead of re-requesting
+    if (!gHasLock && curAosUnix && ut < curAosUnix + AOS_GRACE_S) return 10;
+
     // Not ok or below horizon/out of window
     if (gHasLock) {
 #if DEBUG
-      Serial.println(F("🌅 End of pass -> home + request next"));
+      Serial.println(F("🌅 End of pass -> next"));
 #endif
-      audioBeepPlay();            // “end tracking” beep (if enabled)
+      audioBeepTrackEnd();        // “end tracking” beep (if enabled)
+      motorsPrintTrackStatus(Serial);
     } else {
 #if DEBUG
-      Serial.println(F("🌅 Below horizon -> home + request next"));
+      Serial.println(F("🌅 Below horizon -> next"));
 #endif
     }
 
+    finishAssignment(gHasLock ? NET_DONE_PASS_END : NET_DONE_NOT_VISIBLE);
     motorsSetTrackingActive(false); // ensure laser off when leaving tracking
     gHasLock = false;
 
-    motorsReturnToNull();
+    // no homing: the next assignment slews straight to its rise point (prepositionForPass)
     mode = MODE_WAIT;
-    lastSatRequest = 0;
-    return;
+    return 0;
   }
 
   // HOME mode: return to null, then wait
   if (mode == MODE_HOME) {
     motorsSetTrackingActive(false);
+    finishAssignment(NET_DONE_SKIPPED);
     gHasLock = false;
     motorsReturnToNull();
     mode = MODE_WAIT;
-    return;
+    return 0;
   }
-}
\ No newline at end of file
+  return 0;
+}
+
+void loop() {
+  CycleTimer t;
+  uint32_t idleMs = loopStep();
+  metricAdd(MET_LOOP_US, t.us());
+  if (idleMs) delay(idleMs);
+}
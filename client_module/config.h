@@ -4,11 +4,28 @@
 #define WIFI_SSID   "ESP32_Master_Network"
 #define WIFI_PASS   "123456789"
 #define MASTER_IP   "192.168.4.1"
-#define TCP_PORT    80
 #define UDP_PORT    4210
 #define UDP_CMD_PORT 4212
 #define SERVER_REG_PORT 4213
 
+// ===== Module link (persistent TCP to the server, see NetProto.h) =====
+#define LINK_QUEUE_DEPTH        2       // current + next assignment
+#define LINK_HEARTBEAT_MS       5000
+#define LINK_TIMEOUT_MS         15000   // reconnect if the server has been silent this long
+#define LINK_RECONNECT_MS       2000
+#define LINK_CONNECT_TIMEOUT_MS 500
+
+// ===== Time sync =====
+#define TIME_SYNC_INTERVAL_MS   1000    // request period once synced
+#define TIME_SYNC_FAST_MS       250     // request period until the first good sample
+#define TIME_SYNC_TIMEOUT_MS    500     // give up on an unanswered request
+#define TIME_SYNC_FILTER_N      8       // keep this many samples, use the lowest-delay one
+#define TIME_SYNC_MAX_DELAY_US  100000  // discard round trips longer than this
+#define TIME_SYNC_STEP_US       128000  // errors above this are stepped, below slewed
+#define TIME_SYNC_SLEW_DIV      20      // slew at most 1/20 of elapsed time (5%, stays monotonic)
+#define TIME_SYNC_MAX_PPM       500.0   // frequency correction clamp
+#define TIME_SYNC_FREQ_BASE_S   32      // minimum baseline for a frequency update
+
 // ===== Debug =====
 #define DEBUG 1
 
@@ -41,6 +58,10 @@
 #define EL_MIN_DEG  0.0f
 #define EL_MAX_DEG  180.0f
 
+// ===== Cable wrap =====
+// AZ may turn at most this far either way from the cable's null (>= 180 to reach every azimuth)
+#define AZ_WRAP_LIMIT_DEG  360.0f
+
 // ===== Laser mode =====
 enum LaserMode : uint8_t { LASER_OFF=0, LASER_ON=1, LASER_TRACK=2 };
 #define LASER_DEFAULT_MODE LASER_TRACK
@@ -56,18 +77,64 @@ enum LaserMode : uint8_t { LASER_OFF=0, LASER_ON=1, LASER_TRACK=2 };
 #define EL_STEPS_PER_DEG   10.6667f // ~ 2048 steps / 192 deg ≈ 10.667 steps/deg (28BYJ-48)
 #define AZ_MAX_SPEED_DPS   90.0f    // deg per second max slew
 #define EL_MAX_SPEED_DPS   45.0f    // deg per second max slew
-#define AZ_STEP_DELAY_US   500      // microseconds per step at base speed
-#define EL_STEP_DELAY_US   1200
+#define AZ_ACCEL_DPS2      180.0f   // deg per second^2
+#define EL_ACCEL_DPS2      90.0f
+#define AZ_STEP_DELAY_US   500      // min half-period of the AZ step pulse (caps AZ speed)
+#define EL_STEP_DELAY_US   1200     // min time per EL half-step (caps EL speed)
+#define STEP_TICK_HZ       20000    // step engine timer rate
+
+// ===== Position journal (RTC ring + NVS checkpoint, see PosJournal.h) =====
+#define JOURNAL_RTC_SLOTS         16
+#define JOURNAL_MOVING_MS         100     // journal the live position this often while moving
+#define JOURNAL_IDLE_FLUSH_MS     2000    // checkpoint to NVS once at rest this long
+#define JOURNAL_MAX_FLUSH_MS      60000   // ...and at least this often while moving/tracking
+
+// ===== Tracking (pass ephemeris cache) =====
+#define TRACK_CACHE_STEP_S        4       // SGP4 node spacing; pointing is Hermite-interpolated between nodes
+#define TRACK_CACHE_MAX_NODES     320     // ~21 min at 4 s
+#define TRACK_CACHE_SPAN_S        900     // window when the server sent no LOS
+#define TRACK_CACHE_BUDGET_US     3000    // propagation time per trackingLoop()
+#define TRACK_CACHE_CHECK_EVERY   4       // compare every n-th interval midpoint with direct SGP4
+
+// ===== Tracking control (motorsTrackTo) =====
+#define TRACK_FEED_FORWARD        1       // 0: step to each sampled position (the old law, for comparison)
+#define TRACK_KP_PER_S            4.0f    // correction: deg/s per degree of error...
+#define TRACK_CORR_MAX_DPS        2.0f    // ...bounded to this on top of the target's rate
+#define TRACK_ACQUIRE_DEG         1.0f    // further off than this: plain slew to the predicted point
+#define TRACK_SETTLE_MS           2000    // errors count as steady state after this long within TRACK_ACQUIRE_DEG
+#define TRACK_HORIZON_MAX_MS      250     // longest the axes keep moving on one command
+#define TRACK_RATE_DT_S           0.5     // rate by difference when the pass cache is not ready
+
+// ===== Pre-positioning (slew to where the next pass rises instead of homing) =====
+#define PREPOSITION_SAMPLE_S      15      // SGP4 spacing when scanning a pass for its AZ turn
+#define PREPOSITION_LOS_MARGIN_S  180     // scan past the server's LOS (10 deg) down to the horizon
+
+// ===== Audio stream =====
+#define AUDIO_SAMPLE_RATE         20000 // Hz, ADC DMA + DAC timer (20 kHz is the ESP32 ADC DMA minimum)
+#define AUDIO_BLOCK_SAMPLES       256   // samples per DMA frame / DSP block
+#define AUDIO_TASK_CORE           0
+#define AUDIO_TASK_PRIO           10
 
 // ===== Audio defaults =====
 #define AUDIO_FIXED_VOLUME        180   // 0..255 passthrough base vol
-#define AUDIO_LIMIT               3600  // 0..4095
+#define AUDIO_LIMIT               3600  // 2048..4095 (mid-scale = 2048)
 #define INJECT_NOISE_WHEN_MOVING  true
 #define INJECT_NOISE_MIX          0.12f // 0..1
 #define INJECT_NOISE_FLOOR        180
 #define NOTCH_ON                  false
 #define NOTCH_HZ                  2500.0f
 #define NOTCH_Q                   12.0f
+// noise gate / AGC (levels in ADC units like the limiter, see AudioDsp.h)
+#define AUDIO_GATE_ON             false
+#define AUDIO_GATE_THRESH         60
+#define AUDIO_GATE_HOLD_MS        200
+#define AUDIO_GATE_RELEASE_MS     150
+#define AUDIO_AGC_ON              false
+#define AUDIO_AGC_TARGET          900   // peak level the AGC aims for
+#define AUDIO_AGC_MAX_GAIN_DB     18.0f
+#define AUDIO_AGC_RATIO           4.0f  // compression above the target
+#define AUDIO_AGC_ATTACK_MS       5
+#define AUDIO_AGC_RELEASE_MS      300
 
 // Beeps
 #define BEEP_ON_TRACK_START   false
@@ -78,6 +145,12 @@ enum LaserMode : uint8_t { LASER_OFF=0, LASER_ON=1, LASER_TRACK=2 };
 #define BEEP_ECHO_DECAY       0.45f
 #define BEEP_VOLUME           0     // start quieter Default 120
 
+// Tone synth (see AudioSynth.h)
+#define SYNTH_VOICES          4     // notes sounding at once (oldest is replaced)
+#define SYNTH_QUEUE_DEPTH     8     // pending note events, power of two
+#define SYNTH_ATTACK_MS       2     // linear fade in/out, avoids clicks
+#define SYNTH_RELEASE_MS      8
+
 // Optional boot sanity beep
 #define AUDIO_BOOT_TONE_TEST  1
 
@@ -0,0 +1,189 @@
+#include "AssignPlanner.h"
+#include "ModuleLink.h"
+#include "JsonWriter.h"
+#include <math.h>
+
+struct Held {
+  uint32_t  id;          // assignment id (0 = free slot)
+  IPAddress ip;
+  PassInfo  pass;
+  uint32_t  startUnix;   // AOS, or the LOS of the module's previous pass if that is later
+};
+
+static Held sHeld[PLAN_MAX_HELD];
+
+// score matrix and Hungarian state (1-based as in the textbook formulation)
+static const int MAX_ROWS = PLAN_MAX_WORKERS;
+static const int MAX_COLS = PASS_QUEUE_MAX + PLAN_MAX_WORKERS;   // jobs + one "nothing" per worker
+static float    sCost[MAX_ROWS + 1][MAX_COLS + 1];
+static PassInfo sJobs[PASS_QUEUE_MAX];
+
+static inline uint32_t later(uint32_t a, uint32_t b) { return a > b ? a : b; }
+static inline uint32_t earlier(uint32_t a, uint32_t b) { return a < b ? a : b; }
+
+// Module is free after the last pass it holds (or now)
+static uint32_t freeAt(IPAddress ip, uint32_t now) {
+  uint32_t t = now;
+  for (int i = 0; i < PLAN_MAX_HELD; i++) {
+    if (sHeld[i].id && sHeld[i].ip == ip) t = later(t, sHeld[i].pass.losUnix);
+  }
+  return t;
+}
+
+static bool isHeld(uint32_t norad) {
+  for (int i = 0; i < PLAN_MAX_HELD; i++) if (sHeld[i].id && sHeld[i].pass.norad == norad) return true;
+  return false;
+}
+
+// Angle between the two culminations (deg)
+static float skySeparation(const PassInfo& a, const PassInfo& b) {
+  float e1 = a.maxElDeg * DEG_TO_RAD, e2 = b.maxElDeg * DEG_TO_RAD;
+  float c = sinf(e1) * sinf(e2) + cosf(e1) * cosf(e2) * cosf((a.tcaAzDeg - b.tcaAzDeg) * DEG_TO_RAD);
+  return acosf(constrain(c, -1.0f, 1.0f)) * RAD_TO_DEG;
+}
+
+// Score of pass p for a module free at 'free'; <= 0 means not worth it / not feasible
+static float score(const PassInfo& p, IPAddress ip, uint32_t free) {
+  uint32_t start = later(p.aosUnix, free);
+  if (p.losUnix < start + PASS_MIN_REMAIN_S) return 0;
+  float s = (float)(p.losUnix - start) + PLAN_EL_WEIGHT_S * p.maxElDeg;
+  if (p.aosUnix > free) s -= PLAN_IDLE_WEIGHT * (float)(p.aosUnix - free);
+
+  // concurrent passes of other modules in the same part of the sky
+  for (int i = 0; i < PLAN_MAX_HELD; i++) {
+    const Held& h = sHeld[i];
+    if (!h.id || h.ip == ip) continue;
+    uint32_t a = later(start, h.startUnix), b = earlier(p.losUnix, h.pass.losUnix);
+    if (b <= a) continue;
+    float sep = skySeparation(p, h.pass);
+    if (sep < PLAN_SEP_MIN_DEG) s -= PLAN_SEP_WEIGHT * (float)(b - a) * (1.0f - sep / PLAN_SEP_MIN_DEG);
+  }
+  return s;
+}
+
+// Minimum-cost assignment of rows 1..n to distinct columns 1..m (n <= m); col[i] = column of row i
+static void hungarian(int n, int m, int* col) {
+  static float u[MAX_ROWS + 1], v[MAX_COLS + 1], minv[MAX_COLS + 1];
+  static int   p[MAX_COLS + 1], way[MAX_COLS + 1];
+  static bool  used[MAX_COLS + 1];
+  for (int i = 0; i <= n; i++) u[i] = 0;
+  for (int j = 0; j <= m; j++) { v[j] = 0; p[j] = 0; }
+  for (int i = 1; i <= n; i++) {
+    p[0] = i;
+    int j0 = 0;
+    for (int j = 0; j <= m; j++) { minv[j] = INFINITY; used[j] = false; }
+    do {
+      used[j0] = true;
+      int i0 = p[j0], j1 = 0;
+      float delta = INFINITY;
+      for (int j = 1; j <= m; j++) {
+        if (used[j]) continue;
+        float cur = sCost[i0][j] - u[i0] - v[j];
+        if (cur < minv[j]) { minv[j] = cur; way[j] = j0; }
+        if (minv[j] < delta) { delta = minv[j]; j1 = j; }
+      }
+      for (int j = 0; j <= m; j++) {
+        if (used[j]) { u[p[j]] += delta; v[j] -= delta; }
+        else minv[j] -= delta;
+      }
+      j0 = j1;
+    } while (p[j0] != 0);
+    do { int j1 = way[j0]; p[j0] = p[j1]; j0 = j1; } while (j0);
+  }
+  for (int j = 1; j <= m; j++) if (p[j]) col[p[j]] = j;
+}
+
+bool plannerAssign(IPAddress ip, uint32_t id, uint32_t nowUnix, PassInfo& out, bool& reserved) {
+  reserved = false;
+  // passes over, and passes someone already holds (a rescan re-queues them)
+  for (int i = 0; i < PLAN_MAX_HELD; i++) {
+    if (sHeld[i].id && sHeld[i].pass.losUnix < nowUnix) sHeld[i].id = 0;
+  }
+  int jobs = 0;
+  {
+    static PassInfo queued[PASS_QUEUE_MAX];
+    int n = schedulerPending(nowUnix, queued, PASS_QUEUE_MAX);
+    for (int i = 0; i < n; i++) if (!isHeld(queued[i].norad)) sJobs[jobs++] = queued[i];
+  }
+  if (jobs == 0) return false;
+
+  // workers: the requester (row 1) and every other connected module
+  IPAddress workers[PLAN_MAX_WORKERS];
+  int n = 1;
+  workers[0] = ip;
+  IPAddress peers[PLAN_MAX_WORKERS];
+  int np = linkPeers(peers, PLAN_MAX_WORKERS);
+  for (int k = 0; k < np && n < PLAN_MAX_WORKERS; k++) if (peers[k] != ip) workers[n++] = peers[k];
+
+  // columns: the jobs, then one zero-score "nothing" per worker so everyone can stay unmatched
+  int m = jobs + n;
+  for (int r = 0; r < n; r++) {
+    uint32_t free = freeAt(workers[r], nowUnix);
+    for (int j = 0; j < jobs; j++) sCost[r + 1][j + 1] = -max(score(sJobs[j], workers[r], free), 0.0f);
+    for (int j = jobs; j < m; j++) sCost[r + 1][j + 1] = 0;
+  }
+  int col[MAX_ROWS + 1];
+  hungarian(n, m, col);
+
+  int pick = col[1] - 1;
+  if (pick >= jobs || sCost[1][col[1]] >= 0) {
+    for (int j = 1; j <= jobs && !reserved; j++) reserved = sCost[1][j] < 0;
+    return false;
+  }
+
+  int slot = -1;
+  for (int i = 0; i < PLAN_MAX_HELD && slot < 0; i++) if (!sHeld[i].id) slot = i;
+  if (slot < 0) return false;
+  sHeld[slot].startUnix = later(sJobs[pick].aosUnix, freeAt(ip, nowUnix));
+  sHeld[slot].id = id;
+  sHeld[slot].ip = ip;
+  sHeld[slot].pass = sJobs[pick];
+  schedulerTake(sJobs[pick].satIdx);
+  out = sJobs[pick];
+  return true;
+}
+
+void plannerRelease(uint32_t id) {
+  for (int i = 0; i < PLAN_MAX_HELD; i++) if (sHeld[i].id == id) sHeld[i].id = 0;
+}
+
+void plannerDropModule(IPAddress ip) {
+  for (int i = 0; i < PLAN_MAX_HELD; i++) if (sHeld[i].id && sHeld[i].ip == ip) sHeld[i].id = 0;
+}
+
+int plannerHeld() {
+  int n = 0;
+  for (int i = 0; i < PLAN_MAX_HELD; i++) if (sHeld[i].id) n++;
+  return n;
+}
+
+void plannerWriteJson(JsonWriter& j, uint32_t nowUnix) {
+  uint32_t laser = 0;
+  float minSep = 180.0f;
+  j.beginObject().key("held").beginArray();
+  for (int i = 0; i < PLAN_MAX_HELD; i++) {
+    const Held& h = sHeld[i];
+    if (!h.id || h.pass.losUnix < nowUnix) continue;
+    laser += h.pass.losUnix - later(h.startUnix, nowUnix);
+    for (int k = i + 1; k < PLAN_MAX_HELD; k++) {
+      const Held& o = sHeld[k];
+      if (!o.id || o.ip == h.ip || o.pass.losUnix < nowUnix) continue;
+      if (earlier(h.pass.losUnix, o.pass.losUnix) > later(h.startUnix, o.startUnix))
+        minSep = min(minSep, skySeparation(h.pass, o.pass));
+    }
+    j.beginObject()
+     .field("id", (unsigned long)h.id)
+     .field("ip", h.ip)
+     .field("norad", (unsigned long)h.pass.norad)
+     .field("aos", (long)h.pass.aosUnix - (long)nowUnix)
+     .field("start", (long)h.startUnix - (long)nowUnix)
+     .field("los", (long)h.pass.losUnix - (long)nowUnix)
+     .field("maxEl", h.pass.maxElDeg, 1)
+     .field("tcaAz", h.pass.tcaAzDeg, 1)
+     .endObject();
+  }
+  j.endArray()
+   .field("laserSecs", (unsigned long)laser)
+   .field("minConcurrentSepDeg", minSep, 1)
+   .endObject();
+}
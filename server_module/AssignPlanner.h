@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include "PassScheduler.h"
+
+// Hands predicted passes (jobs) to client modules (workers) for the whole installation.
+// Every request re-solves the matching between all connected modules and the queued passes
+// (Hungarian method on a score matrix) and gives the requester its own match, so a pass that
+// suits another module better is left for that module. A module is free again at the LOS
+// of the last pass it holds, which chains its queue without overlaps.
+//
+// Score of a pass for a module (seconds): time the laser can be on target, plus a small
+// bonus for high passes, minus idle time before AOS, minus a penalty for sharing a sky
+// region with a pass another module holds at the same time. A module holds a pass until
+// LOS, DONE, a rejected push or its link closing.
+
+#define PLAN_MAX_WORKERS   12       // = LINK_MAX_CLIENTS
+#define PLAN_MAX_HELD      48       // passes held over all modules (queued + being tracked)
+#define PLAN_IDLE_WEIGHT   0.5f     // score lost per second a module waits for AOS
+#define PLAN_EL_WEIGHT_S   1.0f     // bonus per degree of max elevation
+#define PLAN_SEP_MIN_DEG   30.0f    // culminations closer than this to a concurrent pass...
+#define PLAN_SEP_WEIGHT    1.0f     // ...cost this per overlapping second (scaled by closeness)
+
+// Picks the pass for module 'ip'; 'id' is the assignment id it will be pushed under.
+// False if no queued pass is worth giving it; 'reserved' then says whether that is because
+// the worthwhile ones are better used by other modules (ask again later rather than fall back).
+bool plannerAssign(IPAddress ip, uint32_t id, uint32_t nowUnix, PassInfo& out, bool& reserved);
+void plannerRelease(uint32_t id);          // DONE or rejected
+void plannerDropModule(IPAddress ip);      // link closed or module restarted
+int  plannerHeld();                         // passes held over all modules
+
+class JsonWriter;
+void plannerWriteJson(JsonWriter& j, uint32_t nowUnix);   // held passes and planned laser time
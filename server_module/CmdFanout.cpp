@@ -0,0 +1,100 @@
+#include "CmdFanout.h"
+#include "NetProto.h"
+#include <WiFiUdp.h>
+
+// One send: the packet for retransmits and the per-module state (slot = seq % FANOUT_SLOTS)
+struct FanoutSlot {
+  uint32_t     seq = 0;
+  uint8_t      pkt[sizeof(NetCmdHeader) + NET_CMD_MAX_TEXT];
+  size_t       pktLen = 0;
+  FanoutResult res[FANOUT_MAX_TARGETS];
+  int          n = 0, acked = 0;
+  uint32_t     t0 = 0, interval = 0, nextRetry = 0;
+  bool         done = true;
+};
+
+static WiFiUDP    sUdp;
+static uint16_t   sPort = 0;
+static IPAddress  sBroadcast;
+static uint32_t   sEpoch = 0;
+static uint32_t   sSeq = 0;
+static FanoutSlot sSlots[FANOUT_SLOTS];
+
+void fanoutBegin(uint16_t cmdPort, IPAddress broadcast) {
+  sPort = cmdPort;
+  sBroadcast = broadcast;
+  sEpoch = esp_random() | 1;
+  sUdp.begin(0);   // ephemeral port: clients ack to the sender's address
+}
+
+static void transmit(IPAddress ip, const uint8_t* pkt, size_t len) {
+  sUdp.beginPacket(ip, sPort);
+  sUdp.write(pkt, len);
+  sUdp.endPacket();
+}
+
+// Reads every pending ack and credits it to the send it belongs to
+static void collectAcks() {
+  while (sUdp.parsePacket() > 0) {
+    NetCmdHeader h;
+    if (sUdp.read((uint8_t*)&h, sizeof(h)) != (int)sizeof(h)) continue;
+    if (h.magic != NET_CMD_MAGIC || h.type != NET_CMD_ACK || h.epoch != sEpoch) continue;  // foreign
+    FanoutSlot& s = sSlots[h.seq % FANOUT_SLOTS];
+    if (s.seq != h.seq || s.done) continue;   // late ack of a finished or replaced send
+    IPAddress from = sUdp.remoteIP();
+    for (int i = 0; i < s.n; i++) {
+      if (s.res[i].ip == from && !s.res[i].acked) {
+        s.res[i].acked = true;
+        s.res[i].latencyUs = micros() - s.t0;
+        s.acked++;
+      }
+    }
+  }
+}
+
+uint32_t fanoutSend(const char* text, const IPAddress* ips, int n, bool broadcast) {
+  if (++sSeq == 0) sSeq = 1;
+  FanoutSlot& s = sSlots[sSeq % FANOUT_SLOTS];   // the oldest: done, or abandoned if still running
+  size_t len = strnlen(text, NET_CMD_MAX_TEXT);
+  NetCmdHeader h = { NET_CMD_MAGIC, NET_CMD_EXEC, NET_CMD_VERSION, (uint16_t)len, sEpoch, sSeq };
+  memcpy(s.pkt, &h, sizeof(h));
+  memcpy(s.pkt + sizeof(h), text, len);
+  s.pktLen = sizeof(h) + len;
+  s.seq = sSeq;
+
+  s.n = min(n, FANOUT_MAX_TARGETS);
+  s.acked = 0;
+  for (int i = 0; i < s.n; i++) { s.res[i].ip = ips[i]; s.res[i].acked = false; s.res[i].tries = 1; s.res[i].latencyUs = 0; }
+
+  s.t0 = micros();
+  if (broadcast) transmit(sBroadcast, s.pkt, s.pktLen);
+  else for (int i = 0; i < s.n; i++) transmit(s.res[i].ip, s.pkt, s.pktLen);
+  s.interval = s.nextRetry = FANOUT_RETRY_MS * 1000UL;
+  s.done = s.n == 0;
+  return s.seq;
+}
+
+void fanoutLoop() {
+  collectAcks();
+  for (FanoutSlot& s : sSlots) {
+    if (s.done) continue;
+    uint32_t elapsed = micros() - s.t0;
+    if (s.acked >= s.n || elapsed >= FANOUT_TIMEOUT_MS * 1000UL) { s.done = true; continue; }
+    if (elapsed < s.nextRetry) continue;
+    for (int i = 0; i < s.n; i++) {   // selective: only the modules still missing
+      if (s.res[i].acked) continue;
+      transmit(s.res[i].ip, s.pkt, s.pktLen);
+      s.res[i].tries++;
+    }
+    s.interval *= 2;
+    s.nextRetry = elapsed + s.interval;
+  }
+}
+
+int fanoutResult(uint32_t id, FanoutResult* res, int maxN, bool& done) {
+  const FanoutSlot& s = sSlots[id % FANOUT_SLOTS];
+  if (id == 0 || s.seq != id) return -1;
+  for (int i = 0; i < min(s.n, maxN); i++) res[i] = s.res[i];
+  done = s.done;
+  return s.n;
+}
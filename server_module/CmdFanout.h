@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+// Sequence-numbered command delivery to client modules over UDP (see NetProto.h).
+// fanoutSend() transmits once (broadcast for ALL) and returns; fanoutLoop() collects acks
+// and retransmits by unicast to the modules that have not acked, with a doubling interval,
+// until everyone confirmed or FANOUT_TIMEOUT_MS passed. The last FANOUT_SLOTS sends are
+// kept for fanoutResult(). Not thread-safe: the callers serialize (server state lock).
+
+#define FANOUT_RETRY_MS     30      // first retransmit; doubles each round
+#define FANOUT_TIMEOUT_MS   600     // give up on modules that have not acked by then
+#define FANOUT_MAX_TARGETS  16
+#define FANOUT_SLOTS        8       // sends in flight or kept for polling; a new one reuses the oldest
+
+struct FanoutResult {
+  IPAddress ip;
+  bool      acked;
+  uint8_t   tries;        // datagrams sent to this module (the broadcast counts once)
+  uint32_t  latencyUs;    // first transmit -> ack
+};
+
+void fanoutBegin(uint16_t cmdPort, IPAddress broadcast);
+
+// Queues text for ips[0..n-1] and sends the first copy. broadcast: it goes to the subnet
+// broadcast address instead of one unicast per target. Returns the send's id (never 0).
+uint32_t fanoutSend(const char* text, const IPAddress* ips, int n, bool broadcast);
+void     fanoutLoop();   // acks and retransmits for every send in flight
+
+// State of send id: per-module results into res (up to maxN) and whether it is over
+// (all acked or timed out). Returns its target count, -1 once the slot was reused.
+int fanoutResult(uint32_t id, FanoutResult* res, int maxN, bool& done);
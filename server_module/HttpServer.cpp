@@ -0,0 +1,280 @@
+#include "HttpServer.h"
+#include <WiFi.h>
+
+struct HttpConn {
+  WiFiClient sock;
+  bool     used = false;
+  char     rx[HTTP_MAX_REQUEST + 1];   // +1 for the terminator used while parsing
+  size_t   rxLen = 0;
+  char     head[HTTP_HEAD_BUF];        // serialized status line + headers being sent
+  size_t   headLen = 0, headPos = 0;
+  char     body[HTTP_BODY_BUF];        // response body written by the handler
+  const uint8_t* txBody = nullptr;     // body, or a flash asset
+  char*    txHeap = nullptr;           // heap block of a large body, freed once sent
+  size_t   txLen = 0, txPos = 0;
+  bool     closeAfter = false;
+  uint16_t served = 0;
+  uint32_t lastActiveMs = 0;
+};
+
+static WiFiServer* sServer = nullptr;
+static HttpHandler sHandler = nullptr;
+static HttpConn    sConns[HTTP_MAX_CONN];
+
+static const char* reasonPhrase(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 413: return "Payload Too Large";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "Error";
+  }
+}
+
+// ===== Request =====
+
+bool HttpRequest::header(const char* name, char* out, size_t outSize) const {
+  size_t nameLen = strlen(name);
+  const char* end = head + headLen;
+  const char* p = (const char*)memchr(head, '\n', headLen);   // skip the request line
+  while (p && p < end) {
+    p++;
+    const char* eol = (const char*)memchr(p, '\n', end - p);
+    const char* lineEnd = eol ? eol : end;
+    if ((size_t)(lineEnd - p) > nameLen && p[nameLen] == ':' && strncasecmp(p, name, nameLen) == 0) {
+      const char* v = p + nameLen + 1;
+      while (v < lineEnd && (*v == ' ' || *v == '\t')) v++;
+      const char* ve = lineEnd;
+      while (ve > v && (ve[-1] == '\r' || ve[-1] == ' ' || ve[-1] == '\t')) ve--;
+      size_t n = min((size_t)(ve - v), outSize - 1);
+      memcpy(out, v, n);
+      out[n] = 0;
+      return true;
+    }
+    p = eol;
+  }
+  return false;
+}
+
+// ===== Response =====
+
+void HttpResponse::addHeader(const char* name, const char* value) {
+  int n = snprintf(_extra + _extraLen, sizeof(_extra) - _extraLen, "%s: %s\r\n", name, value);
+  if (n > 0 && _extraLen + n < sizeof(_extra)) _extraLen += n;
+  else _extra[_extraLen] = 0;   // does not fit: drop it rather than send half a line
+}
+
+size_t HttpResponse::formatHead(char* out, size_t cap, long contentLength) const {
+  int n = snprintf(out, cap, "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %ld\r\n",
+                   status, reasonPhrase(status), contentType, contentLength);
+  n += snprintf(out + n, cap - n, "Connection: %s\r\n%.*s\r\n", _keepAlive ? "keep-alive" : "close", (int)_extraLen, _extra);
+  return min((size_t)n, cap - 1);
+}
+
+// Body outgrew its buffer: continue in a heap block, doubling up to HTTP_MAX_BODY
+bool HttpResponse::grow(size_t need) {
+  if (need > HTTP_MAX_BODY) return false;
+  size_t cap = _cap;
+  while (cap < need) cap *= 2;
+  cap = min(cap, (size_t)HTTP_MAX_BODY);
+  char* p = (char*)(_heap ? realloc(_heap, cap) : malloc(cap));
+  if (!p) return false;
+  if (!_heap) memcpy(p, _buf, _len);
+  _heap = _buf = p;
+  _cap = cap;
+  return true;
+}
+
+size_t HttpResponse::write(const uint8_t* p, size_t n) {
+  if (_static || _tooLarge) return n;
+  if (_len + n > _cap && !grow(_len + n)) { _tooLarge = true; return n; }
+  memcpy(_buf + _len, p, n);
+  _len += n;
+  return n;
+}
+
+size_t HttpResponse::finish(char* head, size_t headCap, const uint8_t*& body, size_t& bodyLen, bool& closeAfter) {
+  if (_tooLarge) {   // half a body is worse than none
+    free(_heap);
+    _heap = nullptr;
+    _buf = _connBuf; _cap = _connCap;
+    status = 500;
+    contentType = "text/plain";
+    _len = snprintf(_buf, _cap, "Response too large");
+  }
+  body = _static ? _static : (const uint8_t*)_buf;
+  bodyLen = (status == 304) ? 0 : _len;
+  closeAfter = !_keepAlive;
+  return formatHead(head, headCap, (long)bodyLen);
+}
+
+// ===== Connections =====
+
+static void txDone(HttpConn& c) {
+  c.headLen = c.headPos = 0;
+  c.txLen = c.txPos = 0;
+  free(c.txHeap);
+  c.txHeap = nullptr;
+}
+
+static void closeConn(HttpConn& c) {
+  c.sock.stop();
+  c.used = false;
+  c.rxLen = 0;
+  txDone(c);
+}
+
+static bool txPending(const HttpConn& c) {
+  return c.headPos < c.headLen || c.txPos < c.txLen;
+}
+
+static void respond(HttpConn& c, HttpResponse& res) {
+  c.headLen = res.finish(c.head, sizeof(c.head), c.txBody, c.txLen, c.closeAfter);
+  c.txHeap = res.takeHeap();
+  c.headPos = 0;
+  c.txPos = 0;
+}
+
+static void sendError(HttpConn& c, int code) {
+  HttpResponse res(c.body, sizeof(c.body), false);
+  res.status = code;
+  res.print(reasonPhrase(code));
+  respond(c, res);
+  c.rxLen = 0;
+}
+
+// Parse one complete request from c.rx if there is one; returns the bytes it spans
+// (0 = need more bytes). req points into c.rx, so consume only after handling it.
+static size_t tryParse(HttpConn& c, HttpRequest& req) {
+  c.rx[c.rxLen] = 0;
+  const char* end = strstr(c.rx, "\r\n\r\n");
+  if (!end) {
+    if (c.rxLen >= HTTP_MAX_REQUEST) sendError(c, 413);
+    return 0;
+  }
+  req.head = c.rx;
+  req.headLen = end - c.rx;
+
+  char v[16];
+  long bodyLen = req.header("Content-Length", v, sizeof(v)) ? atol(v) : 0;
+  size_t total = req.headLen + 4 + (size_t)bodyLen;
+  if (bodyLen < 0 || total > HTTP_MAX_REQUEST) { sendError(c, 413); return 0; }
+  if (c.rxLen < total) return 0;
+
+  const char* eol = strstr(c.rx, "\r\n");
+  req.line.concat(c.rx, eol - c.rx);
+  req.body.concat(end + 4, bodyLen);
+
+  int sp1 = req.line.indexOf(' ');
+  int sp2 = req.line.indexOf(' ', sp1 + 1);
+  if (sp1 <= 0 || sp2 <= sp1) { sendError(c, 400); return 0; }
+  req.method = req.line.substring(0, sp1);
+  String target = req.line.substring(sp1 + 1, sp2);
+  int q = target.indexOf('?');
+  req.path  = (q < 0) ? target : target.substring(0, q);
+  req.query = (q < 0) ? String() : target.substring(q + 1);
+
+  bool hasConn = req.header("Connection", v, sizeof(v));
+  req.http10 = req.line.endsWith("HTTP/1.0");
+  req.keepAlive = req.http10 ? (hasConn && strcasecmp(v, "keep-alive") == 0)
+                             : !(hasConn && strcasecmp(v, "close") == 0);
+  return total;
+}
+
+// One pass over a connection: flush pending output, then read and dispatch
+static bool serviceConn(HttpConn& c) {
+  bool busy = false;
+
+  if (txPending(c)) {
+    const uint8_t* p;
+    size_t n;
+    if (c.headPos < c.headLen) { p = (const uint8_t*)c.head + c.headPos; n = c.headLen - c.headPos; }
+    else                       { p = c.txBody + c.txPos;                 n = c.txLen - c.txPos; }
+    size_t w = c.sock.write(p, min((size_t)HTTP_TX_CHUNK, n));
+    if (w == 0) { closeConn(c); return true; }
+    if (c.headPos < c.headLen) c.headPos += w; else c.txPos += w;
+    c.lastActiveMs = millis();
+    if (txPending(c)) return true;
+    txDone(c);
+    if (c.closeAfter) { closeConn(c); return true; }
+    busy = true;
+  }
+
+  int avail = c.sock.available();
+  size_t space = HTTP_MAX_REQUEST - c.rxLen;
+  if (avail > 0 && space > 0) {
+    int n = c.sock.read((uint8_t*)c.rx + c.rxLen, min((size_t)avail, space));
+    if (n > 0) { c.rxLen += n; c.lastActiveMs = millis(); busy = true; }
+  }
+
+  if (!txPending(c)) {
+    HttpRequest req;
+    size_t used = tryParse(c, req);
+    if (used) {
+      c.served++;
+      HttpResponse res(c.body, sizeof(c.body), req.keepAlive && c.served < HTTP_MAX_KEEPALIVE);
+      sHandler(req, res);
+      respond(c, res);
+      memmove(c.rx, c.rx + used, c.rxLen - used);   // keep pipelined bytes
+      c.rxLen -= used;
+      busy = true;
+    }
+  }
+
+  if (!busy) {
+    if (!c.sock.connected() && c.sock.available() <= 0) { closeConn(c); return false; }
+    if (millis() - c.lastActiveMs > HTTP_IDLE_TIMEOUT_MS) closeConn(c);
+  }
+  return busy;
+}
+
+// Between requests: nothing received, nothing left to send
+static bool idle(const HttpConn& c) {
+  return c.rxLen == 0 && !txPending(c);
+}
+
+static void httpTask(void*) {
+  for (;;) {
+    bool busy = false;
+
+    while (sServer->hasClient()) {
+      int slot = -1;
+      for (int i = 0; i < HTTP_MAX_CONN; i++) if (!sConns[i].used) { slot = i; break; }
+      if (slot < 0) {   // full: reuse the longest idle keep-alive connection with nothing pending
+        for (int i = 0; i < HTTP_MAX_CONN; i++) {
+          if (!idle(sConns[i])) continue;
+          if (slot < 0 || sConns[i].lastActiveMs < sConns[slot].lastActiveMs) slot = i;
+        }
+        if (slot < 0) break;   // all mid-request: the new socket waits in the backlog
+        closeConn(sConns[slot]);
+      }
+      HttpConn& c = sConns[slot];
+      c.sock = sServer->accept();
+      c.sock.setNoDelay(true);
+      c.used = true;
+      c.served = 0;
+      c.rxLen = 0;
+      txDone(c);
+      c.closeAfter = false;
+      c.lastActiveMs = millis();
+      busy = true;
+    }
+
+    for (int i = 0; i < HTTP_MAX_CONN; i++) {
+      if (sConns[i].used && serviceConn(sConns[i])) busy = true;
+    }
+
+    vTaskDelay(busy ? 1 : 5);
+  }
+}
+
+void httpBegin(uint16_t port, HttpHandler handler) {
+  sHandler = handler;
+  sServer = new WiFiServer(port, HTTP_MAX_CONN);
+  sServer->begin();
+  sServer->setNoDelay(true);
+  xTaskCreatePinnedToCore(httpTask, "http", HTTP_TASK_STACK, nullptr, HTTP_TASK_PRIO, nullptr, HTTP_TASK_CORE);
+}
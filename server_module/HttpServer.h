@@ -0,0 +1,84 @@
+#pragma once
+#include <Arduino.h>
+
+// Small event-driven HTTP/1.1 server running on its own FreeRTOS task.
+// Multiplexes up to HTTP_MAX_CONN sockets, parses requests incrementally and keeps
+// connections alive; each complete request is handed to one handler function.
+// The handler writes its response into the connection's HTTP_BODY_BUF-sized buffer;
+// larger bodies continue in a heap block (up to HTTP_MAX_BODY). Flash assets (sendStatic)
+// are sent straight from flash without a copy. The handler never touches the socket:
+// everything goes out from the event loop without blocking, so a slow client holds up
+// neither the handler (nor any lock it takes) nor the other connections.
+
+#define HTTP_MAX_CONN        4
+#define HTTP_MAX_REQUEST     2048    // request line + headers + body
+#define HTTP_BODY_BUF        2048    // response body buffered per connection
+#define HTTP_MAX_BODY        16384   // larger bodies (heap) fail with 500
+#define HTTP_HEAD_BUF        384     // status line + response headers
+#define HTTP_EXTRA_HEADERS   192     // headers added by the handler (addHeader)
+#define HTTP_IDLE_TIMEOUT_MS 5000    // close idle keep-alive connections
+#define HTTP_MAX_KEEPALIVE   100     // requests per connection
+#define HTTP_TX_CHUNK        1436    // bytes written per connection per pass (interleaves sockets)
+#define HTTP_TASK_CORE       0
+#define HTTP_TASK_PRIO       1
+#define HTTP_TASK_STACK      8192
+
+struct HttpRequest {
+  String method;     // "GET"
+  String path;       // "/goto"
+  String query;      // "index=3" (without '?')
+  String line;       // full request line, e.g. "GET /goto?index=3 HTTP/1.1"
+  String body;
+  bool   keepAlive = true;
+  bool   http10 = false;
+  const char* head = nullptr;   // raw header block (valid while the handler runs)
+  size_t      headLen = 0;
+
+  // Copy of header `name` (case-insensitive) into out; false if absent
+  bool header(const char* name, char* out, size_t outSize) const;
+};
+
+class HttpResponse : public Print {
+public:
+  int         status = 200;
+  const char* contentType = "text/plain";
+
+  // buf/cap: the connection's body buffer
+  HttpResponse(char* buf, size_t cap, bool keepAlive)
+    : _buf(buf), _cap(cap), _connBuf(buf), _connCap(cap), _keepAlive(keepAlive) {}
+  ~HttpResponse() { free(_heap); }
+
+  void addHeader(const char* name, const char* value);
+  // Body from flash (e.g. a PROGMEM asset); replaces anything printed so far
+  void sendStatic(const uint8_t* data, size_t len) { _static = data; _len = len; }
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* p, size_t n) override;
+  using Print::write;
+
+  // Called by the server after the handler: formats the header block into head and
+  // returns its length plus the body to send
+  size_t finish(char* head, size_t headCap, const uint8_t*& body, size_t& bodyLen, bool& closeAfter);
+  // The heap block the body lives in (nullptr if none); the caller frees it once sent
+  char*  takeHeap() { char* p = _heap; _heap = nullptr; return p; }
+
+private:
+  char*          _buf;
+  size_t         _cap;
+  size_t         _len = 0;
+  char*          _connBuf;
+  size_t         _connCap;
+  char*          _heap = nullptr;      // _buf once the body outgrew the connection buffer
+  bool           _keepAlive;
+  bool           _tooLarge = false;    // over HTTP_MAX_BODY or out of heap: answered with 500
+  const uint8_t* _static = nullptr;
+  char           _extra[HTTP_EXTRA_HEADERS];
+  size_t         _extraLen = 0;
+
+  size_t formatHead(char* out, size_t cap, long contentLength) const;
+  bool   grow(size_t need);
+};
+
+typedef void (*HttpHandler)(const HttpRequest& req, HttpResponse& res);
+
+void httpBegin(uint16_t port, HttpHandler handler);   // starts the server task
@@ -0,0 +1,102 @@
+#pragma once
+#include <Arduino.h>
+
+// Streaming JSON writer: serializes straight into any Print (an HttpResponse, Serial, ...)
+// without building the document in memory. Commas and string escaping are handled here,
+// callers only describe the structure:
+//
+//   JsonWriter j(res);
+//   j.beginArray();
+//   j.beginObject().field("idx", 1).field("name", "sat_data_1.json").endObject();
+//   j.endArray();
+
+#define JSON_MAX_DEPTH 8
+
+class JsonWriter {
+public:
+  explicit JsonWriter(Print& out) : _out(out) {}
+
+  JsonWriter& beginObject() { open('{'); return *this; }
+  JsonWriter& endObject()   { close('}'); return *this; }
+  JsonWriter& beginArray()  { open('['); return *this; }
+  JsonWriter& endArray()    { close(']'); return *this; }
+
+  JsonWriter& key(const char* k) {
+    separate();
+    str(k);
+    _out.write(':');
+    _afterKey = true;
+    return *this;
+  }
+
+  JsonWriter& value(const char* s)   { separate(); if (s) str(s); else _out.print("null"); return *this; }
+  JsonWriter& value(const String& s) { return value(s.c_str()); }
+  JsonWriter& value(bool b)          { separate(); _out.print(b ? "true" : "false"); return *this; }
+  JsonWriter& value(int v)           { separate(); _out.print(v); return *this; }
+  JsonWriter& value(long v)          { separate(); _out.print(v); return *this; }
+  JsonWriter& value(unsigned v)      { separate(); _out.print(v); return *this; }
+  JsonWriter& value(unsigned long v) { separate(); _out.print(v); return *this; }
+  JsonWriter& value(double v, int digits = 3) {
+    separate();
+    if (isnan(v) || isinf(v)) _out.print("null");
+    else _out.print(v, digits);
+    return *this;
+  }
+  JsonWriter& value(const IPAddress& ip) {
+    separate();
+    _out.printf("\"%u.%u.%u.%u\"", ip[0], ip[1], ip[2], ip[3]);
+    return *this;
+  }
+
+  template <typename T>
+  JsonWriter& field(const char* k, const T& v) { key(k); return value(v); }
+  JsonWriter& field(const char* k, double v, int digits) { key(k); return value(v, digits); }
+
+private:
+  Print&  _out;
+  uint8_t _depth = 0;
+  bool    _hasItem[JSON_MAX_DEPTH] = {};
+  bool    _afterKey = false;
+
+  // comma before every item except the first one in its container (and never after a key)
+  void separate() {
+    if (_afterKey) { _afterKey = false; return; }
+    if (_depth > 0 && _depth <= JSON_MAX_DEPTH) {
+      if (_hasItem[_depth-1]) _out.write(',');
+      _hasItem[_depth-1] = true;
+    }
+  }
+
+  void open(char c) {
+    separate();
+    _out.write(c);
+    if (_depth < JSON_MAX_DEPTH) _hasItem[_depth] = false;
+    _depth++;
+  }
+
+  void close(char c) {
+    _out.write(c);
+    if (_depth > 0) _depth--;
+  }
+
+  void str(const char* s) {
+    _out.write('"');
+    const char* run = s;   // unescaped bytes are written in runs, not one by one
+    for (; *s; s++) {
+      unsigned char ch = (unsigned char)*s;
+      if (ch >= 0x20 && ch != '"' && ch != '\\') continue;
+      if (s > run) _out.write((const uint8_t*)run, s - run);
+      run = s + 1;
+      switch (ch) {
+        case '"':  _out.print("\\\""); break;
+        case '\\': _out.print("\\\\"); break;
+        case '\n': _out.print("\\n");  break;
+        case '\r': _out.print("\\r");  break;
+        case '\t': _out.print("\\t");  break;
+        default:   _out.printf("\\u%04x", ch); break;
+      }
+    }
+    if (s > run) _out.write((const uint8_t*)run, s - run);
+    _out.write('"');
+  }
+};
@@ -0,0 +1,103 @@
+#include "Metrics.h"
+#include "JsonWriter.h"
+
+static inline int bucketOf(uint32_t v) {
+  if (v < 4) return (int)v;
+  int o = 31 - __builtin_clz(v);                 // octave, >= 2
+  if (o > 23) return METRIC_BUCKETS - 1;
+  return 4 + (o - 2) * 4 + (int)((v >> (o - 2)) & 3);
+}
+
+uint32_t metricBucketFloor(int i) {
+  if (i < 4) return (uint32_t)i;
+  int o = (i - 4) / 4 + 2;
+  return (uint32_t)(4 | ((i - 4) % 4)) << (o - 2);
+}
+
+void MetricHist::add(uint32_t v) {
+  bucket[bucketOf(v)]++;
+  count++;
+  sum += v;
+  if (v > max) max = v;
+}
+
+uint32_t MetricHist::percentile(float p) const {
+  if (count == 0) return 0;
+  uint32_t want = (uint32_t)ceilf(p * count);
+  if (want == 0) want = 1;
+  uint32_t seen = 0;
+  for (int i = 0; i < METRIC_BUCKETS - 1; i++) {
+    seen += bucket[i];
+    if (seen >= want) return min(metricBucketFloor(i + 1) - 1, max);
+  }
+  return max;
+}
+
+void MetricHist::reset() {
+  count = max = 0;
+  sum = 0;
+  memset(bucket, 0, sizeof(bucket));
+}
+
+static MetricHist sHist[MET_COUNT] = {
+  { "loop_us" }, { "sched_us" }, { "findsat_us" }, { "assign_us" }, { "http_us" },
+};
+
+void metricAdd(MetricId id, uint32_t v) { sHist[id].add(v); }
+const MetricHist& metricGet(MetricId id) { return sHist[id]; }
+
+int metricsParseSummary(const char* text, MetricSummary* out, int maxOut) {
+  int n = 0;
+  while (text && *text && n < maxOut) {
+    while (*text == ' ') text++;
+    const char* eq = strchr(text, '=');
+    const char* end = strchr(text, ' ');
+    if (!end) end = text + strlen(text);
+    if (!eq || eq > end) { text = end; continue; }
+
+    MetricSummary& m = out[n];
+    size_t len = min((size_t)(eq - text), sizeof(m.name) - 1);
+    memcpy(m.name, text, len); m.name[len] = 0;
+    unsigned long v[5];
+    if (sscanf(eq + 1, "%lu/%lu/%lu/%lu/%lu", &v[0], &v[1], &v[2], &v[3], &v[4]) == 5) {
+      m.count = v[0]; m.p50 = v[1]; m.p90 = v[2]; m.p99 = v[3]; m.max = v[4];
+      n++;
+    }
+    text = end;
+  }
+  return n;
+}
+
+void metricsWriteJson(JsonWriter& j) {
+  j.beginObject();
+  for (const MetricHist& h : sHist) {
+    j.key(h.name);
+    j.beginObject()
+     .field("count", (unsigned long)h.count)
+     .field("mean", h.count ? (double)h.sum / h.count : 0.0, 1)
+     .field("p50", (unsigned long)h.percentile(0.5f))
+     .field("p90", (unsigned long)h.percentile(0.9f))
+     .field("p99", (unsigned long)h.percentile(0.99f))
+     .field("max", (unsigned long)h.max)
+     .endObject();
+  }
+  j.endObject();
+}
+
+// Cumulative counts at each octave edge (le = 2^k - 1 matches the bucket boundaries)
+void metricsWritePrometheus(Print& out) {
+  for (const MetricHist& h : sHist) {
+    out.printf("# TYPE wos_server_%s histogram\n", h.name);
+    uint32_t cum = 0;
+    for (int i = 0; i < METRIC_BUCKETS; i++) {
+      cum += h.bucket[i];
+      if (i >= 4 && (i - 4) % 4 != 3) continue;   // one line per octave
+      if (i == METRIC_BUCKETS - 1) break;
+      out.printf("wos_server_%s_bucket{le=\"%lu\"} %lu\n", h.name,
+                 (unsigned long)(metricBucketFloor(i + 1) - 1), (unsigned long)cum);
+    }
+    out.printf("wos_server_%s_bucket{le=\"+Inf\"} %lu\n", h.name, (unsigned long)h.count);
+    out.printf("wos_server_%s_sum %llu\n", h.name, (unsigned long long)h.sum);
+    out.printf("wos_server_%s_count %lu\n", h.name, (unsigned long)h.count);
+  }
+}
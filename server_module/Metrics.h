@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+
+// Runtime metrics: fixed-bucket histograms (no allocation, constant-time add) fed from
+// cycle-counter timers in the hot paths. Buckets are log-linear, four per octave (about
+// ±12%), for values up to 2^24 in each metric's own unit. The histogram part matches
+// client_module/Metrics.h; modules report their summaries on the registrar PING.
+
+#define METRIC_BUCKETS   (4 + 22 * 4)   // 0..3 exact, then 4 buckets per octave up to 2^24
+
+struct MetricHist {
+  const char* name;                     // "<what>_<unit>", e.g. "loop_us"
+  uint32_t count, max;
+  uint64_t sum;
+  uint32_t bucket[METRIC_BUCKETS];
+
+  void     add(uint32_t v);
+  uint32_t percentile(float p) const;   // upper edge of the bucket holding quantile p, capped at max
+  void     reset();
+};
+
+uint32_t metricBucketFloor(int i);      // smallest value counted in bucket i
+
+// Elapsed time from the CPU cycle counter (wraps after ~17 s at 240 MHz)
+struct CycleTimer {
+  uint32_t t0 = ESP.getCycleCount();
+  uint32_t us() const { return (ESP.getCycleCount() - t0) / ESP.getCpuFreqMHz(); }
+};
+
+enum MetricId {
+  MET_LOOP_US,      // loop()
+  MET_SCHED_US,     // one schedulerLoop() slice
+  MET_FINDSAT_US,   // one Sgp4::findsat in the pass sweep
+  MET_ASSIGN_US,    // nextAssignment()
+  MET_HTTP_US,      // one HTTP handler call (HTTP task)
+  MET_COUNT
+};
+
+void metricAdd(MetricId id, uint32_t v);
+const MetricHist& metricGet(MetricId id);
+
+// Adds the elapsed time to a metric when the scope ends (covers every return path)
+struct MetricScope {
+  MetricId   id;
+  CycleTimer t;
+  explicit MetricScope(MetricId m) : id(m) {}
+  ~MetricScope() { metricAdd(id, t.us()); }
+};
+
+// One module histogram as summarised in its PING: "name=count/p50/p90/p99/max"
+#define METRIC_CLIENT_MAX 8
+struct MetricSummary {
+  char     name[16];
+  uint32_t count, p50, p90, p99, max;
+};
+// Parses the space-separated summaries that follow "PING <name>"; returns how many
+int metricsParseSummary(const char* text, MetricSummary* out, int maxOut);
+
+class JsonWriter;
+void metricsWriteJson(JsonWriter& j);           // {"loop_us":{count,mean,p50,p90,p99,max},...}
+void metricsWritePrometheus(Print& out);        // server histograms as Prometheus histograms
@@ -0,0 +1,171 @@
+#include "ModuleLink.h"
+#include "NetProto.h"
+#include "AssignPlanner.h"
+#include <WiFi.h>
+
+// Resolve references defined in the .ino:
+extern bool nextAssignment(IPAddress ip, NetAssign& out);
+extern void upsertClient(IPAddress ip, const String& name);
+
+struct Link {
+  WiFiClient sock;
+  bool     used = false;
+  bool     hello = false;
+  char     name[24];
+  uint8_t  depth = 1;
+  uint32_t pending[LINK_QUEUE_MAX];   // assignment ids sent and not DONE yet
+  uint8_t  pendingCount = 0;
+  uint32_t lastRxMs = 0, lastTxMs = 0, holdUntilMs = 0;
+  uint8_t  rx[sizeof(NetFrameHeader) + NET_LINK_MAX_PAYLOAD];
+  uint16_t rxLen = 0;
+};
+
+static WiFiServer sServer(NET_LINK_PORT, LINK_MAX_CLIENTS);
+static Link       sLinks[LINK_MAX_CLIENTS];
+static uint32_t   sNextId = 1;
+
+static bool sendFrame(Link& l, uint8_t type, const void* payload, uint16_t len) {
+  uint8_t buf[sizeof(NetFrameHeader) + NET_LINK_MAX_PAYLOAD];
+  NetFrameHeader h = { len, type, NET_LINK_VERSION };
+  memcpy(buf, &h, sizeof(h));
+  if (len) memcpy(buf + sizeof(h), payload, len);
+  size_t n = sizeof(h) + len;
+  if (l.sock.write(buf, n) != n) return false;
+  l.lastTxMs = millis();
+  return true;
+}
+
+static void closeLink(Link& l, const char* why) {
+  Serial.printf("🔌 Link %s (%s) closed: %s\n", l.name, l.sock.remoteIP().toString().c_str(), why);
+  if (l.hello) plannerDropModule(l.sock.remoteIP());
+  l.sock.stop();
+  l.used = false;
+}
+
+static void removePending(Link& l, uint32_t id) {
+  for (int i = 0; i < l.pendingCount; i++) {
+    if (l.pending[i] != id) continue;
+    for (int j = i; j < l.pendingCount - 1; j++) l.pending[j] = l.pending[j+1];
+    l.pendingCount--;
+    return;
+  }
+}
+
+static void onFrame(Link& l, const NetFrameHeader& h, const uint8_t* p) {
+  switch (h.type) {
+    case NET_MSG_HELLO: {
+      if (h.len < sizeof(NetHello)) return;
+      NetHello m; memcpy(&m, p, sizeof(m));
+      m.name[sizeof(m.name)-1] = 0;
+      strlcpy(l.name, m.name, sizeof(l.name));
+      l.depth = constrain(m.queueDepth, 1, LINK_QUEUE_MAX);
+      l.hello = true;
+      l.pendingCount = 0;
+      plannerDropModule(l.sock.remoteIP());   // a restarted module has forgotten its queue
+      upsertClient(l.sock.remoteIP(), String(l.name));
+      Serial.printf("👋 Link HELLO %s (%s), queue %u\n", l.name, l.sock.remoteIP().toString().c_str(), l.depth);
+      break;
+    }
+    case NET_MSG_ACK: {
+      if (h.len < sizeof(NetAck)) return;
+      NetAck m; memcpy(&m, p, sizeof(m));
+      if (m.status != NET_ACK_QUEUED) { removePending(l, m.id); plannerRelease(m.id); l.holdUntilMs = millis() + LINK_RETRY_MS; }
+      break;
+    }
+    case NET_MSG_DONE: {
+      if (h.len < sizeof(NetDone)) return;
+      NetDone m; memcpy(&m, p, sizeof(m));
+      removePending(l, m.id);
+      plannerRelease(m.id);
+      if (m.reason == NET_DONE_NOT_VISIBLE || m.reason == NET_DONE_EXPIRED) l.holdUntilMs = millis() + LINK_RETRY_MS;
+      break;
+    }
+    default: break;   // heartbeat / unknown: lastRxMs already updated
+  }
+}
+
+// Non-blocking: consume whatever has arrived, dispatch complete frames
+static void readLink(Link& l) {
+  for (;;) {
+    size_t need = sizeof(NetFrameHeader);
+    NetFrameHeader h;
+    if (l.rxLen >= need) {
+      memcpy(&h, l.rx, sizeof(h));
+      if (h.len > NET_LINK_MAX_PAYLOAD) { closeLink(l, "oversized frame"); return; }
+      need += h.len;
+      if (l.rxLen == need) {
+        onFrame(l, h, l.rx + sizeof(h));
+        l.rxLen = 0;
+        continue;
+      }
+    }
+    if (l.sock.available() <= 0) return;
+    int n = l.sock.read(l.rx + l.rxLen, need - l.rxLen);
+    if (n <= 0) return;
+    l.rxLen += n;
+    l.lastRxMs = millis();
+  }
+}
+
+static void fillQueue(Link& l) {
+  if (!l.hello || (int32_t)(millis() - l.holdUntilMs) < 0) return;
+  while (l.pendingCount < l.depth) {
+    NetAssign a;
+    memset(&a, 0, sizeof(a));
+    a.id = sNextId;   // known to the planner before the push
+    if (!nextAssignment(l.sock.remoteIP(), a)) { l.holdUntilMs = millis() + LINK_RETRY_MS; return; }
+    sNextId++;
+    if (!sendFrame(l, NET_MSG_ASSIGN, &a, sizeof(a))) { closeLink(l, "write failed"); return; }
+    l.pending[l.pendingCount++] = a.id;
+    Serial.printf("📡 Pushed #%lu %s to %s (%u/%u queued)\n", (unsigned long)a.id, a.name, l.name, l.pendingCount, l.depth);
+  }
+}
+
+void linkBegin() {
+  sServer.begin();
+  sServer.setNoDelay(true);
+}
+
+void linkLoop() {
+  // new connections
+  while (sServer.hasClient()) {
+    WiFiClient c = sServer.accept();
+    int slot = -1;
+    for (int i = 0; i < LINK_MAX_CLIENTS; i++) {
+      if (sLinks[i].used && sLinks[i].sock.remoteIP() == c.remoteIP()) { closeLink(sLinks[i], "reconnected"); }
+      if (!sLinks[i].used && slot < 0) slot = i;
+    }
+    if (slot < 0) { c.stop(); continue; }
+    Link& l = sLinks[slot];
+    l.sock = c;
+    l.sock.setNoDelay(true);
+    l.used = true; l.hello = false; l.pendingCount = 0; l.rxLen = 0; l.holdUntilMs = 0;
+    l.lastRxMs = l.lastTxMs = millis();
+    strlcpy(l.name, "?", sizeof(l.name));
+  }
+
+  for (int i = 0; i < LINK_MAX_CLIENTS; i++) {
+    Link& l = sLinks[i];
+    if (!l.used) continue;
+    if (!l.sock.connected()) { closeLink(l, "disconnected"); continue; }
+    readLink(l);
+    if (!l.used) continue;
+    if (millis() - l.lastRxMs > LINK_TIMEOUT_MS) { closeLink(l, "timeout"); continue; }
+    fillQueue(l);
+    if (l.used && millis() - l.lastTxMs > LINK_HEARTBEAT_MS) {
+      if (!sendFrame(l, NET_MSG_HEARTBEAT, nullptr, 0)) closeLink(l, "write failed");
+    }
+  }
+}
+
+int linkPeers(IPAddress* out, int maxOut) {
+  int n = 0;
+  for (int i = 0; i < LINK_MAX_CLIENTS && n < maxOut; i++) if (sLinks[i].used && sLinks[i].hello) out[n++] = sLinks[i].sock.remoteIP();
+  return n;
+}
+
+int linkConnectedCount() {
+  int n = 0;
+  for (int i = 0; i < LINK_MAX_CLIENTS; i++) if (sLinks[i].used && sLinks[i].hello) n++;
+  return n;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <Arduino.h>
+
+// Persistent push channel to the client modules (protocol in NetProto.h).
+// Accepts connections on NET_LINK_PORT and keeps each module's assignment queue topped up.
+
+#define LINK_MAX_CLIENTS     12
+#define LINK_QUEUE_MAX       4       // cap on the depth a client may ask for
+#define LINK_HEARTBEAT_MS    5000
+#define LINK_TIMEOUT_MS      15000   // drop a module that has been silent this long
+#define LINK_RETRY_MS        2000    // wait before pushing again after "nothing to assign" / not visible
+
+void linkBegin();
+void linkLoop();
+int  linkConnectedCount();
+int  linkPeers(IPAddress* out, int maxOut);   // addresses of the modules that said HELLO
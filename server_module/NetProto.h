@@ -0,0 +1,121 @@
+#pragma once
+#include <stdint.h>
+
+// Binary UDP messages shared by server_module and client_module.
+// Both sketches carry a copy of this file: keep them identical.
+// All fields are little-endian (native on ESP32).
+
+// ===== Time sync (UDP 4210) =====
+// Client sends TIME_REQUEST with t1 (its clock); server answers TIME_REPLY echoing t1 and
+// adding t2 (request received) and t3 (reply sent). Client stamps t4 on receipt:
+//   offset = ((t2 - t1) + (t3 - t4)) / 2     delay = (t4 - t1) - (t3 - t2)
+// TIME_BEACON is broadcast by the server (t3 only) so new clients can set a coarse clock.
+#define NET_TIME_MAGIC    0x31535454u   // "TTS1"
+#define NET_TIME_VERSION  1
+
+enum NetTimeType : uint8_t {
+  NET_TIME_BEACON  = 1,
+  NET_TIME_REQUEST = 2,
+  NET_TIME_REPLY   = 3,
+};
+
+struct __attribute__((packed)) NetTimePacket {
+  uint32_t magic;
+  uint8_t  type;        // NetTimeType
+  uint8_t  version;
+  uint16_t seq;         // echoed in the reply
+  int64_t  t1Us;        // unix microseconds
+  int64_t  t2Us;
+  int64_t  t3Us;
+};
+static_assert(sizeof(NetTimePacket) == 32, "NetTimePacket layout changed");
+
+// ===== Commands (UDP 4212) =====
+// The server sends NET_CMD_EXEC (header + 'len' bytes of command text, ';' separates
+// commands) unicast, or once to the subnet broadcast address for ALL. Each client
+// answers every copy with a NET_CMD_ACK (header only, same epoch/seq) to the sender's
+// address and port, but runs a given epoch/seq only once, so the server can retransmit
+// to the modules that have not acked yet. 'epoch' is random per server boot.
+// Plain-text datagrams without the header are still run as commands (no ack).
+#define NET_CMD_MAGIC     0x31444D43u   // "CMD1"
+#define NET_CMD_VERSION   1
+#define NET_CMD_MAX_TEXT  360
+
+enum NetCmdType : uint8_t {
+  NET_CMD_EXEC = 1,
+  NET_CMD_ACK  = 2,
+};
+
+struct __attribute__((packed)) NetCmdHeader {
+  uint32_t magic;
+  uint8_t  type;        // NetCmdType
+  uint8_t  version;
+  uint16_t len;         // text bytes following (EXEC only)
+  uint32_t epoch;
+  uint32_t seq;
+};
+static_assert(sizeof(NetCmdHeader) == 16, "NetCmdHeader layout changed");
+
+// ===== Module link (TCP 4214) =====
+// One long-lived connection per client module. Every message is a NetFrameHeader followed
+// by 'len' payload bytes. The client sends HELLO once (with how many assignments it can
+// queue); the server pushes ASSIGN while the client has free slots; the client ACKs each one
+// and reports DONE when it is finished with it. Both sides send HEARTBEAT when idle.
+#define NET_LINK_PORT         4214
+#define NET_LINK_VERSION      1
+#define NET_LINK_MAX_PAYLOAD  256
+
+enum NetMsgType : uint8_t {
+  NET_MSG_HELLO     = 1,   // client -> server: NetHello
+  NET_MSG_ASSIGN    = 2,   // server -> client: NetAssign
+  NET_MSG_ACK       = 3,   // client -> server: NetAck
+  NET_MSG_DONE      = 4,   // client -> server: NetDone
+  NET_MSG_HEARTBEAT = 5,   // either way, no payload
+};
+
+struct __attribute__((packed)) NetFrameHeader {
+  uint16_t len;         // payload bytes following the header
+  uint8_t  type;        // NetMsgType
+  uint8_t  version;
+};
+
+struct __attribute__((packed)) NetHello {
+  char    name[24];     // MODULE-xxxxxx
+  uint8_t queueDepth;   // assignments the client can hold (current + next ...)
+  uint8_t reserved[3];
+};
+
+struct __attribute__((packed)) NetAssign {
+  uint32_t id;          // server-chosen, echoed in ACK/DONE
+  uint32_t serverUnix;  // server time when sent (coarse clock seed)
+  uint32_t norad;
+  uint32_t aosUnix;     // predicted pass; 0 = no prediction
+  uint32_t losUnix;
+  float    maxElDeg;
+  float    aosAzDeg;
+  double   siteLat, siteLon;
+  float    siteAlt;
+  char     name[28];
+  char     line1[70];
+  char     line2[70];
+};
+
+enum NetAckStatus : uint8_t { NET_ACK_QUEUED = 0, NET_ACK_FULL = 1, NET_ACK_BAD = 2 };
+struct __attribute__((packed)) NetAck {
+  uint32_t id;
+  uint8_t  status;      // NetAckStatus
+  uint8_t  reserved[3];
+};
+
+enum NetDoneReason : uint8_t {
+  NET_DONE_PASS_END    = 0,   // tracked until the satellite set
+  NET_DONE_NOT_VISIBLE = 1,   // never came above the horizon
+  NET_DONE_EXPIRED     = 2,   // pass was over before the client got to it
+  NET_DONE_SKIPPED     = 3,   // operator asked for another satellite
+};
+struct __attribute__((packed)) NetDone {
+  uint32_t id;
+  uint8_t  reason;      // NetDoneReason
+  uint8_t  reserved[3];
+};
+static_assert(sizeof(NetAssign) <= NET_LINK_MAX_PAYLOAD, "NetAssign too large");
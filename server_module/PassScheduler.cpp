@@ -0,0 +1,175 @@
+#include "PassScheduler.h"
+#include "SatCatalog.h"
+#include "Metrics.h"
+#include <Sgp4.h>   // SparkFun SGP4
+
+// Resolve references defined in the .ino:
+extern int  satelliteCount();
+extern bool readSatellite(int idx, SatRecord& out);
+
+static Sgp4 sSat;
+static bool sSiteSet = false;
+
+// upcoming passes, sorted by aosUnix ascending
+static PassInfo sQueue[PASS_QUEUE_MAX];
+static int sQueued = 0;
+
+// sweep state (resumable across schedulerLoop() calls)
+static int      sScanIdx = 0;        // satellite being propagated
+static int      sStep = -1;          // -1: satellite not initialised yet
+static uint32_t sSweepStart = 0;
+static bool     sSweepDone = false;
+static bool     sSwept = false;      // a full sweep finished since the last reset
+
+// current satellite
+static uint32_t sT0 = 0;
+static float    sPrevEl = -90.0f;
+static bool     sUp = false;
+static PassInfo sCur;
+
+static const int STEPS_PER_SAT = PASS_HORIZON_S / PASS_STEP_S;
+
+void schedulerBegin(double latDeg, double lonDeg, double altM) {
+  sSat.site(latDeg, lonDeg, altM);
+  sSiteSet = true;
+  schedulerReset();
+}
+
+void schedulerReset() {
+  sQueued = 0;
+  sScanIdx = 0;
+  sStep = -1;
+  sSweepStart = 0;
+  sSweepDone = false;
+  sSwept = false;
+}
+
+int  schedulerQueued()    { return sQueued; }
+bool schedulerSweepDone() { return sSweepDone; }
+bool schedulerHasSwept()  { return sSwept; }
+
+static void queueRemoveAt(int i) {
+  for (int j = i; j < sQueued - 1; j++) sQueue[j] = sQueue[j+1];
+  sQueued--;
+}
+
+static void queueInsert(const PassInfo& p) {
+  // one entry per satellite: a newer prediction replaces the old one
+  for (int i = 0; i < sQueued; i++) {
+    if (sQueue[i].satIdx == p.satIdx) { queueRemoveAt(i); break; }
+  }
+  if (sQueued == PASS_QUEUE_MAX) {
+    if (p.aosUnix >= sQueue[sQueued-1].aosUnix) return; // later than everything we keep
+    sQueued--;                                          // drop the latest
+  }
+  int pos = sQueued;
+  while (pos > 0 && sQueue[pos-1].aosUnix > p.aosUnix) { sQueue[pos] = sQueue[pos-1]; pos--; }
+  sQueue[pos] = p;
+  sQueued++;
+}
+
+// Set up propagation for sScanIdx; false if the satellite should be skipped
+static bool beginSatellite(uint32_t nowUnix) {
+  SatRecord rec;
+  if (!readSatellite(sScanIdx, rec)) return false;
+
+  char l1[130]; strlcpy(l1, rec.line1, sizeof(l1));
+  char l2[130]; strlcpy(l2, rec.line2, sizeof(l2));
+  if (!sSat.init(rec.name, l1, l2)) return false;
+
+  sT0 = nowUnix;
+  sPrevEl = -90.0f;
+  sUp = false;
+  memset(&sCur, 0, sizeof(sCur));
+  sCur.satIdx = sScanIdx;
+  sCur.norad = rec.norad;
+  sCur.maxElDeg = -90.0f;
+  return true;
+}
+
+// Propagate one coarse step; returns true when this satellite is finished
+static bool stepSatellite() {
+  uint32_t t = sT0 + (uint32_t)sStep * PASS_STEP_S;
+  {
+    MetricScope m(MET_FINDSAT_US);
+    sSat.findsat((unsigned long)t);
+  }
+  float el = (float)sSat.satEl;
+  float az = (float)sSat.satAz;
+
+  if (!sUp && el >= PASS_MIN_EL_DEG) {
+    sUp = true;
+    if (sStep == 0) sCur.aosUnix = t;  // already up
+    else {
+      float f = (PASS_MIN_EL_DEG - sPrevEl) / (el - sPrevEl);
+      sCur.aosUnix = t - PASS_STEP_S + (uint32_t)(f * PASS_STEP_S);
+    }
+    sCur.aosAzDeg = az;
+  }
+
+  if (sUp) {
+    if (el > sCur.maxElDeg) { sCur.maxElDeg = el; sCur.tcaUnix = t; sCur.tcaAzDeg = az; }
+    if (el < PASS_MIN_EL_DEG) {
+      float f = (sPrevEl - PASS_MIN_EL_DEG) / (sPrevEl - el);
+      sCur.losUnix = t - PASS_STEP_S + (uint32_t)(f * PASS_STEP_S);
+      queueInsert(sCur);
+      return true;
+    }
+  }
+
+  sPrevEl = el;
+  if (sStep >= STEPS_PER_SAT) {
+    if (sUp) { sCur.losUnix = t; queueInsert(sCur); } // still up at the end of the horizon
+    return true;
+  }
+  return false;
+}
+
+void schedulerLoop(uint32_t nowUnix) {
+  if (!sSiteSet || nowUnix == 0) return;
+
+  int count = satelliteCount();
+  if (count <= 0) return;
+
+  if (sSweepDone) {
+    uint32_t since = nowUnix - sSweepStart;
+    bool due = since >= PASS_RESCAN_S || (sQueued < 4 && since >= PASS_STEP_S);
+    if (!due) return;
+    sSweepDone = false;
+    sScanIdx = 0;
+    sStep = -1;
+  }
+  if (sScanIdx == 0 && sStep < 0) sSweepStart = nowUnix;
+
+  uint32_t start = micros();
+  while (micros() - start < PASS_LOOP_BUDGET_US) {
+    if (sScanIdx >= count) {
+      sSweepDone = sSwept = true;
+      Serial.printf("🛰️ Pass sweep done: %d satellites, %d passes queued\n", count, sQueued);
+      return;
+    }
+    if (sStep < 0) {
+      if (!beginSatellite(nowUnix)) { sScanIdx++; continue; }
+      sStep = 0;
+    }
+    if (stepSatellite()) { sScanIdx++; sStep = -1; }
+    else sStep++;
+  }
+}
+
+int schedulerPending(uint32_t nowUnix, PassInfo* out, int maxOut) {
+  // drop passes that are over (or nearly over)
+  for (int i = sQueued - 1; i >= 0; i--) {
+    if (sQueue[i].losUnix < nowUnix + PASS_MIN_REMAIN_S) queueRemoveAt(i);
+  }
+  int n = min(sQueued, maxOut);
+  for (int i = 0; i < n; i++) out[i] = sQueue[i];
+  return n;
+}
+
+bool schedulerTake(int satIdx) {
+  for (int i = 0; i < sQueued; i++) {
+    if (sQueue[i].satIdx == satIdx) { queueRemoveAt(i); return true; }
+  }
+  return false;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <Arduino.h>
+
+// Pass prediction over the indexed satellites.
+// schedulerLoop() propagates a few satellites per call (time-budgeted) and keeps a
+// small queue of upcoming passes ordered by AOS; AssignPlanner decides which module gets which.
+
+#define PASS_MIN_EL_DEG      10.0f   // a pass counts from/to this elevation
+#define PASS_HORIZON_S       900     // look this far ahead per sweep
+#define PASS_STEP_S          30      // coarse propagation step
+#define PASS_MIN_REMAIN_S    60      // don't hand out passes ending sooner than this
+#define PASS_RESCAN_S        300     // restart the sweep this often
+#define PASS_QUEUE_MAX       48
+#define PASS_LOOP_BUDGET_US  4000    // propagation time per schedulerLoop() call
+
+struct PassInfo {
+  int      satIdx;      // index into the satellite index (SatIndex)
+  uint32_t norad;
+  uint32_t aosUnix;     // rise above PASS_MIN_EL_DEG (<= now if already up)
+  uint32_t losUnix;     // set below PASS_MIN_EL_DEG
+  uint32_t tcaUnix;     // time of max elevation
+  float    maxElDeg;
+  float    aosAzDeg;
+  float    tcaAzDeg;    // where the pass culminates (sky region, see AssignPlanner)
+};
+
+void schedulerBegin(double latDeg, double lonDeg, double altM);
+void schedulerReset();                                 // source changed: drop queue, restart sweep
+void schedulerLoop(uint32_t nowUnix);
+// Copies the queued passes that still have PASS_MIN_REMAIN_S to go (dropping the others),
+// ordered by AOS; returns how many
+int  schedulerPending(uint32_t nowUnix, PassInfo* out, int maxOut);
+bool schedulerTake(int satIdx);                         // remove a handed-out pass from the queue
+int  schedulerQueued();                                // passes in the queue
+bool schedulerSweepDone();                             // idle until the next rescan is due
+bool schedulerHasSwept();   // a whole sweep finished since the last reset: the queue is complete
@@ -0,0 +1,87 @@
+#include "SatCatalog.h"
+#include <SD.h>
+
+static File     sFile;
+static uint32_t sCount = 0;
+static uint32_t sRecordsOffset = 0;
+
+bool catalogOpen(const char* path) {
+  catalogClose();
+
+  sFile = SD.open(path, FILE_READ);
+  if (!sFile) return false;
+
+  CatalogHeader h;
+  if (sFile.read((uint8_t*)&h, sizeof(h)) != sizeof(h) ||
+      memcmp(h.magic, SAT_CATALOG_MAGIC, 4) != 0) {
+    Serial.printf("❌ %s: not a satellite catalog\n", path);
+    catalogClose();
+    return false;
+  }
+  if (h.version != SAT_CATALOG_VERSION || h.recordSize != sizeof(SatRecord)) {
+    Serial.printf("❌ %s: unsupported catalog v%u (record %u B, expected v%u/%u B)\n",
+                  path, h.version, h.recordSize, SAT_CATALOG_VERSION, (unsigned)sizeof(SatRecord));
+    catalogClose();
+    return false;
+  }
+
+  uint32_t need = h.recordsOffset + h.count * (uint32_t)sizeof(SatRecord);
+  if (sFile.size() < need) {
+    Serial.printf("❌ %s: truncated (%lu B, header says %lu B)\n",
+                  path, (unsigned long)sFile.size(), (unsigned long)need);
+    catalogClose();
+    return false;
+  }
+
+  sCount = h.count;
+  sRecordsOffset = h.recordsOffset;
+  return true;
+}
+
+void catalogClose() {
+  if (sFile) sFile.close();
+  sCount = 0;
+  sRecordsOffset = 0;
+}
+
+bool catalogIsOpen() { return (bool)sFile; }
+int  catalogCount()  { return (int)sCount; }
+
+bool catalogRead(int idx, SatRecord& out) {
+  if (!sFile || idx < 0 || (uint32_t)idx >= sCount) return false;
+  if (!sFile.seek(sRecordsOffset + (uint32_t)idx * sizeof(SatRecord))) return false;
+  if (sFile.read((uint8_t*)&out, sizeof(out)) != sizeof(out)) return false;
+  out.name[sizeof(out.name)-1] = 0;
+  out.line1[sizeof(out.line1)-1] = 0;
+  out.line2[sizeof(out.line2)-1] = 0;
+  return true;
+}
+
+// days since 1970-01-01 for a proleptic Gregorian date
+static int32_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = (uint32_t)(y - era * 400);
+  const uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int32_t)doe - 719468;
+}
+
+// TLE line 1, columns 19-32: YYDDD.DDDDDDDD
+double tleEpochUnix(const char* line1) {
+  if (!line1 || strlen(line1) < 32) return 0.0;
+  char yy[3] = { line1[18], line1[19], 0 };
+  char doyTxt[13]; memcpy(doyTxt, line1 + 20, 12); doyTxt[12] = 0;
+  int year = atoi(yy);
+  year += (year < 57) ? 2000 : 1900;
+  double doy = atof(doyTxt);
+  if (doy < 1.0) return 0.0;
+  return (double)daysFromCivil(year, 1, 1) * 86400.0 + (doy - 1.0) * 86400.0;
+}
+
+// TLE line 1, columns 3-7
+uint32_t tleNorad(const char* line1) {
+  if (!line1 || strlen(line1) < 7) return 0;
+  char num[6]; memcpy(num, line1 + 2, 5); num[5] = 0;
+  return (uint32_t)strtoul(num, nullptr, 10);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <Arduino.h>
+
+// Binary satellite catalog (/sat_catalog.bin), written by setupfiles/sat_export_multifile.py.
+//
+// Layout (little-endian):
+//   CatalogHeader                      32 bytes
+//   SatRecord[count]                   recordSize bytes each, starting at recordsOffset
+//
+// Records are fixed size, so record i lives at recordsOffset + i*recordSize and can be
+// read with a single seek, without parsing anything before it.
+
+#define SAT_CATALOG_MAGIC    "SATC"
+#define SAT_CATALOG_VERSION  1
+
+struct CatalogHeader {
+  char     magic[4];        // "SATC"
+  uint16_t version;         // SAT_CATALOG_VERSION
+  uint16_t recordSize;      // sizeof(SatRecord)
+  uint32_t count;           // number of records
+  uint32_t createdUnix;     // export time
+  uint32_t recordsOffset;   // byte offset of record 0
+  uint8_t  reserved[12];
+};
+
+struct SatRecord {
+  uint32_t norad;           // NORAD catalog number (from TLE line 1)
+  uint32_t exportUnix;      // time the exporter evaluated this satellite ("datetime_utc")
+  double   epochUnix;       // TLE epoch, unix seconds with fraction
+  float    distanceKm;      // exporter's distance at exportUnix
+  float    elevationDeg;    // exporter's elevation at exportUnix
+  char     name[28];
+  char     line1[70];       // 69 chars + NUL
+  char     line2[70];
+};
+
+static_assert(sizeof(CatalogHeader) == 32, "CatalogHeader must stay 32 bytes");
+static_assert(sizeof(SatRecord) == 192, "SatRecord must stay 192 bytes (matches exporter)");
+
+bool catalogOpen(const char* path);
+void catalogClose();
+bool catalogIsOpen();
+int  catalogCount();
+bool catalogRead(int idx, SatRecord& out);
+
+// TLE helpers
+double   tleEpochUnix(const char* line1);
+uint32_t tleNorad(const char* line1);
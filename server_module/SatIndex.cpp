@@ -0,0 +1,286 @@
+#include "SatIndex.h"
+#include "SatJsonReader.h"
+#include <SD.h>
+#include <algorithm>
+
+#define LOC_FILE_SHIFT   27
+#define LOC_OFFSET_MAX   ((1u << LOC_FILE_SHIFT) - 1)
+#define LOC_FILE(loc)    ((int)((loc) >> LOC_FILE_SHIFT))
+#define LOC_OFFSET(loc)  ((loc) & LOC_OFFSET_MAX)
+#define LOC_DROPPED      0xFFFFFFFFu
+
+static SatIndexEntry* sEntries = nullptr;
+static uint16_t* sById = nullptr;      // entry numbers ordered by NORAD id
+static uint16_t* sByName = nullptr;    // entry numbers ordered by name hash
+static uint16_t* sValid = nullptr;     // entry numbers with a fresh TLE, in index order
+static int sCount = 0, sCap = 0, sDuplicates = 0, sOverflow = 0, sValidCount = 0;
+
+struct SourceInfo { char path[32]; bool binary; int entries, stale; };
+static SourceInfo sFiles[SAT_INDEX_MAX_FILES];
+static int sFileCount = 0;
+
+static_assert(SAT_INDEX_MAX_FILES <= (1 << (32 - LOC_FILE_SHIFT)) - 1, "file number must fit in an index location");
+
+// JSON source the last record was read from (kept open for the next one)
+static File sJson;
+static int  sJsonFile = -1;
+
+// Source being indexed (satIndexBeginFile .. satIndexScanFile)
+static File sScan;
+static int  sScanFile = -1;
+static int  sScanPos = 0;      // catalog: next record; JSON: objects read
+
+static SatJsonReader sReader;   // scanning and reading back share the one buffer
+
+uint32_t satNameHash(const char* name) {
+  while (*name == ' ') name++;
+  size_t n = strlen(name);
+  while (n > 0 && name[n-1] == ' ') n--;
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; i++) h = (h ^ (uint8_t)toupper((unsigned char)name[i])) * 16777619u;
+  return h;
+}
+
+static bool sameName(const char* a, const char* b) {
+  while (*a == ' ') a++;
+  while (*b == ' ') b++;
+  for (; *a && *b; a++, b++) {
+    if (toupper((unsigned char)*a) != toupper((unsigned char)*b)) return false;
+  }
+  while (*a == ' ') a++;
+  while (*b == ' ') b++;
+  return !*a && !*b;
+}
+
+// Room for more entries: doubling while the heap allows, then in small steps. Growth stops
+// while the entries plus their orderings would leave less than SAT_INDEX_HEAP_RESERVE free.
+static bool grow() {
+  if (sCap >= SAT_INDEX_MAX) return false;
+  int steps[2] = { sCap ? min(sCap * 2, SAT_INDEX_MAX) : 256, min(sCap + SAT_INDEX_GROW, SAT_INDEX_MAX) };
+  for (int cap : steps) {
+    // the new entries, plus the orderings satIndexFinish() allocates for all of them
+    size_t more = (size_t)(cap - sCap) * sizeof(SatIndexEntry) + (size_t)cap * 3 * sizeof(uint16_t);
+    if (ESP.getFreeHeap() < more + SAT_INDEX_HEAP_RESERVE) continue;
+    SatIndexEntry* p = (SatIndexEntry*)realloc(sEntries, cap * sizeof(SatIndexEntry));
+    if (!p) continue;
+    sEntries = p; sCap = cap;
+    return true;
+  }
+  return false;
+}
+
+static void add(const SatRecord& rec, int file, uint32_t offset) {
+  if (rec.norad == 0 || offset > LOC_OFFSET_MAX) return;
+  if (sCount == sCap && !grow()) { sOverflow++; return; }
+  sEntries[sCount++] = { rec.norad, satNameHash(rec.name), (uint32_t)rec.epochUnix,
+                         ((uint32_t)file << LOC_FILE_SHIFT) | offset };
+}
+
+void satIndexClear() {
+  free(sEntries); free(sById); free(sByName); free(sValid);
+  sEntries = nullptr; sById = sByName = sValid = nullptr;
+  sCount = sCap = sDuplicates = sOverflow = sValidCount = 0;
+  sFileCount = 0;
+  if (sJson) sJson.close();
+  sJsonFile = -1;
+  if (sScan) sScan.close();
+  sScanFile = -1;
+  catalogClose();
+}
+
+bool satIndexBeginFile(const char* path, bool binary) {
+  if (sFileCount >= SAT_INDEX_MAX_FILES) return false;
+  int file = sFileCount++;   // taken even if the source cannot be read: numbers follow the caller's list
+  SourceInfo& s = sFiles[file];
+  strlcpy(s.path, path, sizeof(s.path));
+  s.binary = binary;
+  s.entries = 0; s.stale = 0;
+
+  sScanPos = 0;
+  if (binary) {
+    if (!catalogOpen(path)) return false;   // stays open: its records are read back by number
+  } else {
+    sScan = SD.open(path, FILE_READ);
+    if (!sScan) return false;
+    if (!sReader.begin(sScan)) {
+      Serial.printf("⚠️ %s: not a JSON array\n", path);
+      sScan.close();
+    }
+  }
+  sScanFile = file;
+  return true;
+}
+
+// One pass over the source, resumed where the last call ran out of budget: every object
+// is parsed once, in place, and indexed by offset (record number in the catalog)
+bool satIndexScanFile(uint32_t budgetUs, int& found) {
+  found = 0;
+  if (sScanFile < 0) return true;
+  const SourceInfo& s = sFiles[sScanFile];
+  uint32_t start = micros();
+  SatRecord rec;
+  if (s.binary) {
+    while (sScanPos < catalogCount()) {
+      if (catalogRead(sScanPos, rec)) add(rec, sScanFile, (uint32_t)sScanPos);
+      sScanPos++;
+      if (micros() - start >= budgetUs) return false;
+    }
+    found = catalogCount();
+  } else {
+    uint32_t offset;
+    while (sScan && sReader.next(rec, offset)) {
+      add(rec, sScanFile, offset);
+      sScanPos++;
+      if (micros() - start >= budgetUs) return false;
+    }
+    if (sScan) {
+      if (sReader.skipped()) Serial.printf("⚠️ %s: skipped %d satellites that did not parse\n", s.path, sReader.skipped());
+      if (sReader.truncated()) Serial.printf("⚠️ %s: ends early (truncated?), read %d satellites\n", s.path, sScanPos);
+      found = sScanPos + sReader.skipped();
+      sScan.close();
+    }
+  }
+  sScanFile = -1;
+  return true;
+}
+
+void satIndexFinish() {
+  free(sById); free(sByName); free(sValid);
+  sById = sByName = sValid = nullptr;
+  sDuplicates = sValidCount = 0;
+
+  // orderings for every entry; if the heap cannot hold them, the last entries go
+  int keep = sCount;
+  while (keep > 0) {
+    sById   = (uint16_t*)malloc(keep * sizeof(uint16_t));
+    sByName = (uint16_t*)malloc(keep * sizeof(uint16_t));
+    sValid  = (uint16_t*)malloc(keep * sizeof(uint16_t));
+    if (sById && sByName && sValid) break;
+    free(sById); free(sByName); free(sValid);
+    sById = sByName = sValid = nullptr;
+    keep -= keep / 8 + 1;
+    SatIndexEntry* p = keep ? (SatIndexEntry*)realloc(sEntries, keep * sizeof(SatIndexEntry)) : nullptr;
+    if (p) { sEntries = p; sCap = keep; }
+  }
+  sOverflow += sCount - keep;
+  sCount = keep;
+  if (sOverflow) Serial.printf("⚠️ Satellite index full (%d entries, %u B heap free), %d satellites not indexed\n",
+                               sCount, (unsigned)ESP.getFreeHeap(), sOverflow);
+  if (sCount == 0) return;
+
+  // one entry per object: freshest epoch first, the later source on a tie
+  for (int i = 0; i < sCount; i++) sById[i] = (uint16_t)i;
+  std::sort(sById, sById + sCount, [](uint16_t a, uint16_t b) {
+    const SatIndexEntry &x = sEntries[a], &y = sEntries[b];
+    if (x.norad != y.norad) return x.norad < y.norad;
+    if (x.epochUnix != y.epochUnix) return x.epochUnix > y.epochUnix;
+    return x.loc > y.loc;
+  });
+  for (int i = 1; i < sCount; i++) {
+    if (sEntries[sById[i]].norad == sEntries[sById[i-1]].norad) sEntries[sById[i]].loc = LOC_DROPPED;
+  }
+
+  int n = 0;
+  for (int i = 0; i < sCount; i++) {
+    if (sEntries[i].loc == LOC_DROPPED) continue;
+    sEntries[n++] = sEntries[i];
+  }
+  sDuplicates = sCount - n;
+  sCount = n;
+
+  for (int i = 0; i < sCount; i++) sFiles[LOC_FILE(sEntries[i].loc)].entries++;
+
+  for (int i = 0; i < sCount; i++) sById[i] = sByName[i] = (uint16_t)i;
+  std::sort(sById, sById + sCount, [](uint16_t a, uint16_t b) {
+    return sEntries[a].norad < sEntries[b].norad;
+  });
+  std::sort(sByName, sByName + sCount, [](uint16_t a, uint16_t b) {
+    return sEntries[a].nameHash < sEntries[b].nameHash;
+  });
+}
+
+int satIndexCount()      { return sCount; }
+int satIndexFiles()      { return sFileCount; }
+int satIndexDuplicates() { return sDuplicates; }
+int satIndexOverflow()   { return sOverflow; }
+
+int satIndexFileOf(int idx) {
+  return (idx >= 0 && idx < sCount) ? LOC_FILE(sEntries[idx].loc) : -1;
+}
+
+int satIndexFileEntries(int file) {
+  return (file >= 0 && file < sFileCount) ? sFiles[file].entries : 0;
+}
+
+const SatIndexEntry& satIndexEntry(int idx) { return sEntries[idx]; }
+
+bool satIndexRevalidate(uint32_t nowUnix, long maxAgeS) {
+  if (!sValid) return false;
+  for (int f = 0; f < sFileCount; f++) sFiles[f].stale = 0;
+  bool changed = false;
+  int n = 0;
+  for (int i = 0; i < sCount; i++) {
+    long age = (int32_t)(nowUnix - sEntries[i].epochUnix);   // epochs slightly ahead count as fresh
+    if (sEntries[i].epochUnix == 0 || labs(age) > maxAgeS) {
+      sFiles[LOC_FILE(sEntries[i].loc)].stale++;
+      continue;
+    }
+    if (n >= sValidCount || sValid[n] != i) changed = true;
+    sValid[n++] = (uint16_t)i;
+  }
+  if (n != sValidCount) changed = true;
+  sValidCount = n;
+  return changed;
+}
+
+int satIndexValidCount() { return sValidCount; }
+
+int satIndexValidAt(int pos) {
+  return (pos >= 0 && pos < sValidCount) ? sValid[pos] : -1;
+}
+
+int satIndexFirstValidOfFile(int file) {
+  for (int i = 0; i < sValidCount; i++) {
+    if (LOC_FILE(sEntries[sValid[i]].loc) == file) return i;
+  }
+  return -1;
+}
+
+int satIndexFileStale(int file) {
+  return (file >= 0 && file < sFileCount) ? sFiles[file].stale : 0;
+}
+
+int satIndexFindId(uint32_t norad) {
+  if (!sById) return -1;
+  const uint16_t* p = std::lower_bound(sById, sById + sCount, norad,
+    [](uint16_t e, uint32_t id) { return sEntries[e].norad < id; });
+  return (p != sById + sCount && sEntries[*p].norad == norad) ? *p : -1;
+}
+
+int satIndexFindName(const char* name) {
+  if (!sByName || !name) return -1;
+  const uint32_t h = satNameHash(name);
+  const uint16_t* p = std::lower_bound(sByName, sByName + sCount, h,
+    [](uint16_t e, uint32_t v) { return sEntries[e].nameHash < v; });
+  // hashes can collide: confirm against the stored name
+  for (; p != sByName + sCount && sEntries[*p].nameHash == h; p++) {
+    SatRecord rec;
+    if (satIndexRead(*p, rec) && sameName(rec.name, name)) return *p;
+  }
+  return -1;
+}
+
+bool satIndexRead(int idx, SatRecord& out) {
+  if (idx < 0 || idx >= sCount || sScanFile >= 0) return false;   // the reader is busy with a scan
+  const int file = LOC_FILE(sEntries[idx].loc);
+  const uint32_t offset = LOC_OFFSET(sEntries[idx].loc);
+  if (sFiles[file].binary) return catalogRead((int)offset, out);
+
+  if (sJsonFile != file) {
+    if (sJson) sJson.close();
+    sJson = SD.open(sFiles[file].path, FILE_READ);
+    sJsonFile = sJson ? file : -1;
+    if (!sJson) return false;
+  }
+  return sReader.readAt(sJson, offset, out);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+#include "SatCatalog.h"
+
+// Global satellite index over every source on the card (the binary catalog, or all
+// sat_data_N.json files). Built once after the file scan: one 16-byte entry per NORAD
+// object, the freshest TLE epoch winning when an object appears in several files.
+// Entries stay in file/offset order so a sweep reads the card front to back; two
+// 16-bit orderings by NORAD id and by name hash give O(log n) lookup. A record is read
+// on demand with one seek (and, for JSON, one object parsed by SatJsonReader), never a
+// whole file; JSON files may hold any number of objects up to 128 MB. Between
+// satIndexClear() and satIndexFinish() nothing is served, found or read.
+// The index grows with the free heap (a full Starlink shell, ~7k objects, takes ~150 KB);
+// what does not fit is counted in satIndexOverflow() and shown by /status.
+
+#define SAT_INDEX_MAX        16384  // entries; 22 B each including both orderings and the valid list
+#define SAT_INDEX_GROW       512    // growth step once doubling no longer fits the heap
+#define SAT_INDEX_HEAP_RESERVE  (48 * 1024)   // left free for HTTP, links and the /visible batch
+#define SAT_INDEX_MAX_FILES  24
+
+struct SatIndexEntry {
+  uint32_t norad;
+  uint32_t nameHash;    // satNameHash(name)
+  uint32_t epochUnix;   // TLE epoch, whole seconds
+  uint32_t loc;         // file << 27 | byte offset of the JSON object (record number in the catalog)
+};
+
+void satIndexClear();
+// Adds every satellite of one source as file number satIndexFiles(), incrementally so the
+// card is read in slices: begin, then scan until it returns true. Begin is false if the
+// source cannot be read (the number is used up all the same, so the n-th source is always
+// file n). Nothing is read back while a file is being scanned.
+bool satIndexBeginFile(const char* path, bool binary);
+bool satIndexScanFile(uint32_t budgetUs, int& found);   // true once done; found: satellites in it
+void satIndexFinish();                 // drop duplicates, build the lookup orderings
+
+int  satIndexCount();
+int  satIndexFiles();
+int  satIndexDuplicates();             // entries dropped by satIndexFinish()
+int  satIndexOverflow();               // satellites not indexed: SAT_INDEX_MAX or heap reached
+int  satIndexFileOf(int idx);
+int  satIndexFileEntries(int file);    // entries kept from one source
+const SatIndexEntry& satIndexEntry(int idx);
+
+// Freshness: a compact list (index order) of entries whose TLE epoch lies within maxAgeS
+// of now. Returns true if the list changed; positions into it are what gets served.
+bool satIndexRevalidate(uint32_t nowUnix, long maxAgeS);
+int  satIndexValidCount();
+int  satIndexValidAt(int pos);             // entry number of valid satellite #pos
+int  satIndexFirstValidOfFile(int file);   // position in the valid list, -1 if none
+int  satIndexFileStale(int file);          // entries of one source outside the max age
+
+int  satIndexFindId(uint32_t norad);   // -1 if absent
+int  satIndexFindName(const char* name);   // exact match, case-insensitive; -1 if absent
+bool satIndexRead(int idx, SatRecord& out);
+
+uint32_t satNameHash(const char* name);   // FNV-1a over the trimmed, upper-cased name
@@ -0,0 +1,125 @@
+#include "SatJsonReader.h"
+#include <ArduinoJson.h>
+#include <RTClib.h>
+
+static uint32_t isoUnix(const char* s) {
+  int y, M, d, h, m, sec;
+  if (!s || sscanf(s, "%d-%d-%dT%d:%d:%d", &y, &M, &d, &h, &m, &sec) != 6) return 0;
+  return DateTime(y, M, d, h, m, sec).unixtime();
+}
+
+// Only the fields a SatRecord needs; the rest of each object is skipped while parsing.
+// The exporter's "id" is a running number per export: objects are keyed by the NORAD id
+// in TLE line 1 instead.
+static JsonDocument& satFilter() {
+  static StaticJsonDocument<192> f;
+  if (f.isNull()) {
+    f["name"] = true;
+    f["datetime_utc"] = true;
+    f["distance_km"] = true;
+    f["elevation_deg"] = true;
+    f["tle"]["line-1"] = true;
+    f["tle"]["line-2"] = true;
+  }
+  return f;
+}
+
+void SatJsonReader::attach(File& f, uint32_t offset) {
+  _f = &f;
+  _base = offset;
+  _len = _pos = 0;
+  if (!f.seek(offset)) _f = nullptr;
+}
+
+bool SatJsonReader::fill() {
+  if (!_f) return false;
+  _base += _len;
+  _pos = 0;
+  int n = _f->read(_buf, sizeof(_buf));
+  _len = n > 0 ? (size_t)n : 0;
+  return _len > 0;
+}
+
+int SatJsonReader::read() {
+  if (_pos == _len && !fill()) return -1;
+  return _buf[_pos++];
+}
+
+int SatJsonReader::peek() {
+  if (_pos == _len && !fill()) return -1;
+  return _buf[_pos];
+}
+
+int SatJsonReader::skipSpace(bool commas) {
+  int c;
+  while ((c = peek()) == ' ' || c == '\n' || c == '\r' || c == '\t' || (commas && c == ',')) read();
+  return c;
+}
+
+// Steps over one object or array by depth, strings and escapes respected
+bool SatJsonReader::skipValue() {
+  int depth = 0, c;
+  bool inStr = false, esc = false;
+  while ((c = read()) >= 0) {
+    if (inStr) {
+      if (esc) esc = false;
+      else if (c == '\\') esc = true;
+      else if (c == '"') inStr = false;
+    } else if (c == '"') inStr = true;
+    else if (c == '{' || c == '[') depth++;
+    else if ((c == '}' || c == ']') && --depth == 0) return true;
+  }
+  return false;
+}
+
+// Parsing stops right after the object's closing brace
+bool SatJsonReader::parse(SatRecord& out) {
+  StaticJsonDocument<512> doc;
+  if (deserializeJson(doc, *this, DeserializationOption::Filter(satFilter()))) return false;
+  memset(&out, 0, sizeof(out));
+  strlcpy(out.name,  doc["name"] | "",           sizeof(out.name));
+  strlcpy(out.line1, doc["tle"]["line-1"] | "",  sizeof(out.line1));
+  strlcpy(out.line2, doc["tle"]["line-2"] | "",  sizeof(out.line2));
+  out.norad        = tleNorad(out.line1);
+  out.epochUnix    = tleEpochUnix(out.line1);
+  out.exportUnix   = isoUnix(doc["datetime_utc"].as<const char*>());
+  out.distanceKm   = doc["distance_km"]   | 0.0f;
+  out.elevationDeg = doc["elevation_deg"] | 0.0f;
+  return true;
+}
+
+bool SatJsonReader::begin(File& f) {
+  attach(f, 0);
+  _skipped = 0;
+  _truncated = false;
+  if (skipSpace(false) != '[') { _f = nullptr; return false; }
+  read();
+  return true;
+}
+
+bool SatJsonReader::next(SatRecord& out, uint32_t& offset) {
+  while (_f) {
+    int c = skipSpace(true);
+    if (c != '{') {
+      _truncated = c != ']';
+      _f = nullptr;
+      return false;
+    }
+    offset = position();
+    if (parse(out)) return true;
+
+    // back to the start of the element and over it, then carry on with the next one
+    _skipped++;
+    File& f = *_f;
+    attach(f, offset);
+    if (!skipValue()) { _truncated = true; _f = nullptr; }
+  }
+  return false;
+}
+
+bool SatJsonReader::readAt(File& f, uint32_t offset, SatRecord& out) {
+  attach(f, offset);
+  bool ok = skipSpace(false) == '{' && parse(out);
+  _f = nullptr;
+  return ok;
+}
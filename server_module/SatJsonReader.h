@@ -0,0 +1,48 @@
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include "SatCatalog.h"
+
+// Pull reader for a satellite file (a top-level JSON array of objects) on the card:
+// the counterpart of JsonWriter. It walks the array one element at a time, reports the
+// byte offset each object starts at, and materializes only the fields a SatRecord needs
+// (ArduinoJson filter), parsing straight from the file through a small read buffer. RAM
+// use does not depend on the size of the file or of an object; an element that does not
+// parse is stepped over by brace depth and counted.
+//
+//   SatJsonReader r;
+//   r.begin(f);
+//   while (r.next(rec, offset)) { ... }       // later: r.readAt(f, offset, rec)
+
+#define SAT_JSON_READ_BUF  512
+
+class SatJsonReader : public Stream {
+public:
+  bool begin(File& f);                              // enter the array; false if it is not one
+  bool next(SatRecord& out, uint32_t& offset);      // false at the end of the array
+  bool readAt(File& f, uint32_t offset, SatRecord& out);   // one object, one seek
+
+  int  skipped() const { return _skipped; }         // elements since begin() that did not parse
+  bool truncated() const { return _truncated; }     // the array did not end with ']'
+
+  // Stream, for the parser
+  int    available() override { return _pos < _len ? (int)(_len - _pos) : 0; }
+  int    read() override;
+  int    peek() override;
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  void     attach(File& f, uint32_t offset);
+  bool     fill();
+  uint32_t position() const { return _base + _pos; }
+  int      skipSpace(bool commas);
+  bool     skipValue();
+  bool     parse(SatRecord& out);
+
+  File*    _f = nullptr;
+  uint8_t  _buf[SAT_JSON_READ_BUF];
+  uint32_t _base = 0;            // file offset of _buf[0]
+  size_t   _len = 0, _pos = 0;
+  int      _skipped = 0;
+  bool     _truncated = false;
+};
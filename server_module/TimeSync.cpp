@@ -0,0 +1,109 @@
+#include "TimeSync.h"
+#include "NetProto.h"
+#include <WiFiUdp.h>
+#include <RTClib.h>
+#include "esp_timer.h"
+
+// Resolve references defined in the .ino:
+extern RTC_DS3231 rtc;
+
+static WiFiUDP   sUdp;
+static uint16_t  sPort = 0;
+static IPAddress sBroadcast;
+static int64_t  sAnchorUnixUs = 0;   // unix time at sAnchorLocalUs
+static int64_t  sAnchorLocalUs = 0;
+static uint32_t sLastBeaconMs = 0;
+static uint32_t sLastAnchorMs = 0;
+static portMUX_TYPE sAnchorMux = portMUX_INITIALIZER_UNLOCKED;  // /settime runs on the HTTP task
+
+// re-anchor state: waiting for the RTC seconds register to change
+static bool     sWatching = false;
+static uint32_t sWatchSecond = 0;
+
+int64_t timeSyncNowUs() {
+  portENTER_CRITICAL(&sAnchorMux);
+  int64_t t = sAnchorUnixUs + (esp_timer_get_time() - sAnchorLocalUs);
+  portEXIT_CRITICAL(&sAnchorMux);
+  return t;
+}
+
+static void anchor(uint32_t unix, int64_t localUs) {
+  portENTER_CRITICAL(&sAnchorMux);
+  sAnchorUnixUs = (int64_t)unix * 1000000LL;
+  sAnchorLocalUs = localUs;
+  portEXIT_CRITICAL(&sAnchorMux);
+  sLastAnchorMs = millis();
+}
+
+void timeSyncRtcAdjusted(uint32_t unix) {
+  // writing the seconds register restarts the DS3231 countdown, so this is an edge
+  anchor(unix, esp_timer_get_time());
+  sWatching = false;
+}
+
+void timeSyncBegin(uint16_t port, IPAddress broadcast) {
+  sPort = port;
+  sBroadcast = broadcast;
+  sUdp.begin(port);
+
+  uint32_t first = rtc.now().unixtime();
+  uint32_t start = millis();
+  uint32_t cur = first;
+  while (cur == first && millis() - start < 1100) { delay(1); cur = rtc.now().unixtime(); }
+  anchor(cur, esp_timer_get_time());
+}
+
+static void send(const NetTimePacket& p, IPAddress ip, uint16_t port) {
+  sUdp.beginPacket(ip, port);
+  sUdp.write((const uint8_t*)&p, sizeof(p));
+  sUdp.endPacket();
+}
+
+static void handleRequests() {
+  for (;;) {
+    int sz = sUdp.parsePacket();
+    if (sz <= 0) return;
+    int64_t t2 = timeSyncNowUs();
+
+    NetTimePacket p;
+    if (sz != (int)sizeof(p) || sUdp.read((uint8_t*)&p, sizeof(p)) != (int)sizeof(p)) continue;
+    if (p.magic != NET_TIME_MAGIC || p.type != NET_TIME_REQUEST) continue; // e.g. our own beacon
+
+    p.type = NET_TIME_REPLY;
+    p.version = NET_TIME_VERSION;
+    p.t2Us = t2;
+    p.t3Us = timeSyncNowUs();
+    send(p, sUdp.remoteIP(), sUdp.remotePort());
+  }
+}
+
+static void reanchorStep() {
+  if (!sWatching) {
+    if (millis() - sLastAnchorMs < TIME_REANCHOR_S * 1000UL) return;
+    sWatchSecond = rtc.now().unixtime();
+    sWatching = true;
+    return;
+  }
+  uint32_t s = rtc.now().unixtime();
+  if (s == sWatchSecond) return;
+  int64_t local = esp_timer_get_time();
+  int64_t drift = timeSyncNowUs() - (int64_t)s * 1000000LL;
+  anchor(s, local);
+  sWatching = false;
+  if (drift > 50000 || drift < -50000) Serial.printf("⏱️ Server clock re-anchored (%+ld ms)\n", (long)(drift / 1000));
+}
+
+void timeSyncLoop() {
+  handleRequests();
+  reanchorStep();
+
+  if (millis() - sLastBeaconMs >= TIME_BEACON_INTERVAL_MS) {
+    sLastBeaconMs = millis();
+    NetTimePacket p = {};
+    p.magic = NET_TIME_MAGIC;
+    p.type = NET_TIME_BEACON;
+    p.version = NET_TIME_VERSION;
+    p.t3Us = timeSyncNowUs();
+    send(p, sBroadcast, sPort);
+  }
+}
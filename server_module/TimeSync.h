@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+
+// Server clock and time-sync responder.
+// The DS3231 only counts whole seconds, so the server clock is the esp_timer
+// microsecond counter anchored to an RTC second edge and re-anchored periodically.
+
+#define TIME_BEACON_INTERVAL_MS  1000    // coarse broadcast for clients without a sync yet
+#define TIME_REANCHOR_S          60      // re-align to the RTC second edge this often
+
+void    timeSyncBegin(uint16_t port, IPAddress broadcast); // waits for one RTC second edge (<= 1 s)
+void    timeSyncLoop();                  // answer requests, send beacons, re-anchor
+void    timeSyncRtcAdjusted(uint32_t unix); // call right after rtc.adjust()
+int64_t timeSyncNowUs();                 // unix microseconds
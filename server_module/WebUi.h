@@ -0,0 +1,221 @@
+#pragma once
+#include <Arduino.h>
+
+// Generated by setupfiles/build_web_ui.py from web/index.html -- do not edit.
+// 10800 bytes of HTML, 3357 bytes gzipped.
+
+#define WEB_INDEX_ETAG   "\"a05617d4fee26da2\""
+#define WEB_INDEX_GZ_LEN 3357
+
+static const uint8_t WEB_INDEX_GZ[WEB_INDEX_GZ_LEN] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x1a,0xe9,0x72,0xdb,0xc6,
+  0xf9,0xbf,0x9e,0x62,0x3b,0x76,0xb5,0xe0,0x88,0x97,0x24,0xdb,0x63,0x91,0x04,0x3c,
+  0x8c,0xc4,0xc4,0x6a,0xa8,0xa3,0x22,0x35,0x99,0xda,0x75,0x23,0x10,0x58,0x92,0xb0,
+  0x70,0x05,0x58,0xe8,0x08,0xc5,0x99,0x3c,0x44,0x9f,0xa1,0x0f,0x96,0x27,0xe9,0xf7,
+  0xed,0x2e,0x2e,0x5e,0xa2,0x1c,0xdb,0x33,0xc4,0x1e,0xdf,0x7d,0xed,0xa5,0xce,0xdf,
+  0xec,0xc0,0xe2,0x8f,0x21,0x23,0x53,0xee,0xb9,0xc6,0x4e,0x47,0x7c,0x3a,0x53,0x66,
+  0xda,0xd0,0xf1,0x18,0x37,0x89,0x35,0x35,0xa3,0x98,0x71,0x9d,0x26,0x7c,0x5c,0x7b,
+  0x4f,0xd3,0x61,0xdf,0xf4,0x98,0x4e,0xef,0x1c,0x76,0x1f,0x06,0x11,0xa7,0xc4,0x0a,
+  0x7c,0xce,0x7c,0x00,0xbb,0x77,0x6c,0x3e,0xd5,0x6d,0x76,0xe7,0x58,0xac,0x26,0x3a,
+  0x55,0xc7,0x77,0xb8,0x63,0xba,0xb5,0xd8,0x32,0x5d,0xa6,0xef,0x23,0x8d,0x98,0x3f,
+  0xba,0xcc,0xd8,0x19,0x05,0xf6,0xe3,0x6c,0x0c,0xa8,0xb5,0xb1,0xe9,0x39,0xee,0x63,
+  0x2b,0x7e,0x8c,0x39,0xf3,0x6a,0x89,0x53,0xed,0x46,0x80,0xd2,0xf6,0xcc,0x68,0xe2,
+  0xf8,0xad,0xfd,0x77,0xe1,0xc3,0x7c,0x67,0x94,0x70,0x1e,0xf8,0x40,0x2e,0x4c,0x78,
+  0x35,0x66,0x2e,0xb3,0xb8,0x44,0x8e,0x9d,0xdf,0x99,0x80,0x69,0x87,0xa6,0x6d,0x3b,
+  0xfe,0xa4,0xb5,0xdf,0x0c,0x1f,0xc8,0xfe,0x1b,0x18,0x51,0x14,0x04,0x81,0xba,0x65,
+  0x46,0xf6,0x6c,0x14,0x44,0x36,0x8b,0x5a,0xfb,0x00,0x11,0x07,0xae,0x63,0x93,0x57,
+  0x96,0x65,0xb5,0xe5,0x68,0x2d,0x32,0x6d,0x27,0x89,0x5b,0xfb,0x07,0x45,0x62,0x07,
+  0x39,0x1d,0x6c,0x93,0x26,0x90,0x8a,0x82,0xfb,0x99,0xed,0xc4,0xa1,0x6b,0x3e,0xb6,
+  0xc6,0x2e,0x7b,0x68,0x4f,0xcc,0xb0,0xf5,0x1e,0x00,0xb1,0x53,0xbb,0x8f,0xa0,0x87,
+  0x3f,0x6d,0xd3,0x75,0x26,0x7e,0xcd,0x01,0xad,0xe2,0x96,0x05,0x16,0x62,0xd1,0x7c,
+  0xc7,0x0a,0x6c,0x36,0x1b,0x99,0xd6,0xed,0x24,0x0a,0x12,0xdf,0x6e,0xbd,0x1a,0xbf,
+  0xc1,0xff,0x19,0x43,0xe4,0x81,0xda,0x94,0x65,0x92,0x2a,0xc4,0xdc,0xe4,0x49,0xec,
+  0x3a,0x3e,0x9b,0x49,0x91,0x6a,0x2e,0x1b,0x73,0xc1,0xd9,0x0a,0xdc,0x20,0x6a,0xbd,
+  0x3a,0x3c,0x3c,0x6c,0x17,0xcc,0xf2,0x06,0xd1,0xb8,0x39,0x72,0x99,0xd2,0xbc,0x06,
+  0x70,0xae,0x19,0xc6,0xac,0x95,0x36,0xda,0xc2,0x4f,0x60,0xb4,0xe6,0xdf,0x01,0x74,
+  0x5a,0xe5,0xab,0x8c,0x64,0xdb,0x76,0x26,0x20,0x72,0xe3,0xec,0x81,0xd7,0x84,0x76,
+  0x2d,0x94,0x00,0x11,0xcb,0x3a,0x99,0xf8,0x1f,0x24,0x0e,0x1d,0xd7,0x7d,0x86,0xde,
+  0x3b,0xf4,0x56,0x73,0x49,0xe3,0xa3,0xa3,0xa3,0xdc,0xf2,0xe8,0xcc,0xd4,0xe0,0x8e,
+  0x8f,0x06,0xa8,0x8d,0xdc,0xc0,0xba,0x05,0x0e,0xd3,0xc0,0xb5,0x67,0x49,0x0c,0x88,
+  0x32,0x2a,0x5a,0x7e,0xe0,0xb3,0x76,0xed,0x9e,0x8d,0x6e,0x1d,0x5e,0x5b,0x9c,0x98,
+  0xef,0x74,0x1a,0x2a,0xfe,0x3a,0x0d,0x11,0xea,0x1d,0x8c,0x43,0x8c,0xfe,0x03,0xa3,
+  0x37,0xb8,0x3c,0x3c,0x20,0x03,0x93,0x33,0xd7,0x05,0xa7,0x91,0x01,0x8b,0xee,0x58,
+  0x04,0x70,0x07,0x30,0x6f,0x3b,0x77,0xc4,0x72,0xcd,0x38,0xd6,0x31,0x90,0x20,0x4f,
+  0x0e,0x8d,0xa1,0xe3,0x31,0xa2,0x5d,0x0d,0x8f,0x2b,0x00,0x73,0x58,0x82,0x81,0x08,
+  0x81,0xbe,0x88,0x56,0xe2,0xd8,0xba,0x13,0x07,0xe4,0xce,0x74,0x13,0x48,0x1b,0x4a,
+  0x40,0x0b,0x8b,0xa1,0xd8,0x2c,0xd2,0xe9,0xbf,0xe0,0x5f,0xed,0xec,0xac,0x76,0x72,
+  0x32,0xfc,0xf8,0xb1,0x75,0x76,0xd6,0x1a,0x0c,0x3e,0x51,0x22,0x44,0xd4,0xa9,0x07,
+  0x1e,0x96,0xee,0x39,0x78,0x07,0x16,0xc2,0xe4,0x91,0x79,0x80,0x34,0x47,0xdc,0x1f,
+  0x30,0x8e,0x32,0x18,0xf0,0x25,0x20,0x46,0xa7,0x21,0x67,0x31,0xc7,0x42,0x53,0x00,
+  0x71,0x98,0x3e,0x8b,0x27,0x4a,0xaa,0x3c,0x7e,0x0c,0x30,0x03,0x80,0xa0,0x15,0x40,
+  0x68,0x44,0xf0,0x4c,0xd7,0x35,0xce,0x03,0xce,0x5a,0xe4,0x7a,0x78,0x4c,0x02,0xdf,
+  0x7d,0x24,0x9a,0x19,0x86,0xcc,0xb7,0x09,0xfd,0x44,0x2b,0x75,0xc0,0x10,0x30,0x19,
+  0xca,0x0a,0x8b,0xe4,0xb6,0x1b,0x3b,0x2e,0x8b,0x85,0x59,0x04,0x1c,0x88,0x22,0x46,
+  0x8c,0x7e,0x60,0xa2,0xd7,0xff,0xfc,0xe3,0x7f,0xcb,0x64,0xa4,0xd1,0x4a,0x1a,0x5e,
+  0x31,0x28,0x1c,0xbe,0x21,0x3f,0x64,0x70,0x52,0x50,0xb1,0x04,0x77,0x0e,0x01,0xf9,
+  0x23,0x30,0x30,0xb0,0x21,0x98,0xaf,0x83,0xbc,0x62,0x2e,0x88,0x60,0xc8,0x0f,0xb1,
+  0x92,0x28,0x82,0xc4,0x2c,0x00,0x67,0x3e,0x9b,0x04,0x3c,0x38,0xf5,0x6d,0xf6,0x40,
+  0xb0,0x48,0xea,0x7e,0xe2,0x8d,0x58,0x44,0xc0,0x25,0xfa,0x7e,0xea,0x1f,0xe9,0x9b,
+  0x23,0x74,0x4d,0xd9,0xab,0x0e,0xe2,0x2d,0xb9,0xeb,0x27,0xa0,0x68,0xe0,0xcf,0x0a,
+  0x47,0x09,0xeb,0x6c,0xf2,0x94,0x34,0xd7,0x06,0xdb,0x9f,0x31,0x1e,0x39,0x96,0xb2,
+  0xb9,0x74,0x95,0x05,0xd9,0xc8,0x49,0x83,0x84,0x6f,0x9b,0xf8,0x7b,0x24,0x7f,0x8f,
+  0xe0,0xd7,0x33,0x1f,0xaa,0x24,0x81,0xda,0x4c,0x1c,0x9f,0xf0,0x29,0x13,0x35,0x3d,
+  0xf5,0x70,0xea,0x31,0x4f,0x52,0x5c,0xf2,0xd9,0x06,0x21,0x8e,0x5d,0x07,0xcc,0x59,
+  0x76,0xbc,0x25,0xc7,0x56,0xb8,0x7e,0xc1,0x31,0xe3,0x88,0xc5,0x53,0x43,0x7d,0x33,
+  0x1b,0x6d,0x0a,0x37,0x0c,0xce,0xe3,0xc0,0xf3,0x4c,0xdf,0x5e,0x99,0x82,0x1d,0xd7,
+  0x1c,0x31,0xd7,0x18,0x42,0x15,0x61,0xbc,0xd5,0x69,0xc8,0x2e,0x58,0x5d,0x54,0x04,
+  0x91,0x20,0x62,0xca,0xe8,0x04,0x21,0x77,0x40,0x14,0x95,0xa4,0xdd,0x7e,0x9f,0x1a,
+  0x5d,0xd7,0xed,0x34,0xe4,0x38,0x3a,0x41,0xa0,0x18,0xab,0xa3,0x36,0x8f,0x1a,0xcb,
+  0xb3,0x09,0xd6,0x5e,0xfd,0xf0,0x5d,0x39,0x24,0x58,0x7d,0x52,0x27,0x83,0x61,0xf7,
+  0x6a,0x08,0xe6,0x1f,0x0c,0x2f,0x2e,0xe1,0xf3,0xf1,0xe2,0xac,0x87,0xbd,0xee,0x90,
+  0x9c,0xf7,0x7e,0x59,0x91,0xde,0xbe,0x2d,0x74,0xcc,0x6d,0x91,0x86,0x4b,0x0c,0xa3,
+  0xcf,0x47,0xcb,0xea,0x38,0x31,0xfd,0xc4,0x74,0xc9,0x3f,0x82,0x09,0xd1,0x42,0xb0,
+  0x74,0x4c,0xc0,0x7a,0x04,0xc5,0x5c,0x57,0xc6,0x04,0x53,0x39,0x80,0xf5,0xdc,0x18,
+  0x70,0x16,0x0a,0x25,0x5b,0x59,0x15,0xc9,0x0d,0x0a,0x6b,0x78,0x38,0x80,0x39,0x18,
+  0x2c,0xdb,0x14,0xd6,0xfe,0xfd,0xcc,0x9e,0x8b,0x93,0x6f,0xa1,0xe6,0x09,0x12,0xcc,
+  0x36,0xde,0xae,0x85,0xda,0x6f,0x02,0x8d,0xe6,0xda,0xe9,0x83,0xb7,0xd4,0x38,0xd8,
+  0x84,0x2d,0xd0,0x8b,0xf8,0xa9,0x57,0x77,0xd6,0x15,0xa3,0x45,0xd5,0xbb,0x9f,0x72,
+  0x9d,0x95,0xaf,0xe4,0x2c,0x45,0x03,0x52,0x34,0x80,0xf9,0x7b,0x1f,0x96,0x44,0x63,
+  0xd7,0x35,0xa3,0xa8,0x4d,0xba,0x9f,0x96,0x0b,0xd1,0x32,0xc6,0x95,0x33,0x99,0x72,
+  0x20,0x4e,0x76,0x23,0xc4,0x2a,0xa0,0x6c,0x29,0x57,0xaf,0xff,0xac,0x5c,0xcc,0x3d,
+  0x09,0xee,0x7d,0x63,0xd7,0x16,0x72,0xf5,0xfa,0xcf,0xcb,0xc5,0xdc,0xeb,0x10,0x28,
+  0x93,0xdd,0x64,0x41,0xa8,0x34,0x0a,0xbf,0x06,0x93,0xad,0x16,0x97,0x67,0x83,0x71,
+  0x30,0xec,0x5d,0x12,0xd7,0xf1,0x1c,0x55,0x3a,0x96,0x15,0x16,0x99,0x5b,0xf6,0x04,
+  0xe9,0x23,0xc2,0xca,0xac,0x06,0x1f,0xe0,0x5c,0x9a,0xd6,0xc6,0xc5,0x79,0x9e,0xc9,
+  0x2a,0x28,0xb2,0x70,0xbb,0xf8,0xf1,0xc7,0xe5,0x34,0x5f,0xcd,0x10,0x8a,0x7f,0xca,
+  0x2d,0xcf,0x78,0xf3,0xf7,0x33,0xac,0xa1,0x85,0x35,0x02,0x53,0x00,0x16,0x09,0x15,
+  0x76,0xb5,0xfd,0xf7,0x4d,0xba,0x62,0xc5,0x58,0xc7,0xc3,0x7c,0x58,0xc9,0xc3,0x7c,
+  0xd8,0xc0,0xe3,0xed,0x9b,0x75,0x2c,0xd6,0xc4,0xcf,0x12,0x67,0x70,0xf3,0x7a,0x73,
+  0x32,0xb7,0x64,0xce,0x82,0xed,0x96,0xec,0xba,0xb5,0x39,0x81,0xe1,0x4a,0x73,0x32,
+  0x77,0xb3,0x39,0xb7,0xb6,0x25,0x32,0x58,0x65,0x4b,0x60,0xb0,0xd1,0x96,0xeb,0xdd,
+  0xb5,0xcd,0x86,0x05,0x6b,0xa3,0x30,0x56,0x37,0x0c,0xdd,0x47,0x43,0xfc,0x12,0x1e,
+  0x10,0xb9,0x04,0xad,0xdb,0x94,0x64,0x58,0x03,0x91,0x44,0xc6,0x3f,0x13,0x16,0x3d,
+  0x12,0xd9,0x59,0x91,0x77,0x22,0x53,0xb6,0xc8,0xbc,0x4d,0x4b,0xe7,0x14,0x8e,0x6e,
+  0x56,0xb2,0x36,0xdf,0x96,0x6a,0x3e,0x2c,0x14,0xe0,0xd2,0x35,0x55,0xe6,0xb7,0xc4,
+  0xb1,0x6e,0x89,0x6d,0x72,0xb3,0x06,0x0b,0xa0,0x4e,0xc5,0x3a,0x47,0x0d,0xf1,0x59,
+  0x57,0x67,0x96,0x71,0x2e,0x2e,0x11,0xe5,0xe2,0x72,0x5b,0x0c,0x5c,0x3e,0xa9,0x81,
+  0xbf,0x2f,0xc1,0x20,0x83,0xde,0x50,0x62,0x61,0x6b,0x6b,0xe9,0xd2,0x35,0x5a,0x35,
+  0x5e,0x5e,0xa2,0xfb,0x26,0x9c,0x45,0xb6,0xb4,0x5f,0xbf,0x3b,0xe8,0x5d,0x11,0x48,
+  0x25,0x2a,0xf3,0x69,0x3b,0x19,0x15,0xd6,0x39,0x15,0x79,0xf9,0x12,0x9c,0xe1,0x55,
+  0xf7,0xf8,0x67,0x6a,0x88,0xcf,0xcb,0x35,0x13,0xfb,0x81,0xb5,0x2b,0xe3,0xb2,0x9f,
+  0xa1,0xd6,0x43,0xa1,0xab,0x89,0xf5,0x58,0x35,0xb6,0x0f,0x92,0x0c,0x39,0xc5,0x7d,
+  0x29,0xaa,0xc2,0xdc,0xfb,0x16,0xcc,0x0c,0xb5,0xf9,0x8d,0x56,0x5a,0xbb,0x4e,0xaf,
+  0xe4,0x09,0x25,0x4c,0x5a,0x49,0x35,0x5e,0x24,0xb0,0xc4,0x49,0x71,0x5f,0x8a,0xaa,
+  0x30,0xf7,0xbe,0x05,0x33,0x43,0xfd,0x06,0x2b,0x75,0x13,0xdb,0x09,0xb6,0xb4,0x51,
+  0xf7,0xfa,0xe4,0xf4,0x82,0x9c,0x9e,0xf4,0x7b,0x67,0xd7,0xc3,0x9e,0x08,0xfc,0x53,
+  0xdb,0x65,0x67,0x09,0x9c,0x3f,0xb7,0xcf,0x80,0x45,0x2a,0x98,0x74,0x39,0x99,0xed,
+  0xb3,0xef,0x87,0x1e,0xe8,0x3f,0xec,0x0d,0xa0,0xb8,0x64,0xcd,0x65,0xfd,0xd7,0x57,
+  0xe4,0x2e,0x14,0xd8,0x89,0xef,0x65,0xc7,0xa7,0x9d,0xf4,0xfc,0x64,0xe6,0x13,0x6b,
+  0x8f,0x62,0xb1,0x15,0x39,0x21,0xac,0xb3,0xe3,0xc4,0xb7,0xc4,0x12,0xfd,0xab,0xf6,
+  0x5b,0x65,0x16,0x31,0x9e,0x44,0x3e,0xb1,0x03,0x2b,0x41,0xf4,0xfa,0x6f,0xb8,0xac,
+  0x0c,0xc4,0x92,0x1c,0x44,0x00,0x30,0x6f,0xe7,0x08,0x78,0xa2,0xd0,0xe4,0x69,0xa8,
+  0x0a,0xfa,0x54,0xad,0x51,0xd5,0x0f,0x7e,0x31,0x1d,0x5e,0x99,0x8d,0x19,0xb7,0xa6,
+  0x1a,0x6d,0x20,0xc8,0x07,0x09,0x02,0xdb,0xc4,0x3d,0xe6,0xe3,0x5d,0xd6,0xf5,0xd5,
+  0x29,0x9c,0xc0,0xc2,0xc0,0x07,0x06,0x0a,0xbf,0xb2,0x47,0x77,0x85,0x49,0x56,0x81,
+  0xc0,0x44,0xa5,0x52,0x87,0x23,0xa7,0xaf,0x45,0xba,0x11,0xd5,0xf1,0x2a,0x49,0x4b,
+  0x47,0xb8,0x6e,0xcc,0x5c,0xc6,0x89,0xa7,0x37,0xfe,0x73,0xf1,0x33,0x79,0xa5,0xfd,
+  0xdb,0xde,0xab,0x34,0xea,0xec,0x81,0x59,0x1a,0xaf,0xb4,0x89,0x33,0xd6,0xfe,0xe6,
+  0x3d,0x3d,0xa5,0x82,0x59,0xa3,0xdd,0x5d,0x6b,0x84,0x33,0x52,0xd3,0xf6,0x9c,0x20,
+  0x36,0x9c,0x5a,0x59,0xac,0x37,0xdb,0xa2,0x13,0x06,0xae,0xab,0x6b,0x15,0xdd,0x28,
+  0x69,0xe1,0xa0,0x74,0xde,0xe7,0xfd,0x2f,0x6b,0x45,0x81,0x91,0x19,0xb0,0x8b,0xf0,
+  0xd2,0x2d,0xe2,0xf1,0x2f,0x0e,0x07,0xe4,0xcb,0xde,0xf9,0xc9,0xe9,0xf9,0x4f,0xb4,
+  0xb2,0xbb,0xbb,0xb7,0x27,0xd8,0x74,0xf6,0x9b,0x15,0xb0,0x9d,0xb8,0x87,0x09,0x12,
+  0xae,0x21,0xbb,0x2a,0x44,0x3e,0x08,0xcb,0xdc,0x98,0x11,0x25,0x62,0x54,0x69,0xcf,
+  0x2b,0x75,0xcb,0x44,0x11,0x98,0x6e,0xa8,0x51,0xda,0xbb,0xba,0x22,0x60,0xa5,0x0a,
+  0x40,0x2f,0xd2,0x78,0xdb,0x7c,0x0e,0x65,0x9e,0x3b,0x2f,0x92,0x67,0x66,0x2d,0xf7,
+  0x95,0x3a,0x74,0xd3,0xa2,0x7e,0x5f,0xe3,0xc0,0xcf,0xf4,0x73,0x9d,0x38,0xb5,0x76,
+  0xac,0xff,0xaa,0xd1,0x57,0xd2,0x77,0x14,0x45,0xa9,0x3b,0xbe,0xcf,0xa2,0x8f,0xc3,
+  0xb3,0xbe,0x4e,0xcb,0x87,0x28,0x38,0x18,0x97,0xce,0xc5,0x54,0x1a,0x19,0x82,0x50,
+  0xd0,0xc8,0xb8,0xca,0x61,0xbc,0x51,0xd6,0x29,0xc2,0x00,0xb3,0xfa,0x38,0x88,0x7a,
+  0x26,0x08,0x67,0x01,0xdb,0x02,0x8b,0x3d,0xfd,0x66,0xe1,0xa0,0xf6,0x7a,0x66,0xd5,
+  0x9d,0x70,0x4e,0x0d,0x6c,0xe0,0xc5,0xc4,0xd3,0x93,0x18,0xc8,0xb8,0xde,0xb4,0x05,
+  0x69,0xc4,0xc4,0xf0,0x5f,0x00,0x23,0xea,0xf6,0x43,0x53,0x74,0x2a,0xe9,0xbd,0x46,
+  0x36,0x11,0x33,0xe6,0x13,0x9c,0x8d,0x99,0x15,0xcf,0xe3,0x0c,0x40,0x66,0xd3,0xcd,
+  0x5c,0x45,0x9a,0x90,0xda,0x65,0xfe,0x84,0x4f,0x2b,0x4a,0x97,0x8e,0x63,0x9c,0x07,
+  0x44,0xa9,0x49,0x1e,0x19,0xaf,0x93,0xe1,0x94,0x3d,0x12,0xbc,0x28,0x33,0x23,0x62,
+  0x8e,0x39,0xec,0x27,0x3f,0xf6,0xfa,0xfd,0x8b,0xc6,0x25,0x04,0x4a,0xbd,0xd3,0x70,
+  0xd0,0x46,0x40,0xb6,0x60,0x53,0x24,0x05,0xbe,0x2d,0x3a,0x50,0x5c,0xff,0x14,0xdc,
+  0x27,0xfa,0xeb,0x9d,0xe7,0xf8,0xe3,0x40,0x39,0x2f,0x35,0xbd,0xc2,0x28,0x18,0x5e,
+  0x1a,0x07,0x6f,0xc5,0xe2,0x16,0x68,0x8b,0x38,0x4a,0x9b,0xb9,0x52,0x34,0x35,0x23,
+  0xed,0x24,0x2e,0x8a,0x29,0x40,0x52,0x37,0x8d,0x15,0x03,0x2b,0xd6,0xb5,0x71,0x5d,
+  0x5c,0x25,0x19,0x7a,0xf3,0x43,0xda,0xde,0x83,0x4d,0xb2,0xc9,0xe3,0x2a,0x04,0xe3,
+  0xb8,0x2e,0xee,0xbb,0x98,0x0d,0x63,0xaa,0x25,0x87,0x21,0x75,0x5c,0x86,0x80,0xf8,
+  0xa5,0x95,0x96,0x46,0x6b,0x30,0x0e,0x14,0xf0,0xf2,0xe0,0xe9,0xa9,0x09,0x85,0x82,
+  0xfc,0x40,0x31,0xfa,0x53,0x77,0xba,0x8e,0xf1,0xea,0xf5,0x0c,0x08,0xda,0x0f,0x73,
+  0x14,0x7a,0x2c,0x1c,0x3b,0x27,0x7f,0xfe,0xf1,0x5f,0x74,0x58,0x0c,0x92,0x03,0x88,
+  0xf0,0x50,0x2a,0x7a,0x43,0xca,0xfe,0xac,0x89,0xd5,0x6d,0x56,0xc1,0xc8,0x6a,0x64,
+  0xbd,0x99,0x3d,0x65,0x02,0x58,0xaa,0x62,0x19,0xc7,0xd0,0x31,0x6d,0x5b,0xd7,0xe2,
+  0xc8,0xaa,0x06,0x50,0x54,0x2e,0x46,0x5f,0xa1,0x98,0xd6,0x6f,0xd9,0x63,0xac,0x05,
+  0x95,0xcc,0x76,0xb7,0x0a,0xf1,0x4e,0x0f,0x3e,0xdf,0x7e,0x91,0xd1,0x74,0x27,0xed,
+  0x56,0x21,0xaa,0x56,0x09,0xaa,0xa8,0x33,0x8f,0x8c,0x0e,0xb7,0x21,0x8a,0x81,0x28,
+  0xe8,0x07,0x4d,0xd9,0xbd,0x2d,0x76,0x14,0x76,0x79,0x28,0x7c,0xdb,0x5c,0x18,0x38,
+  0x5a,0x1a,0x38,0x2a,0x0f,0xc0,0x91,0x48,0x0d,0x34,0x80,0xef,0x0d,0xda,0x08,0x35,
+  0xd2,0x68,0x2c,0x2e,0xbb,0x69,0xd5,0xab,0xcb,0x16,0x8c,0x7b,0x75,0x2f,0xb0,0x13,
+  0x08,0x9f,0x62,0xea,0x22,0x70,0x31,0xdd,0xaa,0x56,0x5d,0xd9,0x11,0xfd,0x88,0x91,
+  0x98,0x9b,0x35,0xf7,0x07,0xea,0xfa,0x01,0x54,0xc5,0xa7,0x08,0x90,0x45,0xde,0xbc,
+  0x0b,0xc5,0xa7,0xc6,0x20,0x48,0x22,0x8b,0x81,0x3c,0x53,0xd1,0x95,0xf7,0x98,0x59,
+  0xd7,0xcf,0x5a,0xa0,0x6d,0xde,0x3e,0x2a,0xb6,0x8f,0xb2,0xb6,0x38,0xf1,0x61,0x1b,
+  0xb5,0xc3,0x96,0x64,0x24,0xee,0xf8,0x5f,0xcf,0x50,0x0a,0xd4,0x5e,0x74,0xe1,0x2b,
+  0xa4,0xb9,0x69,0xa9,0xac,0x8e,0x4d,0x2f,0x04,0x65,0x45,0x56,0xcb,0xbc,0x9d,0x2f,
+  0x14,0x59,0x88,0xed,0xa8,0xb0,0x4c,0x7f,0x43,0xb9,0x85,0x40,0x28,0x54,0x15,0x5d,
+  0xd7,0x9b,0x95,0x19,0xda,0xac,0xb0,0xc6,0x97,0xec,0xb6,0xa2,0xe0,0x48,0xd1,0x4a,
+  0x0b,0x5e,0x1e,0x9f,0x8b,0x75,0x56,0x94,0x77,0x93,0xeb,0x56,0x1d,0x36,0x1b,0x7c,
+  0x60,0xf2,0xa7,0x27,0x5a,0x53,0x81,0x0c,0x39,0xa6,0x6b,0xd9,0x84,0xb8,0xea,0xc6,
+  0x04,0x2f,0x8f,0xb4,0x00,0x5c,0x15,0x15,0xac,0x30,0x29,0x02,0x56,0x95,0xe3,0x24,
+  0x8a,0x83,0x48,0xd4,0x84,0xc5,0xc1,0xbd,0xfd,0x4a,0x01,0xf1,0x1e,0x0c,0x90,0x22,
+  0x4a,0xf3,0x0d,0xa0,0xee,0xe6,0xbc,0xf2,0xb1,0x3d,0x1a,0x53,0x85,0xb8,0x94,0x1d,
+  0x0b,0x4b,0x41,0x16,0xd3,0x8b,0x7d,0x50,0xb7,0xd8,0xc5,0x4a,0x52,0xe8,0xa2,0x12,
+  0xc5,0x3e,0xca,0xb6,0x94,0x10,0x9b,0x3c,0xb2,0x26,0x88,0xcf,0x44,0xa6,0x64,0x71,
+  0x78,0x7a,0x99,0x35,0xb3,0x37,0x91,0xe2,0xc8,0xa9,0xfd,0x90,0x75,0xd1,0x6c,0xaf,
+  0xb2,0x9e,0x34,0x06,0xb3,0x5f,0x1c,0xc6,0x32,0x5a,0xb3,0xbd,0x1e,0xe4,0x69,0xef,
+  0x0e,0x1a,0x7d,0x08,0x09,0x06,0xc2,0x6b,0xf4,0xe4,0xe2,0xec,0x58,0xbe,0xd4,0xe2,
+  0x2e,0x92,0xd9,0xb4,0x8a,0xdb,0x22,0x11,0x7e,0xea,0xb2,0x19,0x14,0x5d,0x46,0x83,
+  0xd8,0xb3,0x6e,0x15,0xac,0xd8,0x5d,0x95,0x76,0x0b,0x75,0xb1,0x66,0x4b,0x3f,0x5b,
+  0x72,0x0f,0xe0,0xd9,0xf9,0x30,0x16,0x3e,0x4b,0x86,0xb8,0xba,0xb2,0xc6,0x14,0x81,
+  0x7d,0xd6,0x71,0xfa,0x66,0xdc,0xc3,0x67,0x51,0x62,0x12,0x4b,0x5e,0xe3,0x17,0x22,
+  0x5b,0xee,0x48,0xab,0x56,0x55,0xf3,0x80,0xf7,0x7a,0x12,0x5e,0x25,0x73,0x5a,0xfe,
+  0x8c,0xb0,0x49,0x15,0xb5,0x5b,0xca,0x71,0xd2,0xd7,0xa3,0x67,0xf5,0x4f,0xd3,0xdd,
+  0x07,0x84,0xb1,0x44,0xd8,0xb0,0x93,0xcd,0x96,0xe5,0x65,0x99,0x79,0x3b,0x5d,0xf2,
+  0x85,0xdb,0x8a,0xe2,0xe3,0xbb,0xd4,0xd6,0x82,0x44,0x29,0xf8,0x77,0x17,0x03,0x1f,
+  0xdc,0x5e,0x20,0x86,0x02,0xff,0xce,0x62,0xe0,0x63,0xd9,0x56,0x41,0xe9,0xe8,0x21,
+  0xfe,0xa9,0xc2,0x29,0x1c,0x30,0x10,0x35,0x7b,0xbb,0x4b,0x23,0x11,0xca,0x5e,0x93,
+  0xc2,0xbe,0x5c,0xed,0xec,0x9c,0xca,0x26,0x71,0x54,0x4c,0xca,0x47,0xbc,0x3c,0x1e,
+  0x53,0x65,0x91,0xf8,0x07,0x31,0x09,0x67,0x08,0xe7,0xfb,0xe9,0xbc,0xfa,0x98,0x06,
+  0xbb,0x6d,0x8d,0xd6,0xc5,0x61,0x93,0xe6,0x1b,0x8c,0x11,0x10,0x1f,0xfd,0xc5,0x64,
+  0x1d,0xd5,0x61,0xb0,0xcb,0x61,0xb5,0x85,0x43,0x2a,0xd3,0x68,0x7a,0x94,0x15,0x47,
+  0x80,0x17,0xe5,0xde,0x5c,0x15,0xfa,0xaf,0xc1,0x04,0xcf,0x30,0x91,0xee,0x27,0xae,
+  0x0b,0xfa,0xa5,0x2b,0x27,0x8c,0x0f,0xf0,0x14,0x25,0x0e,0x7f,0xcf,0xc8,0x15,0x41,
+  0xb9,0xd4,0xdf,0x37,0x85,0x9f,0x52,0x7a,0x15,0x58,0x00,0x61,0x7b,0x7d,0x8a,0x6e,
+  0x01,0xd0,0x7c,0x5c,0x06,0x8a,0x7c,0x86,0x58,0x74,0x22,0x8c,0x4e,0xe4,0x51,0x19,
+  0xd6,0xbb,0x4c,0x32,0x38,0x66,0x65,0x64,0x84,0x95,0x52,0x4d,0xe1,0xc8,0x2b,0x74,
+  0xdd,0x50,0xab,0xbc,0xf6,0xbc,0xca,0xa3,0x84,0x81,0xc2,0x55,0x14,0xb3,0x82,0x41,
+  0x51,0xd2,0x31,0x08,0x61,0x4f,0x50,0x92,0x7c,0xb6,0x56,0xf2,0x05,0x63,0xad,0x57,
+  0x04,0xf6,0x21,0x05,0x3e,0x23,0x88,0xbc,0x8f,0x81,0x6b,0x6b,0x90,0x1e,0x55,0x02,
+  0x62,0xff,0x90,0x38,0xf8,0xc2,0x58,0x99,0x7d,0xa6,0x5e,0x90,0xc4,0xcc,0x0e,0xee,
+  0x7d,0x5a,0xa5,0x3c,0x48,0xac,0xa9,0x38,0xbb,0xd2,0x2f,0x59,0xd8,0xb0,0x3b,0xdd,
+  0x00,0xbc,0xe5,0xc0,0x61,0x77,0x55,0x8d,0xa1,0xf6,0xac,0x1e,0x46,0x0c,0xa7,0x4e,
+  0xd8,0xd8,0x4c,0x5c,0x08,0xe7,0x76,0xc9,0x7d,0x8a,0x9b,0x86,0xe7,0x4f,0xdc,0xf0,
+  0x29,0xa6,0x49,0x08,0x2c,0x45,0x0b,0xd4,0xbd,0x63,0x29,0x7f,0x5c,0x53,0x54,0x13,
+  0xea,0x83,0xc5,0xdc,0xef,0x23,0x0b,0x9a,0x59,0xb2,0x9f,0xe7,0xf6,0x10,0x8b,0xb6,
+  0x78,0x7b,0xa3,0x95,0x2a,0xc9,0x32,0xc0,0x17,0x91,0x96,0xbe,0x4a,0xe6,0xb1,0xa6,
+  0xee,0x46,0xf2,0x1b,0x45,0xba,0xe7,0x8b,0x40,0x5e,0x20,0x28,0x9e,0xe6,0x80,0xe2,
+  0x8b,0x09,0xae,0xa4,0x27,0x1f,0xe1,0x5e,0x4c,0x0e,0xef,0xf0,0xd6,0xd0,0xbb,0x0e,
+  0x51,0x5d,0xf2,0x62,0x7a,0x29,0xb9,0x6c,0xf9,0x17,0xd7,0x0f,0xdb,0x15,0xdb,0x38,
+  0x10,0x4c,0xe0,0x9b,0xd2,0xaf,0x43,0x15,0xf1,0xb4,0xb4,0xba,0xc6,0x81,0xac,0xaf,
+  0xea,0xaf,0x4f,0x56,0x97,0xd7,0xd3,0xc1,0x85,0xf8,0x4b,0x13,0x04,0x5a,0x51,0x65,
+  0x21,0x51,0x71,0xe6,0x03,0x32,0x5b,0x79,0x91,0x84,0x5c,0x9e,0x2d,0xbe,0xab,0x25,
+  0xe0,0xa5,0x9b,0x95,0x4d,0x92,0xaa,0xcb,0x16,0x61,0xa9,0xec,0x92,0x25,0xaf,0xdc,
+  0xab,0xce,0x04,0xed,0xfc,0xa4,0x29,0x6e,0x75,0xca,0xe5,0xe6,0x1b,0x88,0xcc,0xab,
+  0xe4,0xb0,0xd9,0x14,0xd7,0x41,0xed,0x9d,0xd4,0x5d,0xa5,0x67,0xa6,0x67,0xbd,0xb6,
+  0xb3,0xb6,0xe6,0x8a,0x19,0x48,0x1b,0x5d,0xa5,0x0f,0xd2,0x4c,0x27,0xe1,0x78,0x42,
+  0x2f,0xce,0xa9,0x84,0x61,0xae,0x84,0x51,0x6f,0x81,0x2b,0x61,0xc4,0x53,0xa8,0xa2,
+  0x04,0xad,0x14,0xa6,0x4a,0xc4,0xfb,0x65,0x3a,0x61,0x3e,0x94,0xb9,0x8b,0x17,0x3f,
+  0x45,0xbb,0x84,0x25,0x5e,0xea,0xd2,0x89,0x22,0x96,0xaa,0xd9,0x9f,0x6f,0x44,0x30,
+  0xf7,0x4f,0xcf,0x4e,0x87,0x98,0x71,0xaf,0x67,0x82,0xed,0x5c,0x36,0xe0,0xa0,0x7b,
+  0x53,0x2d,0x42,0x40,0xd0,0xbf,0x9e,0x09,0x16,0x73,0xd9,0x58,0x84,0x18,0xa4,0x44,
+  0xfa,0x1f,0x50,0xa7,0x16,0xc5,0xbb,0xe0,0x45,0x10,0x45,0xa5,0x0c,0xf2,0xa5,0xfe,
+  0x35,0x70,0x7c,0x8d,0xb6,0x21,0x17,0x3d,0x15,0x7a,0xe9,0x23,0xdd,0xf2,0x22,0x02,
+  0x6e,0x5c,0xe5,0x4a,0xf9,0xdc,0xf7,0x17,0x7c,0x99,0xae,0xda,0xb4,0xa0,0xf4,0x60,
+  0xd8,0x1d,0x5e,0x0f,0xe8,0xf6,0x52,0x75,0x1a,0xe9,0x5d,0x72,0xa7,0xa1,0x0e,0x18,
+  0xf2,0xef,0x43,0xff,0x0f,0x19,0x9d,0x8a,0x4d,0x30,0x2a,0x00,0x00,
+};
@@ -8,6 +8,19 @@
 #include <SPI.h>
 #include <ArduinoJson.h>
 #include <RTClib.h>
+#include "SatCatalog.h"
+#include "SatIndex.h"
+#include "PassScheduler.h"
+#include "AssignPlanner.h"
+#include "TimeSync.h"
+#include "ModuleLink.h"
+#include "HttpServer.h"
+#include "JsonWriter.h"
+#include "CmdFanout.h"
+#include "Metrics.h"
+#include "WebUi.h"
+#include "NetProto.h"
+#include "src/sgp4batch/Sgp4Batch.h"
 
 RTC_DS3231 rtc;
 
@@ -23,35 +36,54 @@ const char* password = "123456789";
 SPIClass spiSD(VSPI);
 
 // Network
-WiFiServer httpSrv(80);        // client modules & web UI
-WiFiUDP    udpTime;            // time broadcaster
-WiFiUDP    udpCmd;             // command relay to clients
+const int  HTTP_PORT     = 80;               // web UI (own task, see HttpServer); modules use ModuleLink
 WiFiUDP    udpReg;             // client HELLO/PING registrar
 
-const int  UDP_TIME_PORT = 4210;             // time broadcast
+const int  UDP_TIME_PORT = 4210;             // time sync (binary, see NetProto.h)
 const int  UDP_CMD_PORT  = 4212;             // commands to clients
 const int  UDP_REG_PORT  = 4213;             // HELLO/PING from clients
 const IPAddress broadcastIP(192,168,4,255);
 
-//Data
-static StaticJsonDocument<8192> doc; // one file at a time (keep each file modest, e.g., 50–150 sats)
-int   satIndex = 0;
+// Satellite data, client table and scheduler are shared by loop() and the HTTP task
+static SemaphoreHandle_t gStateLock = nullptr;
+struct StateLock {
+  StateLock()  { xSemaphoreTake(gStateLock, portMAX_DELAY); }
+  ~StateLock() { xSemaphoreGive(gStateLock); }
+};
+
+//Data (all sources are indexed at startup, see SatIndex)
+const char* SAT_CATALOG_PATH = "/sat_catalog.bin"; // preferred: fixed-record binary catalog, read one record per assignment
+int   satIndex = 0;    // round-robin position in the satellite index
 double currentLat = 0.0, currentLon = 0.0, currentAlt = 0.0;
 
-unsigned long lastBroadcast = 0;
-const unsigned long broadcastInterval = 100; // interval of sending time to clients in ms
-const long MAX_TLE_AGE_SECONDS = 3600L * 6;  // 6 hours max
+const long TLE_MAX_AGE_DEFAULT_S = 3600L * 72;  // TLE epoch age served (location.json "max_tle_age_h", /tleage)
+const uint32_t TLE_RECHECK_MS = 600000UL;       // re-evaluate freshness this often
+long maxTleAgeS = TLE_MAX_AGE_DEFAULT_S;
+unsigned long lastTleCheckMs = 0;
+
+// Whole-constellation look angles (GET /visible): the served satellites in one SGP4 batch,
+// rebuilt lazily after the valid list changed
+// Batch size comes from the heap at build time (~185 B per satellite on the ESP32);
+// /visible says when that is fewer than the satellites served
+const uint32_t VISIBLE_HEAP_RESERVE = 48 * 1024;   // left free for HTTP, links and the scheduler
+const int VISIBLE_SAT_BYTES = SGP4B_SAT_BYTES + 3 * sizeof(float);
+const int VISIBLE_LIST_MAX = 48;     // satellites listed per response
+Sgp4Batch visBatch;
+float* visAz = nullptr; float* visEl = nullptr; float* visRange = nullptr;
+uint32_t visGeneration = 1, visBuiltGeneration = 0;
+int visLoaded = 0;   // served satellites the batch was built from (positions 0..visLoaded-1)
 
 //Multi-file list (auto-detected)
 struct SatFile {
   String name;   // "/sat_data_1.json" etx.
   int    index;  // extracted number (1,2,3…)
   uint32_t size;
-  int count;     // count of satellites in file (filled on load)
+  int count;     // satellites found in the file (filled when indexed)
+  bool binary;   // true for the binary catalog
 };
 SatFile satFiles[24];
 int satFilesCount = 0;
-int satFileCursor = 0; // which file we’re serving (0-based into satFiles[])
+int satFileCursor = 0; // file of the satellite served last (0-based into satFiles[])
 
 // Track connected clients for UI targeting & assignment display
 struct ClientInfo {
@@ -64,10 +96,18 @@ struct ClientInfo {
   int    lastSatIndex = -1;
   int    lastFileCursor = -1;
   unsigned long lastAssignMs = 0;
+
+  // latest metric summaries from the module's PING
+  MetricSummary metrics[METRIC_CLIENT_MAX];
+  int           metricCount = 0;
 };
 ClientInfo clients[16];
 int clientsCount = 0;
 
+const uint32_t CLIENT_PING_MS   = 4000;                        // modules PING this often
+const uint32_t CLIENT_ACTIVE_MS = 2 * CLIENT_PING_MS + 1000;   // /send ALL waits only for modules seen this recently
+const uint32_t CLIENT_EXPIRE_MS = 60000;                       // dropped from clients[] after this long silent
+
 DateTime parseDateTime(const char* isoTime) {
   int y, M, d, h, m, s;
   if (!isoTime || strlen(isoTime) < 19) return DateTime((uint32_t)0);
@@ -91,10 +131,26 @@ void upsertClient(IPAddress ip, const String& name = String()) {
     clients[clientsCount].lastSatIndex = -1;
     clients[clientsCount].lastFileCursor = -1;
     clients[clientsCount].lastAssignMs = 0;
+    clients[clientsCount].metricCount = 0;
     clientsCount++;
   }
 }
 
+// Forget modules that stopped sending PINGs (powered off, left the network)
+void pruneClients() {
+  unsigned long now = millis();
+  int k = 0;
+  for (int i=0;i<clientsCount;i++) {
+    if (now - clients[i].lastSeenMs > CLIENT_EXPIRE_MS) {
+      Serial.printf("👋 %s (%s) silent, dropped\n", clients[i].ip.toString().c_str(), clients[i].name.c_str());
+      continue;
+    }
+    if (k != i) clients[k] = clients[i];
+    k++;
+  }
+  clientsCount = k;
+}
+
 void recordAssignmentFor(IPAddress ip, const String& satName, int satIdx, int fileCursor) {
   for (int i=0;i<clientsCount;i++){
     if (clients[i].ip == ip) {
@@ -107,70 +163,128 @@ void recordAssignmentFor(IPAddress ip, const String& satName, int satIdx, int fi
   }
 }
 
-String buildTimePayload() {
-  DateTime now = rtc.now();
-  char buffer[25];
-  snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02dZ",
-           now.year(), now.month(), now.day(),
-           now.hour(), now.minute(), now.second());
-  return String("{\"current_time_utc\":\"") + buffer + "\"}";
+// Value of 'key' in a query string, %XX and '+' decoded ("" if absent)
+String queryParam(const String& query, const char* key) {
+  String k = String(key) + "=";
+  int a = query.startsWith(k) ? 0 : query.indexOf("&" + k);
+  if (a < 0) return String();
+  if (a > 0) a++;
+  int b = query.indexOf('&', a);
+  String raw = query.substring(a + k.length(), b < 0 ? query.length() : b);
+  String out;
+  for (size_t i=0;i<raw.length();i++) {
+    char ch = raw[i];
+    if (ch == '+') ch = ' ';
+    else if (ch == '%' && i+2 < raw.length() && isxdigit((unsigned char)raw[i+1]) && isxdigit((unsigned char)raw[i+2])) {
+      char hex[3] = { raw[i+1], raw[i+2], 0 };
+      ch = (char)strtol(hex, nullptr, 16);
+      i += 2;
+    }
+    out += ch;
+  }
+  return out;
 }
 
-String createSatellitePayload(JsonObject& sat) {
-  DateTime now = rtc.now();
-  char timestamp[25];
-  snprintf(timestamp, sizeof(timestamp), "%04d-%02d-%02dT%02d:%02d:%02dZ",
-           now.year(), now.month(), now.day(),
-           now.hour(), now.minute(), now.second());
-
-  String s = "{";
-  s += "\"current_time_utc\":\"" + String(timestamp) + "\",";
-  s += "\"id\":" + String(sat["id"].as<int>()) + ",";
-  s += "\"name\":\"" + String(sat["name"].as<String>()) + "\",";
-  s += "\"latitude\":" + String(currentLat) + ",";
-  s += "\"longitude\":" + String(currentLon) + ",";
-  s += "\"distance_km\":" + String(sat["distance_km"].as<double>()) + ",";
-  s += "\"elevation_deg\":" + String(sat["elevation_deg"].as<double>()) + ",";
-  s += "\"datetime_utc\":\"" + String(sat["datetime_utc"].as<String>()) + "\",";
-  s += "\"tle\":{";
-  s += "\"line-1\":\"" + String(sat["tle"]["line-1"].as<String>()) + "\",";
-  s += "\"line-2\":\"" + String(sat["tle"]["line-2"].as<String>()) + "\"";
-  s += "}}";
-  return s;
+void recordMetricsFor(IPAddress ip, const char* summary) {
+  for (int i=0;i<clientsCount;i++){
+    if (clients[i].ip == ip) {
+      clients[i].metricCount = metricsParseSummary(summary, clients[i].metrics, METRIC_CLIENT_MAX);
+      return;
+    }
+  }
 }
 
 //JSON handling
-void sendJson(WiFiClient& c, const String& bodyJson) {
-  c.print("HTTP/1.1 200 OK\r\n"
-          "Content-Type: application/json\r\n"
-          "Cache-Control: no-cache\r\n"
-          "Connection: close\r\n\r\n");
+void beginJson(HttpResponse& c) {
+  c.contentType = "application/json";
+  c.addHeader("Cache-Control", "no-cache");
+}
+
+void sendJson(HttpResponse& c, const char* bodyJson) {
+  beginJson(c);
   c.print(bodyJson);
 }
 
-void sendText(WiFiClient& c, const String& body) {
-  c.print("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nConnection: close\r\n\r\n");
+void sendText(HttpResponse& c, const char* body) {
+  c.contentType = "text/plain";
   c.print(body);
 }
 
-String buildClientsJson() {
-  String s = "[";
-  bool first = true;
+void writeClientsJson(Print& out) {
+  JsonWriter j(out);
   unsigned long now = millis();
+  j.beginArray();
   for (int i=0;i<clientsCount;i++){
-    if (!first) s += ",";
-    first=false;
-    s += "{\"ip\":\"" + clients[i].ip.toString() + "\",";
-    s += "\"name\":\"" + clients[i].name + "\",";
-    s += "\"secs\":" + String((now - clients[i].lastSeenMs)/1000) + ",";
-    s += "\"lastSat\":\"" + clients[i].lastSat + "\",";
-    s += "\"lastSatIndex\":" + String(clients[i].lastSatIndex) + ",";
-    s += "\"lastFileCursor\":" + String(clients[i].lastFileCursor) + ",";
     long as = clients[i].lastAssignMs ? (long)((now - clients[i].lastAssignMs)/1000) : -1;
-    s += "\"lastAssignSecs\":" + String(as) + "}";
+    j.beginObject()
+     .field("ip", clients[i].ip)
+     .field("name", clients[i].name)
+     .field("secs", (now - clients[i].lastSeenMs)/1000)
+     .field("lastSat", clients[i].lastSat)
+     .field("lastSatIndex", clients[i].lastSatIndex)
+     .field("lastFileCursor", clients[i].lastFileCursor)
+     .field("lastAssignSecs", as)
+     .endObject();
+  }
+  j.endArray();
+}
+
+// Server histograms plus each module's latest PING summaries
+void writeMetricsJson(Print& out) {
+  JsonWriter j(out);
+  j.beginObject().key("server");
+  metricsWriteJson(j);
+  j.key("modules").beginArray();
+  for (int i=0;i<clientsCount;i++){
+    j.beginObject()
+     .field("ip", clients[i].ip)
+     .field("name", clients[i].name)
+     .key("metrics").beginObject();
+    for (int k=0;k<clients[i].metricCount;k++){
+      const MetricSummary& m = clients[i].metrics[k];
+      j.key(m.name);
+      j.beginObject()
+       .field("count", (unsigned long)m.count)
+       .field("p50", (unsigned long)m.p50)
+       .field("p90", (unsigned long)m.p90)
+       .field("p99", (unsigned long)m.p99)
+       .field("max", (unsigned long)m.max)
+       .endObject();
+    }
+    j.endObject().endObject();
+  }
+  j.endArray().endObject();
+}
+
+// Module summaries become one Prometheus summary family per metric name
+void writeMetricsPrometheus(Print& out) {
+  metricsWritePrometheus(out);
+  const char* names[METRIC_CLIENT_MAX * 2];
+  int nNames = 0;
+  for (int i=0;i<clientsCount;i++){
+    for (int k=0;k<clients[i].metricCount;k++){
+      const char* nm = clients[i].metrics[k].name;
+      bool seen = false;
+      for (int q=0;q<nNames && !seen;q++) seen = strcmp(names[q], nm) == 0;
+      if (!seen && nNames < (int)(sizeof(names)/sizeof(names[0]))) names[nNames++] = nm;
+    }
+  }
+  static const char* QUANTILES[] = { "0.5", "0.9", "0.99", "1" };
+  for (int q=0;q<nNames;q++){
+    out.printf("# TYPE wos_module_%s summary\n", names[q]);
+    for (int i=0;i<clientsCount;i++){
+      for (int k=0;k<clients[i].metricCount;k++){
+        const MetricSummary& m = clients[i].metrics[k];
+        if (strcmp(m.name, names[q]) != 0) continue;
+        const char* mod = clients[i].name.c_str();
+        const uint32_t vals[] = { m.p50, m.p90, m.p99, m.max };
+        for (int v=0; v<4; v++) {
+          out.printf("wos_module_%s{module=\"%s\",quantile=\"%s\"} %lu\n", m.name, mod, QUANTILES[v], (unsigned long)vals[v]);
+        }
+        out.printf("wos_module_%s_count{module=\"%s\"} %lu\n", m.name, mod, (unsigned long)m.count);
+      }
+    }
   }
-  s += "]";
-  return s;
 }
 
 int extractIndex(const String& name) {
@@ -185,6 +299,21 @@ int extractIndex(const String& name) {
 void scanSatelliteFiles() {
   satFilesCount = 0;
 
+  // A binary catalog holds the whole export; when present the JSON chunks are ignored.
+  if (SD.exists(SAT_CATALOG_PATH)) {
+    File cf = SD.open(SAT_CATALOG_PATH);
+    satFiles[0].name = SAT_CATALOG_PATH;
+    satFiles[0].index = 0;
+    satFiles[0].size = cf ? cf.size() : 0;
+    satFiles[0].count = -1;
+    satFiles[0].binary = true;
+    if (cf) cf.close();
+    satFilesCount = 1;
+    Serial.printf("📁 Found binary catalog %s (%lu B), JSON files ignored\n",
+                  SAT_CATALOG_PATH, (unsigned long)satFiles[0].size);
+    return;
+  }
+
   File root = SD.open("/");
   if (!root) { Serial.println("❌ SD root open failed"); return; }
 
@@ -201,6 +330,7 @@ void scanSatelliteFiles() {
         satFiles[satFilesCount].index = idx;
         satFiles[satFilesCount].size = sz;
         satFiles[satFilesCount].count = -1;
+        satFiles[satFilesCount].binary = false;
         satFilesCount++;
       }
     }
@@ -223,260 +353,351 @@ void scanSatelliteFiles() {
   }
 }
 
-bool loadSatelliteFileByCursor() {
-  if (satFilesCount == 0) { doc.clear(); satIndex=0; return true; }
-  if (satFileCursor < 0 || satFileCursor >= satFilesCount) satFileCursor = 0;
+// Rebuild the list of satellites with a TLE epoch within maxTleAgeS; the scheduler
+// restarts only if the list changed (its pass indices point into it)
+void refreshTleFreshness(bool force) {
+  lastTleCheckMs = millis();
+  if (!satIndexRevalidate(rtc.now().unixtime(), maxTleAgeS) && !force) return;
+  Serial.printf("🗓️ TLE freshness: %d of %d satellites within %ld h\n",
+                satIndexValidCount(), satIndexCount(), maxTleAgeS / 3600);
+  if (satIndex >= satIndexValidCount()) satIndex = 0;
+  schedulerReset();
+  visGeneration++;
+}
 
-  String filename = satFiles[satFileCursor].name;
-  File file = SD.open(filename);
-  if (!file) {
-    Serial.printf("❌ Could not open %s\n", filename.c_str());
-    return false;
+// Index every satellite on the card (one pass per file) so lookups and assignments
+// never reload a whole file; the freshest TLE wins where files overlap. After /reload and
+// /rescan, loop() indexes a slice at a time under the state lock, so links, pass
+// prediction and web requests keep going while the card is read; nothing is served until
+// the index is finished.
+const uint32_t REINDEX_LOOP_BUDGET_US = 4000;   // card reading per loop() while rebuilding
+int  reindexFile = -1;      // source being indexed, -1: no rebuild running
+bool reindexOpen = false;   // reindexFile has been begun
+bool reindexOk = true;      // every source could be read
+unsigned long reindexT0 = 0;
+
+// Empty the index and everything holding positions into it; reindexStep() fills it again
+void reindexStart() {
+  reindexT0 = millis();
+  satIndexClear();
+  for (int i=0;i<satFilesCount;i++) satFiles[i].count = -1;
+  satIndex = 0;
+  satFileCursor = 0;
+  schedulerReset();
+  visGeneration++;
+  reindexFile = 0;
+  reindexOpen = false;
+  reindexOk = true;
+}
+
+// Index for about budgetUs; true once the index is complete (or no rebuild is running)
+bool reindexStep(uint32_t budgetUs) {
+  if (reindexFile < 0) return true;
+  uint32_t start = micros();
+  while (reindexFile < satFilesCount) {
+    SatFile& f = satFiles[reindexFile];
+    if (!reindexOpen && !satIndexBeginFile(f.name.c_str(), f.binary)) {
+      Serial.printf("❌ Could not index %s\n", f.name.c_str());
+      reindexOk = false;
+      reindexFile++;
+      continue;
+    }
+    reindexOpen = true;
+    uint32_t used = micros() - start;
+    int found;
+    if (used >= budgetUs || !satIndexScanFile(budgetUs - used, found)) return false;
+    f.count = found;
+    reindexOpen = false;
+    reindexFile++;
   }
+  satIndexFinish();
+  Serial.printf("✅ Indexed %d satellites from %d files (%d duplicates dropped) in %lu ms\n",
+                satIndexCount(), satFilesCount, satIndexDuplicates(), millis() - reindexT0);
+  reindexFile = -1;
+  refreshTleFreshness(true);
+  return true;
+}
+
+// Number of satellites served (indexed, deduplicated, fresh)
+int satelliteCount() {
+  return satIndexValidCount();
+}
 
-  doc.clear();
-  DeserializationError err = deserializeJson(doc, file);
-  file.close();
+// Read served satellite #idx into a flat record
+bool readSatellite(int idx, SatRecord& out) {
+  return satIndexRead(satIndexValidAt(idx), out);
+}
 
-  if (err) {
-    Serial.printf("❌ JSON parse error in %s: %s\n", filename.c_str(), err.c_str());
+// (Re)load the served satellites into the SGP4 batch; false if out of memory
+bool ensureVisibleBatch() {
+  if (visBuiltGeneration == visGeneration && visBatch.block) return true;
+  // give the old batch back first so the heap it held counts
+  sgp4BatchEnd(visBatch);
+  free(visAz); free(visEl); free(visRange);
+  visAz = visEl = visRange = nullptr;
+  visLoaded = 0;
+
+  uint32_t freeHeap = ESP.getFreeHeap(), block = ESP.getMaxAllocHeap();
+  if (freeHeap <= VISIBLE_HEAP_RESERVE) return false;
+  int fit = (int)((freeHeap - VISIBLE_HEAP_RESERVE) / VISIBLE_SAT_BYTES);
+  fit = min(fit, (int)(block / SGP4B_SAT_BYTES));   // the batch is one allocation
+  int n = min(satelliteCount(), fit);
+  int cap = max(n, 1);
+  if (!sgp4BatchBegin(visBatch, cap)) return false;
+  visAz = (float*)malloc(cap * sizeof(float));
+  visEl = (float*)malloc(cap * sizeof(float));
+  visRange = (float*)malloc(cap * sizeof(float));
+  if (!visAz || !visEl || !visRange) {
+    sgp4BatchEnd(visBatch);
+    free(visAz); free(visEl); free(visRange);
+    visAz = visEl = visRange = nullptr;
     return false;
   }
+  SatRecord sat;
+  visLoaded = n;
+  for (int pos = 0; pos < n; pos++) {
+    if (readSatellite(pos, sat)) sgp4BatchAdd(visBatch, sat.line1, sat.line2, (uint32_t)pos);
+  }
+  visBuiltGeneration = visGeneration;
+  return true;
+}
 
-  satFiles[satFileCursor].count = (int)doc.size();
-  Serial.printf("✅ Loaded %s (%d satellites)\n", filename.c_str(), satFiles[satFileCursor].count);
-  satIndex = 0;
+// Serve from the start of file 'cursor' next
+bool serveFromFile(int cursor) {
+  if (cursor < 0 || cursor >= satFilesCount) return false;
+  int first = satIndexFirstValidOfFile(cursor);
+  if (first < 0) return false;
+  satFileCursor = cursor;
+  satIndex = first;
   return true;
 }
 
 bool advanceToNextFile() {
-  if (satFilesCount == 0) return false;
-  satFileCursor++;
-  if (satFileCursor >= satFilesCount) satFileCursor = 0;
-  return loadSatelliteFileByCursor();
+  for (int i=1; i<=satFilesCount; i++) {
+    if (serveFromFile((satFileCursor + i) % satFilesCount)) return true;
+  }
+  return false;
+}
+
+// Pick the next satellite for a module: a predicted pass that is up now or rising soon;
+// round-robin over the fresh satellites only until the first pass sweep has finished. Fills 'out' (except id) and records it.
+bool nextAssignment(IPAddress ip, NetAssign& out) {
+  MetricScope m(MET_ASSIGN_US);
+  if (satFilesCount == 0 || satelliteCount() == 0) return false;
+
+  uint32_t now = rtc.now().unixtime();
+  SatRecord sat;
+  PassInfo pass;
+  int idx = -1;
+  bool reserved = false;
+  bool planned = plannerAssign(ip, out.id, now, pass, reserved);
+  bool hasPass = planned && readSatellite(pass.satIdx, sat);
+  if (planned && !hasPass) plannerRelease(out.id);
+  if (!hasPass && reserved) return false;   // the passes it could take are planned for other modules
+  if (!hasPass && schedulerHasSwept()) return false;   // nothing up or rising soon: leave the slot empty
+
+  if (hasPass) {
+    idx = pass.satIdx;
+  } else {
+    // every served satellite is fresh (refreshTleFreshness), so no skipping here
+    if (satIndex >= satelliteCount()) satIndex = 0;
+    idx = satIndex++;
+    if (!readSatellite(idx, sat)) return false;
+  }
+
+  satFileCursor  = satIndexFileOf(satIndexValidAt(idx));
+  out.serverUnix = now;
+  out.norad      = sat.norad;
+  out.siteLat    = currentLat;
+  out.siteLon    = currentLon;
+  out.siteAlt    = (float)currentAlt;
+  strlcpy(out.name,  sat.name,  sizeof(out.name));
+  strlcpy(out.line1, sat.line1, sizeof(out.line1));
+  strlcpy(out.line2, sat.line2, sizeof(out.line2));
+  if (hasPass) {
+    out.aosUnix  = pass.aosUnix;
+    out.losUnix  = pass.losUnix;
+    out.maxElDeg = pass.maxElDeg;
+    out.aosAzDeg = pass.aosAzDeg;
+    Serial.printf("📡 Assigned pass sat #%d (file %d/%d): %s, AOS %+lds, max EL %.1f°\n",
+                  idx, satFileCursor+1, satFilesCount, sat.name, (long)pass.aosUnix - (long)now, pass.maxElDeg);
+  } else {
+    Serial.printf("📡 Assigned sat #%d (file %d/%d): %s\n", idx, satFileCursor+1, satFilesCount, sat.name);
+  }
+  recordAssignmentFor(ip, sat.name, idx, satFileCursor);
+  return true;
+}
+
+// Delivery report of a send: "OK delivered 3/3: 192.168.4.10 4.1ms, ..." (PENDING while acks may still come)
+void printSendResult(HttpResponse& c, uint32_t id) {
+  FanoutResult res[FANOUT_MAX_TARGETS];
+  bool done = false;
+  int n = fanoutResult(id, res, FANOUT_MAX_TARGETS, done);
+  if (n < 0) { sendText(c, "ERR unknown send id"); return; }
+  if (n == 0) { sendText(c, "OK broadcast (no active modules to confirm)"); return; }
+  int acked = 0;
+  for (int i=0; i<n; i++) if (res[i].acked) acked++;
+  c.printf("%s delivered %d/%d:", !done ? "PENDING" : acked == n ? "OK" : "ERR", acked, n);
+  for (int i=0; i<n; i++) {
+    c.printf("%s %s ", i ? "," : "", res[i].ip.toString().c_str());
+    if (res[i].acked) c.printf("%.1fms", res[i].latencyUs / 1000.0f);
+    else c.print("no ack");
+    if (res[i].tries > 1) c.printf(" (%u tries)", res[i].tries);
+  }
 }
 
-//  Web Interface
-String htmlIndex() {
-  String h;
-  h += F("HTTP/1.1 200 OK\r\n");
-  h += F("Content-Type: text/html; charset=utf-8\r\n");
-  h += F("Connection: close\r\n\r\n");
-
-  h += F("<!doctype html>");
-  h += F("<html><head>");
-  h += F("<meta charset='utf-8'>");
-  h += F("<meta name='viewport' content='width=device-width,initial-scale=1'>");
-  h += F("<style>");
-  h += F("body{font-family:system-ui,Arial;margin:16px}");
-  h += F("button,input,select{font-size:16px;padding:10px 14px;margin:6px}");
-  h += F(".card{border:1px solid #ccc;border-radius:12px;padding:12px;margin:12px 0}");
-  h += F(".row{display:flex;gap:8px;flex-wrap:wrap;align-items:center}");
-  h += F("code{background:#f4f4f4;padding:2px 6px;border-radius:6px}");
-  h += F(".statusline{margin-left:8px;color:#333;font-size:14px}");
-  h += F("table{border-collapse:collapse;width:100%}");
-  h += F("th,td{border:1px solid #ddd;padding:8px;text-align:left}");
-  h += F("th{background:#fafafa}");
-  h += F(".pill{border:1px solid #ddd;padding:6px 10px;border-radius:999px;margin:4px;display:inline-block}");
-  h += F(".hold{user-select:none;-webkit-user-select:none}");
-  h += F("</style>");
-  h += F("</head><body>");
-
-  h += F("<h2>ESP32 Satellite Server</h2>");
-
-  // Time card
-  h += F("<div class=card><h3>Time (RTC)</h3>"
-         "<div class=row>"
-         "<input id=iso value='' placeholder='YYYY-MM-DDTHH:MM:SSZ' style='min-width:260px'>"
-         "<button id=btnSetTime>Set RTC</button>"
-         "<span id=timeMsg class=statusline></span>"
-         "</div>"
-         "<small>Note: UTC only (append 'Z').</small>"
-         "</div>");
-
-  // Files + cursor info
-  h += F("<div class=card><h3>Satellite files</h3><div id=files>Loading…</div>"
-         "<div class=row>"
-         "<button id=btnRescan>Rescan SD</button>"
-         "<button id=btnNextFile>Next file</button>"
-         "<button id=btnReload>Reload current</button>"
-         "<input id=gotoIndex type=number min=1 style='width:90px' placeholder='index'>"
-         "<button id=btnGoto>Goto</button>"
-         "<span id=filesMsg class=statusline></span></div></div>");
-
-  // Clients
-  h += F("<div class=card><h3>Clients</h3><div id=clients>Loading…</div>"
-         "<button id=btnRefresh>Refresh</button></div>");
-
-  // Commands
-  h += F("<div class=card><h3>Send Command</h3>"
-         "<div class=row><label>Target:</label>"
-         "<select id=target><option value='ALL'>All</option></select></div>"
-         "<div class=row><input id=cmd size=36 placeholder='e.g. START / STOP / HOME / SAT NEW'>"
-         "<button id=btnSend>Send</button><span id=sendMsg class=statusline></span></div>");
-
-  // Jog controls with press-and-hold
-  h += F("<div class=card><h3>Manual Jog (press and hold)</h3>"
-         "<div class=row>"
-         "<span class=pill>Step size:</span>"
-         "<select id=stepSize>"
-         "<option value='1'>1</option>"
-         "<option value='5' selected>5</option>"
-         "<option value='10'>10</option>"
-         "<option value='25'>25</option>"
-         "<option value='100'>100</option>"
-         "</select>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>AZ:</span>"
-         "<button class='hold' id=azLeft>&larr; AZ</button>"
-         "<button class='hold' id=azRight>AZ &rarr;</button>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>EL:</span>"
-         "<button class='hold' id=elDown>&darr; EL</button>"
-         "<button class='hold' id=elUp>EL &uarr;</button>"
-         "<span id=jogMsg class=statusline></span>"
-         "</div>"
-         "</div>");
-  
-  h += F("<div class=card><h3>Manual STEP limits</h3>"
-       "<div class=row>"
-       "<label class=pill>AZ Limit:</label>"
-       "<select id=azLimit><option>ON</option><option selected>OFF</option></select>"
-       "<label class=pill>AZ min</label><input id=azMin type=number step=1 value='-180' style='width:90px'>"
-       "<label class=pill>AZ max</label><input id=azMax type=number step=1 value='540' style='width:90px'>"
-       "</div>"
-       "<div class=row>"
-       "<label class=pill>EL Limit:</label>"
-       "<select id=elLimit><option selected>ON</option><option>OFF</option></select>"
-       "<label class=pill>EL min</label><input id=elMin type=number step=1 value='0' style='width:90px'>"
-       "<label class=pill>EL max</label><input id=elMax type=number step=1 value='180' style='width:90px'>"
-       "</div>"
-       "<div class=row>"
-       "<button id=btnStepLimitApply>Apply to Target</button>"
-       "<button id=btnStepLimitStatus>Query Status</button>"
-       "<span id=limitMsg class=statusline></span>"
-       "</div></div>");
-
-  // Shortcuts
-  h += F("<div class=card><h3>Shortcuts</h3>"
-         "<div class=row>"
-         "<span class=pill>Session:</span>"
-         "<button class=quick data-cmd='START'>START</button>"
-         "<button class=quick data-cmd='STOP'>STOP</button>"
-         "<button class=quick data-cmd='HOME'>HOME</button>"
-         "<button class=quick data-cmd='HOME SET'>HOME SET</button>"
-         "<button class=quick data-cmd='SAT NEW'>SAT NEW</button>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>Laser:</span>"
-         "<button class=quick data-cmd='LASER OFF'>OFF</button>"
-         "<button class=quick data-cmd='LASER ON'>ON</button>"
-         "<button class=quick data-cmd='LASER TRACK'>TRACK</button>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>Step AZ:</span>"
-         "<button class=quick data-cmd='STEP AZ -100'>AZ -100</button>"
-         "<button class=quick data-cmd='STEP AZ -10'>AZ -10</button>"
-         "<button class=quick data-cmd='STEP AZ 10'>AZ +10</button>"
-         "<button class=quick data-cmd='STEP AZ 100'>AZ +100</button>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>Step EL:</span>"
-         "<button class=quick data-cmd='STEP EL -100'>EL -100</button>"
-         "<button class=quick data-cmd='STEP EL -10'>EL -10</button>"
-         "<button class=quick data-cmd='STEP EL 10'>EL +10</button>"
-         "<button class=quick data-cmd='STEP EL 100'>EL +100</button>"
-         "</div>"
-         "<div class=row>"
-         "<span class=pill>Audio:</span>"
-         "<button class=quick data-cmd='AUDIO IDLEMUTE ON'>IdleMute ON</button>"
-         "<button class=quick data-cmd='AUDIO IDLEMUTE OFF'>IdleMute OFF</button>"
-         "<button class=quick data-cmd='BEEP TEST'>BEEP TEST</button>"
-         "</div>"
-         "</div>");
-
-  // Status (bulk)
-  h += F("<div class=card><h3>Assignments</h3>"
-         "<div id=assignments>Loading…</div></div>");
-
-  // Script (no '+' concat inside F())
-  h += F("<script>");
-  h += F("function _(q){return document.querySelector(q)};");
-  h += F("function send(target,cmd,cb){fetch('/send?targets='+encodeURIComponent(target)+'&cmd='+encodeURIComponent(cmd)).then(r=>r.text()).then(t=>cb&&cb(t)).catch(e=>cb&&cb('ERR '+e));}");
-  h += F("function refresh(){fetch('/clients').then(r=>r.json()).then(list=>{let s=_('#target'); s.innerHTML='<option value=ALL>All</option>'; let div=_('#clients'); let html=''; list.forEach(c=>{s.innerHTML+=`<option value='${c.ip}'>${c.name||c.ip}</option>`; html+=`<div>${c.name||c.ip} <small>(${c.ip})</small> <small>(seen ${c.secs}s)</small></div>`}); if(!list.length) html='<i>No clients yet. They appear after HELLO/PING.</i>'; div.innerHTML=html;});}");
-  h += F("function files(){fetch('/files').then(r=>r.json()).then(info=>{let div=_('#files'); let html=`<div>Files: ${info.length}</div>`; html+='<ul>'; info.forEach(f=>{let cs=(f.count>=0?f.count:('- '+(f.size||0)+' B')); html+=`<li>#${f.idx}: ${f.name} — ${cs}</li>`}); html+='</ul>'; div.innerHTML=html;});}");
-  h += F("function renderAssignments(){fetch('/clients').then(r=>r.json()).then(list=>{if(list.length===0){_('#assignments').innerHTML='<i>No clients yet.</i>';return;} let rows=''; list.forEach(c=>{let sat=c.lastSat||'-'; let idx=(c.lastSatIndex>=0?c.lastSatIndex:'-'); let file=(c.lastFileCursor>=0?(c.lastFileCursor+1):'-'); let when=(c.lastAssignSecs>=0?c.lastAssignSecs+'s':'-'); rows+=`<tr><td>${c.name||c.ip}</td><td>${c.ip}</td><td>${sat}</td><td>${idx}</td><td>${file}</td><td>${when}</td></tr>`;}); _('#assignments').innerHTML=`<table><thead><tr><th>Module</th><th>IP</th><th>Satellite</th><th>SatIdx</th><th>File#</th><th>Assigned</th></tr></thead><tbody>${rows}</tbody></table>`;});}");
-  h += F("document.addEventListener('DOMContentLoaded',()=>{_('#btnSend').addEventListener('click',()=>{let t=_('#target').value; let c=_('#cmd').value; if(!c){_('#sendMsg').textContent='Enter a command';return;} send(t,c,(m)=>_('#sendMsg').textContent=m);}); _('#btnRefresh').addEventListener('click',refresh); _('#btnNextFile').addEventListener('click',()=>{fetch('/nextfile').then(r=>r.text()).then(t=>{_('#filesMsg').textContent=t; files();});}); _('#btnReload').addEventListener('click',()=>{fetch('/reload').then(r=>r.text()).then(t=>{_('#filesMsg').textContent=t; files();});}); _('#btnRescan').addEventListener('click',()=>{fetch('/rescan').then(r=>r.text()).then(t=>{_('#filesMsg').textContent=t; files();});}); _('#btnGoto').addEventListener('click',()=>{let i=parseInt(_('#gotoIndex').value||'0',10); if(!i){_('#filesMsg').textContent='Enter index';return;} fetch('/goto?index='+i).then(r=>r.text()).then(t=>{_('#filesMsg').textContent=t; files();});}); document.querySelectorAll('.quick').forEach(b=>{b.addEventListener('click',()=>{let t=_('#target').value; let c=b.getAttribute('data-cmd'); send(t,c,(m)=>_('#sendMsg').textContent=m);});}); let jogTimer=null; function jogStart(cmd){let t=_('#target').value; let rate=80; if(jogTimer) clearInterval(jogTimer); _('#jogMsg').textContent='jogging…'; jogTimer=setInterval(()=>{send(t,cmd,(m)=>{_('#sendMsg').textContent=m;});},rate);} function jogStop(){ if(jogTimer){clearInterval(jogTimer); jogTimer=null; _('#jogMsg').textContent='';}} function bindHold(btn, cmdBuilder){['mousedown','touchstart'].forEach(ev=>btn.addEventListener(ev,(e)=>{e.preventDefault(); jogStart(cmdBuilder());})); ['mouseup','mouseleave','touchend','touchcancel'].forEach(ev=>btn.addEventListener(ev,(e)=>{e.preventDefault(); jogStop();})); } bindHold(_('#azLeft'), ()=>{let n=_('#stepSize').value; return 'STEP AZ -'+n;}); bindHold(_('#azRight'),()=>{let n=_('#stepSize').value; return 'STEP AZ '+n;}); bindHold(_('#elDown'),()=>{let n=_('#stepSize').value; return 'STEP EL -'+n;}); bindHold(_('#elUp'),  ()=>{let n=_('#stepSize').value; return 'STEP EL '+n;}); _('#btnSetTime').addEventListener('click',()=>{let iso=_('#iso').value.trim(); if(!iso){_('#timeMsg').textContent='Enter ISO UTC time';return;} fetch('/settime?iso='+encodeURIComponent(iso)).then(r=>r.text()).then(t=>{_('#timeMsg').textContent=t;}).catch(e=>_('#timeMsg').textContent='ERR '+e);}); refresh(); files(); renderAssignments(); setInterval(()=>{refresh(); files(); renderAssignments();}, 3000);});");
-  h += F("_('#btnStepLimitApply').addEventListener('click',()=>{"
-  "let t=_('#target').value;"
-  "let azL=_('#azLimit').value==='ON';"
-  "let elL=_('#elLimit').value==='ON';"
-  "let azMin=_('#azMin').value, azMax=_('#azMax').value;"
-  "let elMin=_('#elMin').value, elMax=_('#elMax').value;"
-
-  // order matters; set ranges first, then toggles
-  "send(t,`STEP LIMIT AZ ${azMin} ${azMax}`,m=>{_('#limitMsg').textContent=m;});"
-  "send(t,`STEP LIMIT EL ${elMin} ${elMax}`,m=>{_('#limitMsg').textContent=m;});"
-  "send(t,`STEP LIMITS AZ ${azL?'ON':'OFF'}`,(m)=>{_('#limitMsg').textContent=m;});"
-  "send(t,`STEP LIMITS EL ${elL?'ON':'OFF'}`,(m)=>{_('#limitMsg').textContent=m;});"
-"});"
-
-"_('#btnStepLimitStatus').addEventListener('click',()=>{"
-  "let t=_('#target').value; send(t,'STEP LIMIT STATUS',m=>{_('#limitMsg').textContent=m;});"
-"});");
-  h += F("</script>");
-
-  h += F("</body></html>");
-  return h;
+// GET /send?targets=ALL|<ip>&cmd=...: queues the command and answers at once with its id;
+// loop() collects the acks. GET /send?id=N: the delivery report of that send.
+void handleSend(const HttpRequest& req, HttpResponse& c) {
+  String q = req.line.substring(10);
+  int sp = q.indexOf(' ');
+  if (sp>0) q = q.substring(0, sp);
+
+  if (q.startsWith("id=")) {
+    StateLock lock;
+    printSendResult(c, (uint32_t)strtoul(q.c_str() + 3, nullptr, 10));
+    return;
+  }
+
+  String targets, cmd;
+  int a = q.indexOf("targets=");
+  int b = q.indexOf("&cmd=");
+  if (a>=0 && b> a) {
+    targets = q.substring(a+8, b);
+    cmd     = q.substring(b+5);
+    cmd.replace("%20"," "); cmd.replace("+"," "); cmd.replace("%3B",";");  // ";" batches commands in one packet
+    targets.replace("%20"," ");
+  }
+
+  if (!cmd.length()) { sendText(c, "ERR missing cmd"); return; }
+  if (cmd.length() > NET_CMD_MAX_TEXT) { sendText(c, "ERR cmd too long"); return; }
+
+  IPAddress ips[FANOUT_MAX_TARGETS];
+  int n = 0;
+  const bool all = (targets == "ALL");
+  if (!all) {
+    IPAddress ip; ip.fromString(targets);
+    if (!ip) { sendText(c, "ERR invalid IP"); return; }
+    ips[n++] = ip;
+  }
+
+  StateLock lock;
+  if (all) {   // broadcast reaches everyone; acks are awaited only from modules that PING
+    unsigned long now = millis();
+    for (int i=0; i<clientsCount && n<FANOUT_MAX_TARGETS; i++) {
+      if (now - clients[i].lastSeenMs <= CLIENT_ACTIVE_MS) ips[n++] = clients[i].ip;
+    }
+  }
+  uint32_t id = fanoutSend(cmd.c_str(), ips, n, all);
+  c.printf("OK #%lu queued for %d module%s", (unsigned long)id, n, n == 1 ? "" : "s");
 }
 
-// HTTP router
-void handleHttp(WiFiClient& c, const String& reqLine) {
+// HTTP router (runs on the HTTP task)
+void handleHttp(const HttpRequest& req, HttpResponse& c) {
+  MetricScope m(MET_HTTP_US);
+  if (req.line.startsWith("GET /send?")) { handleSend(req, c); return; }
+
+  StateLock lock;
+  const String& reqLine = req.line;
+
+  // web UI: gzipped page straight from flash (see web/index.html, setupfiles/build_web_ui.py)
   if (reqLine.startsWith("GET / ")) {
-    c.print(htmlIndex());
+    char etag[40];
+    c.addHeader("ETag", WEB_INDEX_ETAG);
+    c.addHeader("Cache-Control", "no-cache");
+    if (req.header("If-None-Match", etag, sizeof(etag)) && strcmp(etag, WEB_INDEX_ETAG) == 0) {
+      c.status = 304;
+      return;
+    }
+    c.contentType = "text/html; charset=utf-8";
+    c.addHeader("Content-Encoding", "gzip");
+    c.sendStatic(WEB_INDEX_GZ, WEB_INDEX_GZ_LEN);
     return;
   }
 
   // list files (JSON array)
   if (reqLine.startsWith("GET /files")) {
-    String out = "[";
+    beginJson(c);
+    JsonWriter j(c);
+    j.beginArray();
     for (int i=0;i<satFilesCount;i++){
-      if (i) out += ",";
-      out += "{";
-      out += "\"idx\":" + String(i+1) + ",";
-      out += "\"name\":\"" + satFiles[i].name + "\",";
-      out += "\"size\":" + String(satFiles[i].size) + ",";
-      out += "\"count\":" + String(satFiles[i].count);
-      out += "}";
+      j.beginObject()
+       .field("idx", i+1)
+       .field("name", satFiles[i].name)
+       .field("size", satFiles[i].size)
+       .field("count", satFiles[i].count)
+       .field("indexed", satIndexFileEntries(i))
+       .field("stale", satIndexFileStale(i))
+       .endObject();
     }
-    out += "]";
-    sendJson(c, out);
+    j.endArray();
+    return;
+  }
+
+  // index and pass summary: GET /status ("overflow" > 0: satellites that did not fit in the index)
+  if (reqLine.startsWith("GET /status")) {
+    beginJson(c);
+    JsonWriter j(c);
+    j.beginObject()
+     .field("files", satFilesCount)
+     .field("indexing", reindexFile >= 0)   // /reload or /rescan still reading the card
+     .field("indexed", satIndexCount())
+     .field("served", satelliteCount())
+     .field("duplicates", satIndexDuplicates())
+     .field("overflow", satIndexOverflow())
+     .field("indexMax", SAT_INDEX_MAX)
+     .field("maxTleAgeH", maxTleAgeS / 3600)
+     .field("passesQueued", schedulerQueued())      // predicted, not handed out yet
+     .field("passesHeld", plannerHeld())            // assigned to modules (see /plan)
+     .field("sweepDone", schedulerSweepDone())
+     .field("heapFree", (unsigned long)ESP.getFreeHeap())
+     .endObject();
     return;
   }
 
   if (reqLine.startsWith("GET /clients")) {
-    sendJson(c, buildClientsJson());
+    beginJson(c);
+    writeClientsJson(c);
+    return;
+  }
+
+  // passes held by the modules and the laser time they add up to: GET /plan
+  if (reqLine.startsWith("GET /plan")) {
+    beginJson(c);
+    JsonWriter j(c);
+    plannerWriteJson(j, rtc.now().unixtime());
+    return;
+  }
+
+  // runtime metrics: GET /metrics (JSON) or /metrics?format=prom (Prometheus text)
+  if (reqLine.startsWith("GET /metrics")) {
+    if (queryParam(req.query, "format") == "prom") {
+      c.contentType = "text/plain; version=0.0.4";
+      writeMetricsPrometheus(c);
+    } else {
+      beginJson(c);
+      writeMetricsJson(c);
+    }
     return;
   }
 
   if (reqLine.startsWith("GET /nextfile")) {
     bool ok = advanceToNextFile();
-    sendText(c, ok ? "OK switched to next file" : "ERR no files");
+    sendText(c, ok ? "OK serving from next file" : "ERR no files");
     return;
   }
 
+  // rebuild the index (after a new file scan for /rescan); loop() does the reading, /status says when it is done
   if (reqLine.startsWith("GET /reload")) {
-    bool ok = loadSatelliteFileByCursor();
-    sendText(c, ok ? "OK reloaded" : "ERR reload failed");
+    reindexStart();
+    c.printf("OK reindexing %d files", satFilesCount);
     return;
   }
 
   if (reqLine.startsWith("GET /rescan")) {
     scanSatelliteFiles();
-    bool ok = (satFilesCount > 0) ? loadSatelliteFileByCursor() : true;
-    sendText(c, ok ? "OK rescan complete" : "ERR rescan failed");
+    reindexStart();
+    c.printf("OK rescanned, reindexing %d files", satFilesCount);
     return;
   }
 
@@ -488,15 +709,92 @@ void handleHttp(WiFiClient& c, const String& reqLine) {
     int target = -1;
     if (a >= 0) target = q.substring(a+6).toInt();
     if (target >= 1 && target <= satFilesCount) {
-      satFileCursor = target - 1;
-      bool ok = loadSatelliteFileByCursor();
-      sendText(c, ok ? "OK goto loaded" : "ERR goto failed");
+      bool ok = serveFromFile(target - 1);
+      sendText(c, ok ? "OK serving from file" : "ERR no satellites indexed from that file");
     } else {
       sendText(c, "ERR invalid index");
     }
     return;
   }
 
+  // one satellite by NORAD id or name: GET /sat?id=25544 or /sat?name=ISS%20(ZARYA)
+  if (reqLine.startsWith("GET /sat?")) {
+    String id = queryParam(req.query, "id");
+    String name = queryParam(req.query, "name");
+    int idx = id.length() ? satIndexFindId((uint32_t)id.toInt())
+            : name.length() ? satIndexFindName(name.c_str()) : -1;
+    SatRecord sat;
+    if (idx < 0 || !satIndexRead(idx, sat)) {   // entry index: stale TLEs are reported, not hidden
+      c.status = 404;
+      sendJson(c, "{\"error\":\"not found\"}");
+      return;
+    }
+    int file = satIndexFileOf(idx);
+    long ageS = (long)rtc.now().unixtime() - (long)sat.epochUnix;
+    beginJson(c);
+    JsonWriter j(c);
+    j.beginObject()
+     .field("idx", idx)
+     .field("norad", (unsigned long)sat.norad)
+     .field("name", sat.name)
+     .field("epochUnix", sat.epochUnix, 0)
+     .field("exportUnix", (unsigned long)sat.exportUnix)
+     .field("tleAgeH", ageS / 3600.0, 1)
+     .field("fresh", labs(ageS) <= maxTleAgeS)   // false: indexed but not served (see /tleage)
+     .field("file", file + 1)
+     .field("fileName", satFiles[file].name)
+     .field("line1", sat.line1)
+     .field("line2", sat.line2)
+     .endObject();
+    return;
+  }
+
+  // look angles of every served satellite now: GET /visible[?min_el=10]
+  if (reqLine.startsWith("GET /visible")) {
+    float minEl = queryParam(req.query, "min_el").toFloat();
+    unsigned long t0 = micros();
+    if (!ensureVisibleBatch()) {
+      c.status = 503;
+      sendJson(c, "{\"error\":\"out of memory\"}");
+      return;
+    }
+    unsigned long t1 = micros();
+    uint32_t now = rtc.now().unixtime();
+    Sgp4Site site;
+    sgp4SiteInit(site, currentLat, currentLon, currentAlt);
+    int failed = sgp4BatchLook(visBatch, site, (double)now, 0, visBatch.count, visAz, visEl, visRange);
+    unsigned long t2 = micros();
+
+    int visible = 0;
+    for (int i = 0; i < visBatch.count; i++) visible += visEl[i] >= minEl;
+    beginJson(c);
+    JsonWriter j(c);
+    j.beginObject()
+     .field("t", (unsigned long)now)
+     .field("minEl", minEl, 1)
+     .field("sats", visBatch.count)
+     .field("total", satelliteCount())
+     .field("truncated", visLoaded < satelliteCount())   // heap-limited: only the first "sats" propagated
+     .field("failed", failed)
+     .field("visible", visible)
+     .field("buildUs", (unsigned long)(t1 - t0))
+     .field("propagateUs", (unsigned long)(t2 - t1))
+     .key("list").beginArray();
+    int listed = 0;
+    for (int i = 0; i < visBatch.count && listed < VISIBLE_LIST_MAX; i++) {
+      if (visEl[i] < minEl) continue;
+      j.beginObject()
+       .field("norad", (unsigned long)satIndexEntry(satIndexValidAt((int)visBatch.id[i])).norad)
+       .field("az", visAz[i], 1)
+       .field("el", visEl[i], 1)
+       .field("rangeKm", visRange[i], 0)
+       .endObject();
+      listed++;
+    }
+    j.endArray().endObject();
+    return;
+  }
+
   if (reqLine.startsWith("GET /satindex?")) {
     String q = reqLine.substring(14);
     int sp = q.indexOf(' ');
@@ -504,7 +802,7 @@ void handleHttp(WiFiClient& c, const String& reqLine) {
     int a = q.indexOf("set=");
     int v = -1;
     if (a >= 0) v = q.substring(a+4).toInt();
-    if (v >= 0 && v < (int)doc.size()) {
+    if (v >= 0 && v < satelliteCount()) {
       satIndex = v;
       sendText(c, "OK satIndex set");
     } else {
@@ -541,44 +839,19 @@ void handleHttp(WiFiClient& c, const String& reqLine) {
       return;
     }
     rtc.adjust(dt);
-    sendText(c, String("OK RTC set to ") + iso);
+    timeSyncRtcAdjusted(dt.unixtime());
+    refreshTleFreshness(false);
+    c.printf("OK RTC set to %s", iso.c_str());
     return;
   }
 
-  if (reqLine.startsWith("GET /send?")) {
-    String q = reqLine.substring(10);
-    int sp = q.indexOf(' ');
-    if (sp>0) q = q.substring(0, sp);
-    String targets, cmd;
-
-    int a = q.indexOf("targets=");
-    int b = q.indexOf("&cmd=");
-    if (a>=0 && b> a) {
-      targets = q.substring(a+8, b);
-      cmd     = q.substring(b+5);
-      cmd.replace("%20"," "); cmd.replace("+"," ");
-      targets.replace("%20"," ");
-    }
-
-    if (!cmd.length()) { sendText(c, "ERR missing cmd"); return; }
-
-    int sent = 0;
-    if (targets == "ALL") {
-      for (int i=0;i<clientsCount;i++){
-        udpCmd.beginPacket(clients[i].ip, UDP_CMD_PORT);
-        udpCmd.print(cmd);
-        udpCmd.endPacket();
-        sent++;
-      }
-    } else {
-      IPAddress ip; ip.fromString(targets);
-      if (!ip) { sendText(c, "ERR invalid IP"); return; }
-      udpCmd.beginPacket(ip, UDP_CMD_PORT);
-      udpCmd.print(cmd);
-      udpCmd.endPacket();
-      sent=1;
-    }
-    sendText(c, String("OK sent to ")+sent);
+  // max TLE epoch age served: GET /tleage?hours=48
+  if (reqLine.startsWith("GET /tleage?")) {
+    float h = queryParam(req.query, "hours").toFloat();
+    if (h <= 0) { sendText(c, "ERR hours must be > 0"); return; }
+    maxTleAgeS = (long)(h * 3600.0f);
+    refreshTleFreshness(true);
+    c.printf("OK %d of %d satellites within %.1f h", satIndexValidCount(), satIndexCount(), h);
     return;
   }
 
@@ -608,12 +881,12 @@ void setup() {
     return;
   }
 
-  httpSrv.begin();
-  udpTime.begin(UDP_TIME_PORT);
-  udpCmd.begin(0);                // sender only
+  gStateLock = xSemaphoreCreateMutex();
+  linkBegin();
+  timeSyncBegin(UDP_TIME_PORT, broadcastIP);
+  fanoutBegin(UDP_CMD_PORT, broadcastIP);   // commands to clients, acked per module
   udpReg.begin(UDP_REG_PORT);     // listen HELLO/PING
-  Serial.printf("🌐 Web UI: http://%s/\n", WiFi.softAPIP().toString().c_str());
-  Serial.printf("⏱️  Time UDP:%d  🎛️ Cmd UDP:%d  👋 Reg UDP:%d\n", UDP_TIME_PORT, UDP_CMD_PORT, UDP_REG_PORT);
+  Serial.printf("⏱️  Time UDP:%d  🎛️ Cmd UDP:%d  👋 Reg UDP:%d  🔗 Link TCP:%d\n", UDP_TIME_PORT, UDP_CMD_PORT, UDP_REG_PORT, NET_LINK_PORT);
 
   // SD init
   spiSD.begin(SD_SCK, SD_MISO, SD_MOSI, SD_CS);
@@ -642,114 +915,82 @@ void setup() {
         currentLon = locDoc["longitude"] | 0.0;
         currentAlt = locDoc["altitude_m"]| 0.0;
         Serial.printf("✅ Location: lat=%.6f lon=%.6f alt=%.1f\n", currentLat, currentLon, currentAlt);
+        maxTleAgeS = (long)((locDoc["max_tle_age_h"] | (TLE_MAX_AGE_DEFAULT_S / 3600.0)) * 3600.0);
+        schedulerBegin(currentLat, currentLon, currentAlt);
       } else {
         Serial.println("❌ Location JSON error");
       }
     }
   }
 
-  // Find & load satellite files
+  // Find & index satellite files
   scanSatelliteFiles();
   if (satFilesCount == 0) {
-    Serial.println("⚠️ No /sat_data_*.json files found. Clients will get a built-in TEST-SAT.");
+    Serial.println("⚠️ No /sat_data_*.json files found. Modules will wait for data.");
   } else {
-    if (!loadSatelliteFileByCursor()) {
-      Serial.println("❌ Initial satellite file load failed");
-    }
+    reindexStart();
+    reindexStep(UINT32_MAX);   // all at once: nothing else runs yet
+    if (!reindexOk) Serial.println("❌ Initial satellite indexing failed");
   }
+
+  // web requests run on their own task: start it once the index is built
+  httpBegin(HTTP_PORT, handleHttp);
+  Serial.printf("🌐 Web UI: http://%s/\n", WiFi.softAPIP().toString().c_str());
 }
 
 void loop() {
+  MetricScope m(MET_LOOP_US);
   // HELLO/PING from Clietn
   {
     int sz = udpReg.parsePacket();
     if (sz > 0) {
-      char buf[128];
+      char buf[384];   // PING carries the module's metric summaries
       int n = udpReg.read(buf, sizeof(buf)-1);
       if (n > 0) {
         buf[n] = 0;
         String msg(buf); msg.trim(); msg.replace("\r",""); msg.replace("\n","");
-        String cmd, name;
+        String cmd, name, summary;
         int sp = msg.indexOf(' ');
         if (sp > 0) { cmd = msg.substring(0,sp); name = msg.substring(sp+1); } else { cmd = msg; }
+        sp = name.indexOf(' ');
+        if (sp > 0) { summary = name.substring(sp+1); name = name.substring(0, sp); }
         IPAddress rip = udpReg.remoteIP();
         if (cmd.equalsIgnoreCase("HELLO") || cmd.equalsIgnoreCase("PING")) {
+          StateLock lock;
           upsertClient(rip, name);
+          if (summary.length()) recordMetricsFor(rip, summary.c_str());
           Serial.printf("👋 %s from %s (%s)\n", cmd.c_str(), rip.toString().c_str(), name.c_str());
         }
       }
     }
   }
 
-  // HTTP / Client TCP accept
-  WiFiClient c = httpSrv.available();
-  if (c) {
-    // Wait briefly to detect HTTP vs silent module
-    unsigned long start = millis();
-    while (!c.available() && millis()-start < 150) delay(1);
-
-    bool handledHTTP = false;
-    if (c.available()) {
-      String line = c.readStringUntil('\n'); line.trim();
-      if (line.startsWith("GET ") || line.startsWith("POST ")) {
-        handleHttp(c, line);
-        c.stop();
-        handledHTTP = true;
-      }
-    }
+  // Module link: accept, read acks, push assignments
+  {
+    StateLock lock;
+    linkLoop();
+  }
 
-    if (!handledHTTP) {
-      // Client module asking for satellite
-      upsertClient(c.remoteIP());
-
-      if (satFilesCount == 0 || doc.size() == 0) {
-        String tp = buildTimePayload(); // {"current_time_utc":"..."}
-        String payload = String("{")
-          + "\"current_time_utc\":" + tp.substring(1) + ","
-          + "\"id\":25544,"
-          + "\"name\":\"TEST-SAT\","
-          + "\"latitude\":" + String(currentLat) + ","
-          + "\"longitude\":" + String(currentLon) + ","
-          + "\"distance_km\":500.0,"
-          + "\"elevation_deg\":45.0,"
-          + "\"datetime_utc\":\"2025-01-01T00:00:00Z\","
-          + "\"tle\":{\"line-1\":\"1 TEST ...\",\"line-2\":\"2 TEST ...\"}"
-          + "}";
-        c.println(payload);  // newline important
-        c.stop();
-        Serial.println("📡 Assigned built-in TEST-SAT");
-      } else {
-        if (satIndex >= (int)doc.size()) {
-          if (!advanceToNextFile()) {
-            loadSatelliteFileByCursor();
-          }
-        }
-        if (doc.size() == 0) {
-          c.println("{\"error\":\"no satellites\"}");
-          c.stop();
-        } else {
-          JsonObject sat = doc[satIndex];
-
-          DateTime tleTime = parseDateTime(sat["datetime_utc"].as<const char*>());
-          DateTime now = rtc.now();
-          if ((now - tleTime).totalseconds() > MAX_TLE_AGE_SECONDS) {
-            Serial.printf("⏭️ Skip outdated sat #%d (file %d/%d)\n", satIndex, satFileCursor+1, satFilesCount);
-            satIndex++;
-            c.stop();
-          } else {
-            String payload = createSatellitePayload(sat);
-            c.println(payload); 
-            IPAddress rip = c.remoteIP();
-            recordAssignmentFor(rip, sat["name"].as<const char*>(), satIndex, satFileCursor);
-            c.stop();
-            Serial.printf("📡 Assigned sat #%d (file %d/%d): %s\n",
-                          satIndex, satFileCursor+1, satFilesCount,
-                          sat["name"].as<const char*>());
-            satIndex++;
-          }
-        }
-      }
-    }
+  // Index rebuild after /reload or /rescan, a slice per loop
+  {
+    StateLock lock;
+    reindexStep(REINDEX_LOOP_BUDGET_US);
+  }
+
+  // Command fan-out: acks and retransmits of /send; forget silent modules
+  {
+    StateLock lock;
+    fanoutLoop();
+    pruneClients();
+  }
+
+  // Pass prediction (time-budgeted, a few satellites per loop)
+  {
+    uint32_t now = rtc.now().unixtime();
+    StateLock lock;
+    if (millis() - lastTleCheckMs >= TLE_RECHECK_MS) refreshTleFreshness(false);
+    MetricScope m(MET_SCHED_US);
+    schedulerLoop(now);
   }
 
 //Serial time setter (command: HOSTTIME YYYY-MM-DDTHH:MM:SSZ)
@@ -767,6 +1008,8 @@ if (Serial.available()) {
         Serial.printf("❌ Parse failed for '%s'\n", iso.c_str());
       } else {
         rtc.adjust(dt);
+        timeSyncRtcAdjusted(dt.unixtime());
+        { StateLock lock; refreshTleFreshness(false); }
         Serial.printf("✅ RTC set to %s (epoch %lu)\n", iso.c_str(), (unsigned long)dt.unixtime());
       }
     }
@@ -774,22 +1017,6 @@ if (Serial.available()) {
 }
 
 
-  //Broadcast time
-const unsigned long broadcastInterval = 200; // 5 Hz (every 200 ms)
-
-if (millis() - lastBroadcast > broadcastInterval) {
-    String timePayload = buildTimePayload();
-    udpTime.beginPacket(broadcastIP, UDP_TIME_PORT);
-    udpTime.print(timePayload);
-    udpTime.endPacket();
-
-    static unsigned long lastPrint = 0;
-    if (millis() - lastPrint >= 1000) { // logs once per second
-        Serial.print("⏰ Broadcasted time: "); 
-        Serial.println(timePayload);
-        lastPrint = millis();
-    }
-
-    lastBroadcast = millis();
-  }
+  // Time sync requests / beacon
+  timeSyncLoop();
 }
\ No newline at end of file
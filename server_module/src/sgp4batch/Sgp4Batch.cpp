@@ -0,0 +1,389 @@
+#include "Sgp4Batch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#if SGP4B_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+typedef sgp4_real real;
+
+// WGS-72 (as in Vallado's getgravconst("wgs72"))
+static const double RE_KM   = 6378.135;
+static const double MU      = 398600.8;
+static const double J2      = 0.001082616;
+static const double J3      = -0.00000253881;
+static const double J4      = -0.00000165597;
+static const double J3OJ2   = J3 / J2;
+static const double X2O3    = 2.0 / 3.0;
+static const double TWO_PI  = 6.28318530717958647692;
+static const double DEG2RAD = TWO_PI / 360.0;
+
+static inline double xke() { return 60.0 / sqrt(RE_KM * RE_KM * RE_KM / MU); }
+
+// ===== Allocation =====
+bool sgp4BatchBegin(Sgp4Batch& b, int capacity) {
+  memset(&b, 0, sizeof(b));
+  if (capacity <= 0) return false;
+  b.block = malloc(SGP4B_SAT_BYTES * (size_t)capacity);
+  if (!b.block) return false;
+  // doubles first so everything stays aligned
+  b.epochUnix = (double*)b.block;
+  double* d = b.epochUnix + capacity;
+  for (int k = 0; k < SGP4S_COUNT; k++, d += capacity) b.s[k] = d;
+  real* p = (real*)d;
+  for (int k = 0; k < SGP4F_COUNT; k++, p += capacity) b.f[k] = p;
+  b.id = (uint32_t*)p;
+  b.capacity = capacity;
+  return true;
+}
+
+void sgp4BatchEnd(Sgp4Batch& b) {
+  free(b.block);
+  memset(&b, 0, sizeof(b));
+}
+
+void sgp4BatchClear(Sgp4Batch& b) { b.count = 0; }
+
+// ===== TLE parsing =====
+static double tleField(const char* line, int start, int len) {
+  char buf[16];
+  memcpy(buf, line + start, len); buf[len] = 0;
+  return atof(buf);
+}
+
+// " 28098-4" -> 0.28098e-4 (implied decimal point, signed exponent)
+static double tleExpField(const char* line, int start) {
+  char buf[16];
+  buf[0] = line[start] == '-' ? '-' : '+';
+  buf[1] = '.';
+  memcpy(buf + 2, line + start + 1, 5);
+  buf[7] = 'e';
+  memcpy(buf + 8, line + start + 6, 2);
+  buf[10] = 0;
+  return atof(buf);
+}
+
+static long daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const long era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = (unsigned)(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (long)doe - 719468;
+}
+
+// ===== Initialization (sgp4init, near-earth part) =====
+bool sgp4BatchAdd(Sgp4Batch& b, const char* l1, const char* l2, uint32_t id) {
+  if (b.count >= b.capacity || !l1 || !l2) return false;
+  if (l1[0] != '1' || l2[0] != '2' || strlen(l1) < 61 || strlen(l2) < 63) return false;
+
+  int year = (int)tleField(l1, 18, 2);
+  year += (year < 57) ? 2000 : 1900;
+  double doy   = tleField(l1, 20, 12);
+  double bstar = tleExpField(l1, 53);
+
+  char ecc[9] = { '.', 0 };
+  memcpy(ecc + 1, l2 + 26, 7); ecc[8] = 0;
+  double inclo = tleField(l2, 8, 8) * DEG2RAD;
+  double nodeo = tleField(l2, 17, 8) * DEG2RAD;
+  double ecco  = atof(ecc);
+  double argpo = tleField(l2, 34, 8) * DEG2RAD;
+  double mo    = tleField(l2, 43, 8) * DEG2RAD;
+  double noKozai = tleField(l2, 52, 11) / (1440.0 / TWO_PI);   // rad/min
+  if (doy < 1.0 || noKozai <= 0.0 || ecco >= 1.0) return false;
+
+  // initl: un-Kozai the mean motion
+  const double XKE = xke();
+  double eccsq = ecco * ecco, omeosq = 1.0 - eccsq, rteosq = sqrt(omeosq);
+  double cosio = cos(inclo), cosio2 = cosio * cosio, sinio = sin(inclo);
+  double ak = pow(XKE / noKozai, X2O3);
+  double d1 = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+  double del = d1 / (ak * ak);
+  double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+  del = d1 / (adel * adel);
+  double no = noKozai / (1.0 + del);
+  if (TWO_PI / no >= 225.0) return false;   // deep space (SDP4) is not supported
+
+  double ao = pow(XKE / no, X2O3);
+  double po = ao * omeosq;
+  double con42 = 1.0 - 5.0 * cosio2;
+  double con41 = -con42 - cosio2 - cosio2;
+  double posq = po * po;
+  double rp = ao * (1.0 - ecco);
+  if (rp < 1.0) return false;               // perigee below the surface
+
+  bool isimp = rp < (220.0 / RE_KM + 1.0);
+  double sfour = 78.0 / RE_KM + 1.0;
+  double qzms24 = pow((120.0 - 78.0) / RE_KM, 4);
+  double perige = (rp - 1.0) * RE_KM;
+  if (perige < 156.0) {
+    sfour = perige - 78.0;
+    if (perige < 98.0) sfour = 20.0;
+    qzms24 = pow((120.0 - sfour) / RE_KM, 4);
+    sfour = sfour / RE_KM + 1.0;
+  }
+  double pinvsq = 1.0 / posq;
+  double tsi = 1.0 / (ao - sfour);
+  double eta = ao * ecco * tsi, etasq = eta * eta, eeta = ecco * eta;
+  double psisq = fabs(1.0 - etasq);
+  double coef = qzms24 * pow(tsi, 4), coef1 = coef / pow(psisq, 3.5);
+  double cc2 = coef1 * no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+               0.375 * J2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+  double cc1 = bstar * cc2;
+  double cc3 = (ecco > 1.0e-4) ? -2.0 * coef * tsi * J3OJ2 * no * sinio / ecco : 0.0;
+  double x1mth2 = 1.0 - cosio2;
+  double cc4 = 2.0 * no * coef1 * ao * omeosq *
+               (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+                J2 * tsi / (ao * psisq) *
+                (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                 0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * cos(2.0 * argpo)));
+  double cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+  double cosio4 = cosio2 * cosio2;
+  double temp1 = 1.5 * J2 * pinvsq * no;
+  double temp2 = 0.5 * temp1 * J2 * pinvsq;
+  double temp3 = -0.46875 * J4 * pinvsq * pinvsq * no;
+  double mdot = no + 0.5 * temp1 * rteosq * con41 +
+                0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+  double argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+                   temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+  double xhdot1 = -temp1 * cosio;
+  double nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+  double omgcof = bstar * cc3 * cos(argpo);
+  double xmcof = (ecco > 1.0e-4) ? -X2O3 * coef * bstar / eeta : 0.0;
+  double nodecf = 3.5 * omeosq * xhdot1 * cc1;
+  double t2cof = 1.5 * cc1;
+  double xlcof = (fabs(cosio + 1.0) > 1.5e-12)
+                 ? -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / (1.0 + cosio)
+                 : -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / 1.5e-12;
+  double aycof = -0.5 * J3OJ2 * sinio;
+  double delmo = pow(1.0 + eta * cos(mo), 3);
+
+  // higher-order drag terms; zero for isimp so the kernel needs no branch
+  double d2 = 0, d3 = 0, d4 = 0, t3cof = 0, t4cof = 0, t5cof = 0;
+  if (isimp) { omgcof = 0; xmcof = 0; cc5 = 0; }
+  else {
+    double cc1sq = cc1 * cc1;
+    d2 = 4.0 * ao * tsi * cc1sq;
+    double temp = d2 * tsi * cc1 / 3.0;
+    d3 = (17.0 * ao + sfour) * temp;
+    d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+    t3cof = d2 + 2.0 * cc1sq;
+    t4cof = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+    t5cof = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 + 15.0 * cc1sq * (2.0 * d2 + cc1sq));
+  }
+
+  const int i = b.count++;
+  b.epochUnix[i] = (double)daysFromCivil(year, 1, 1) * 86400.0 + (doy - 1.0) * 86400.0;
+  b.id[i] = id;
+  const double sec[SGP4S_COUNT] = { mo, mdot, argpo, argpdot, nodeo, nodedot };
+  for (int k = 0; k < SGP4S_COUNT; k++) b.s[k][i] = sec[k];
+  const double v[SGP4F_COUNT] = {
+    no, ecco, inclo, bstar,
+    ao, sinio, cosio, con41, x1mth2, 7.0 * cosio2 - 1.0,
+    nodecf,
+    cc1, cc4, cc5, d2, d3, d4,
+    t2cof, t3cof, t4cof, t5cof,
+    eta, delmo, sin(mo), omgcof, xmcof, xlcof, aycof
+  };
+  for (int k = 0; k < SGP4F_COUNT; k++) b.f[k][i] = (real)v[k];
+  return true;
+}
+
+// ===== Kernel =====
+// One satellite at tsince minutes from its epoch; sgp4() near-earth path, branch-free.
+// Returns false (outputs undefined) for decayed orbits or eccentricity out of range.
+template <bool VEL>
+static inline bool sgp4At(const Sgp4Batch& b, int i, double tsince, real r[3], real v[3]) {
+  const real XKE = (real)xke();
+  const real TP  = (real)TWO_PI;
+  const real bstar = b.f[SGP4F_BSTAR][i];
+
+  // secular angles in double, one turn (see Sgp4Secular)
+  real xmdf   = (real)fmod(b.s[SGP4S_MO][i]    + b.s[SGP4S_MDOT][i]    * tsince, TWO_PI);
+  real argpdf = (real)fmod(b.s[SGP4S_ARGPO][i] + b.s[SGP4S_ARGPDOT][i] * tsince, TWO_PI);
+  real nodedf = (real)fmod(b.s[SGP4S_NODEO][i] + b.s[SGP4S_NODEDOT][i] * tsince, TWO_PI);
+  real t = (real)tsince, t2 = t * t, t3 = t2 * t, t4 = t3 * t;
+  real nodem = nodedf + b.f[SGP4F_NODECF][i] * t2;
+
+  // secular drag (terms beyond cc1/cc4/t2cof are zero for isimp orbits)
+  real delomg = b.f[SGP4F_OMGCOF][i] * t;
+  real dm = 1 + b.f[SGP4F_ETA][i] * cos(xmdf);
+  real delm = b.f[SGP4F_XMCOF][i] * (dm * dm * dm - b.f[SGP4F_DELMO][i]);
+  real mm = xmdf + delomg + delm;
+  real argpm = argpdf - delomg - delm;
+  real tempa = 1 - b.f[SGP4F_CC1][i] * t - b.f[SGP4F_D2][i] * t2 - b.f[SGP4F_D3][i] * t3 - b.f[SGP4F_D4][i] * t4;
+  real tempe = bstar * b.f[SGP4F_CC4][i] * t + bstar * b.f[SGP4F_CC5][i] * (sin(mm) - b.f[SGP4F_SINMAO][i]);
+  real templ = b.f[SGP4F_T2COF][i] * t2 + b.f[SGP4F_T3COF][i] * t3 +
+               t4 * (b.f[SGP4F_T4COF][i] + t * b.f[SGP4F_T5COF][i]);
+
+  const real no = b.f[SGP4F_NO][i];
+  real am = b.f[SGP4F_AO][i] * tempa * tempa;   // (xke/no)^(2/3) precomputed as ao
+  real nm = XKE / (am * sqrt(am));
+  real em = b.f[SGP4F_ECCO][i] - tempe;
+  bool ok = (em < 1) & (em >= (real)-0.001) & (nm > 0);
+  em = em < (real)1e-6 ? (real)1e-6 : em;
+  mm = mm + no * templ;
+  real xlm = mm + argpm + nodem;
+  nodem = fmod(nodem, TP);
+  argpm = fmod(argpm, TP);
+  xlm   = fmod(xlm, TP);
+  mm    = fmod(xlm - argpm - nodem, TP);
+
+  // long period periodics
+  real axnl = em * cos(argpm);
+  real temp = 1 / (am * (1 - em * em));
+  real aynl = em * sin(argpm) + temp * b.f[SGP4F_AYCOF][i];
+  real xl = mm + argpm + nodem + temp * b.f[SGP4F_XLCOF][i] * axnl;
+
+  // Kepler's equation, fixed Newton steps (clamped like sgp4())
+  real u = fmod(xl - nodem, TP);
+  real eo1 = u, sineo1 = 0, coseo1 = 1;
+  for (int k = 0; k < SGP4B_KEPLER_ITERS; k++) {
+    sineo1 = sin(eo1); coseo1 = cos(eo1);
+    real d = (u - aynl * coseo1 + axnl * sineo1 - eo1) / (1 - coseo1 * axnl - sineo1 * aynl);
+    d = d > (real)0.95 ? (real)0.95 : (d < (real)-0.95 ? (real)-0.95 : d);
+    eo1 += d;
+  }
+  sineo1 = sin(eo1); coseo1 = cos(eo1);
+
+  // short period periodics
+  real ecose = axnl * coseo1 + aynl * sineo1;
+  real esine = axnl * sineo1 - aynl * coseo1;
+  real el2 = axnl * axnl + aynl * aynl;
+  real pl = am * (1 - el2);
+  ok &= pl > 0;
+  real rl = am * (1 - ecose);
+  real betal = sqrt(1 - el2);
+  temp = esine / (1 + betal);
+  real sinu = am / rl * (sineo1 - aynl - axnl * temp);
+  real cosu = am / rl * (coseo1 - axnl + aynl * temp);
+  real su = atan2(sinu, cosu);
+  real sin2u = (cosu + cosu) * sinu;
+  real cos2u = 1 - 2 * sinu * sinu;
+  temp = 1 / pl;
+  real temp1 = (real)(0.5 * J2) * temp;
+  real temp2 = temp1 * temp;
+
+  const real con41 = b.f[SGP4F_CON41][i], x1mth2 = b.f[SGP4F_X1MTH2][i];
+  const real sinio = b.f[SGP4F_SINIO][i], cosio = b.f[SGP4F_COSIO][i];
+  real mrt = rl * (1 - (real)1.5 * temp2 * betal * con41) + (real)0.5 * temp1 * x1mth2 * cos2u;
+  ok &= mrt >= 1;
+  su = su - (real)0.25 * temp2 * b.f[SGP4F_X7THM1][i] * sin2u;
+  real xnode = nodem + (real)1.5 * temp2 * cosio * sin2u;
+  real xinc = b.f[SGP4F_INCLO][i] + (real)1.5 * temp2 * cosio * sinio * cos2u;
+
+  // orientation vectors
+  real sinsu = sin(su), cossu = cos(su), snod = sin(xnode), cnod = cos(xnode);
+  real sini = sin(xinc), cosi = cos(xinc);
+  real xmx = -snod * cosi, xmy = cnod * cosi;
+  real ux = xmx * sinsu + cnod * cossu, uy = xmy * sinsu + snod * cossu, uz = sini * sinsu;
+  const real R = (real)RE_KM;
+  r[0] = mrt * ux * R; r[1] = mrt * uy * R; r[2] = mrt * uz * R;
+  if (VEL) {
+    const real VK = (real)(RE_KM * xke() / 60.0);
+    real rdotl = sqrt(am) * esine / rl;
+    real rvdotl = sqrt(pl) / rl;
+    real mvt = rdotl - nm * temp1 * x1mth2 * sin2u / XKE;
+    real rvdot = rvdotl + nm * temp1 * (x1mth2 * cos2u + (real)1.5 * con41) / XKE;
+    real vx = xmx * cossu - cnod * sinsu, vy = xmy * cossu - snod * sinsu, vz = sini * cossu;
+    v[0] = (mvt * ux + rvdot * vx) * VK;
+    v[1] = (mvt * uy + rvdot * vy) * VK;
+    v[2] = (mvt * uz + rvdot * vz) * VK;
+  }
+  return ok;
+}
+
+int sgp4BatchPropagate(const Sgp4Batch& b, double unixTime, int from, int to,
+                       sgp4_real* x, sgp4_real* y, sgp4_real* z,
+                       sgp4_real* vx, sgp4_real* vy, sgp4_real* vz) {
+  int failed = 0;
+  for (int i = from; i < to; i++) {
+    double t = (unixTime - b.epochUnix[i]) / 60.0;
+    real r[3], v[3] = { 0, 0, 0 };
+    bool ok = vx ? sgp4At<true>(b, i, t, r, v) : sgp4At<false>(b, i, t, r, v);
+    if (!ok) { r[0] = r[1] = r[2] = 0; v[0] = v[1] = v[2] = 0; failed++; }
+    x[i] = r[0]; y[i] = r[1]; z[i] = r[2];
+    if (vx) { vx[i] = v[0]; vy[i] = v[1]; vz[i] = v[2]; }
+  }
+  return failed;
+}
+
+// ===== Look angles =====
+// IAU-82 GMST (Vallado gstime), UT1 taken as UTC
+double sgp4GmstRad(double unixTime) {
+  double tut1 = (unixTime / 86400.0 + 2440587.5 - 2451545.0) / 36525.0;
+  double temp = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;   // seconds
+  temp = fmod(temp * DEG2RAD / 240.0, TWO_PI);
+  return temp < 0 ? temp + TWO_PI : temp;
+}
+
+void sgp4SiteInit(Sgp4Site& s, double latDeg, double lonDeg, double altM) {
+  const double A = 6378.137, F = 1.0 / 298.257223563, E2 = F * (2.0 - F);   // WGS-84
+  s.latRad = latDeg * DEG2RAD;
+  s.lonRad = lonDeg * DEG2RAD;
+  s.altKm  = altM / 1000.0;
+  double sl = sin(s.latRad), cl = cos(s.latRad);
+  double n = A / sqrt(1.0 - E2 * sl * sl);
+  s.ecef[0] = (n + s.altKm) * cl * cos(s.lonRad);
+  s.ecef[1] = (n + s.altKm) * cl * sin(s.lonRad);
+  s.ecef[2] = (n * (1.0 - E2) + s.altKm) * sl;
+}
+
+int sgp4BatchLook(const Sgp4Batch& b, const Sgp4Site& site, double unixTime, int from, int to,
+                  float* azDeg, float* elDeg, float* rangeKm) {
+  // Per instant: the site and its east/north/up axes rotated into TEME (about z by GMST),
+  // so each satellite needs one subtraction and three dot products
+  double g = sgp4GmstRad(unixTime), cg = cos(g), sg = sin(g);
+  double lst = site.lonRad + g;
+  double sl = sin(site.latRad), cl = cos(site.latRad), so = sin(lst), co = cos(lst);
+  const real px = (real)(cg * site.ecef[0] - sg * site.ecef[1]);
+  const real py = (real)(sg * site.ecef[0] + cg * site.ecef[1]);
+  const real pz = (real)site.ecef[2];
+  const real ex = (real)-so,       ey = (real)co,        ez = 0;
+  const real nx = (real)(-sl * co), ny = (real)(-sl * so), nz = (real)cl;
+  const real ux = (real)(cl * co),  uy = (real)(cl * so),  uz = (real)sl;
+  const real R2D = (real)(360.0 / TWO_PI);
+
+  int failed = 0;
+  for (int i = from; i < to; i++) {
+    double t = (unixTime - b.epochUnix[i]) / 60.0;
+    real r[3];
+    bool ok = sgp4At<false>(b, i, t, r, nullptr);
+    real dx = r[0] - px, dy = r[1] - py, dz = r[2] - pz;
+    real e = ex * dx + ey * dy + ez * dz;
+    real n = nx * dx + ny * dy + nz * dz;
+    real u = ux * dx + uy * dy + uz * dz;
+    real az = atan2(e, n) * R2D;
+    if (az < 0) az += 360;
+    azDeg[i] = ok ? (float)az : 0.0f;
+    elDeg[i] = ok ? (float)(atan2(u, sqrt(e * e + n * n)) * R2D) : -90.0f;
+    if (rangeKm) rangeKm[i] = ok ? (float)sqrt(e * e + n * n + u * u) : 0.0f;
+    failed += !ok;
+  }
+  return failed;
+}
+
+#if SGP4B_THREADS
+int sgp4BatchLookParallel(const Sgp4Batch& b, const Sgp4Site& site, double unixTime,
+                          float* azDeg, float* elDeg, float* rangeKm, int threads) {
+  if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+  if (threads <= 1 || b.count < 256) return sgp4BatchLook(b, site, unixTime, 0, b.count, azDeg, elDeg, rangeKm);
+
+  std::vector<std::thread> pool;
+  std::vector<int> failed(threads, 0);
+  int slice = (b.count + threads - 1) / threads;
+  for (int k = 0; k < threads; k++) {
+    int from = k * slice, to = from + slice < b.count ? from + slice : b.count;
+    if (from >= to) break;
+    pool.emplace_back([&, k, from, to] {
+      failed[k] = sgp4BatchLook(b, site, unixTime, from, to, azDeg, elDeg, rangeKm);
+    });
+  }
+  int total = 0;
+  for (size_t k = 0; k < pool.size(); k++) { pool[k].join(); total += failed[k]; }
+  return total;
+}
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+#include <stdint.h>
+
+// Batch SGP4: propagates many near-earth TLEs to one instant at a time.
+//
+// The elements and every per-satellite constant of Vallado's sgp4init() are kept as a
+// structure of arrays (one contiguous array per quantity), so the kernels stream through
+// memory and run the same branch-free instruction sequence for every satellite (isimp
+// satellites get their higher-order drag terms zeroed instead of a branch; Kepler's
+// equation takes a fixed number of Newton steps). WGS-72 constants, AFSPC mode, no deep
+// space: objects with a period of 225 min or more are rejected by sgp4BatchAdd().
+//
+// Builds without Arduino: the server sketch (ESP32: float, one core) and the host tools
+// (double, SGP4B_THREADS worker threads) compile the same file.
+
+#ifndef SGP4B_USE_FLOAT
+  #if defined(ESP32)
+    #define SGP4B_USE_FLOAT 1   // single-precision FPU; see the secular fields below for the error
+  #else
+    #define SGP4B_USE_FLOAT 0
+  #endif
+#endif
+
+#ifndef SGP4B_THREADS
+  #if defined(ARDUINO)
+    #define SGP4B_THREADS 0
+  #else
+    #define SGP4B_THREADS 1     // std::thread workers in sgp4BatchLookParallel()
+  #endif
+#endif
+
+#define SGP4B_KEPLER_ITERS  8   // Newton steps; converged to double precision for e < 0.25
+
+#if SGP4B_USE_FLOAT
+typedef float  sgp4_real;
+#else
+typedef double sgp4_real;
+#endif
+
+enum Sgp4Field : uint8_t {
+  SGP4F_NO, SGP4F_ECCO, SGP4F_INCLO, SGP4F_BSTAR,
+  SGP4F_AO, SGP4F_SINIO, SGP4F_COSIO, SGP4F_CON41, SGP4F_X1MTH2, SGP4F_X7THM1,
+  SGP4F_NODECF,
+  SGP4F_CC1, SGP4F_CC4, SGP4F_CC5, SGP4F_D2, SGP4F_D3, SGP4F_D4,
+  SGP4F_T2COF, SGP4F_T3COF, SGP4F_T4COF, SGP4F_T5COF,
+  SGP4F_ETA, SGP4F_DELMO, SGP4F_SINMAO, SGP4F_OMGCOF, SGP4F_XMCOF, SGP4F_XLCOF, SGP4F_AYCOF,
+  SGP4F_COUNT
+};
+
+// Mean anomaly, argument of perigee and node with their secular rates are always double
+// and reduced to one turn before the rest of the kernel: a day from epoch the mean anomaly
+// is ~100 rad, where float alone (rate and sum) drifts ~50 m along track, ~130 m at 72 h.
+// With them in double the float kernel stays within ~4 m of double out to 72 h (measured
+// on STARLINK-2094 against the double build; the rest is float rounding in the periodics).
+enum Sgp4Secular : uint8_t {
+  SGP4S_MO, SGP4S_MDOT, SGP4S_ARGPO, SGP4S_ARGPDOT, SGP4S_NODEO, SGP4S_NODEDOT,
+  SGP4S_COUNT
+};
+
+struct Sgp4Batch {
+  int        count;
+  int        capacity;
+  sgp4_real* f[SGP4F_COUNT];   // f[field][sat]
+  double*    s[SGP4S_COUNT];   // s[field][sat]
+  double*    epochUnix;        // TLE epoch (kept in double: tsince needs the fraction)
+  uint32_t*  id;               // caller's tag per satellite (e.g. NORAD id or index position)
+  void*      block;            // one allocation behind all arrays
+};
+
+// Observer, precomputed once per site (WGS-84 geodetic)
+struct Sgp4Site {
+  double latRad, lonRad, altKm;
+  double ecef[3];              // km
+};
+
+// 'capacity' satellites in one allocation of SGP4B_SAT_BYTES each
+#define SGP4B_SAT_BYTES  (SGP4F_COUNT * sizeof(sgp4_real) + (SGP4S_COUNT + 1) * sizeof(double) + sizeof(uint32_t))
+bool sgp4BatchBegin(Sgp4Batch& b, int capacity);
+void sgp4BatchEnd(Sgp4Batch& b);
+void sgp4BatchClear(Sgp4Batch& b);    // keep the allocation, drop the satellites
+
+// Parses and initializes one TLE; false if the lines do not parse, the orbit is deep space
+// or already decayed, or the batch is full
+bool sgp4BatchAdd(Sgp4Batch& b, const char* line1, const char* line2, uint32_t id);
+
+void sgp4SiteInit(Sgp4Site& s, double latDeg, double lonDeg, double altM);
+
+// TEME position (km) and velocity (km/s) of satellites [from, to) at unixTime. vx may be
+// null (positions only). Returns how many failed (decayed / eccentricity out of range);
+// their outputs are 0.
+int sgp4BatchPropagate(const Sgp4Batch& b, double unixTime, int from, int to,
+                       sgp4_real* x, sgp4_real* y, sgp4_real* z,
+                       sgp4_real* vx, sgp4_real* vy, sgp4_real* vz);
+
+// Topocentric azimuth/elevation (deg) and range (km) of satellites [from, to) from 'site'.
+// rangeKm may be null. Failed satellites get elevation -90 and range 0; returns how many.
+int sgp4BatchLook(const Sgp4Batch& b, const Sgp4Site& site, double unixTime, int from, int to,
+                  float* azDeg, float* elDeg, float* rangeKm);
+
+#if SGP4B_THREADS
+// sgp4BatchLook() over the whole batch, split into contiguous slices across 'threads'
+// workers (0: one per hardware thread)
+int sgp4BatchLookParallel(const Sgp4Batch& b, const Sgp4Site& site, double unixTime,
+                          float* azDeg, float* elDeg, float* rangeKm, int threads);
+#endif
+
+double sgp4GmstRad(double unixTime);   // Greenwich mean sidereal angle (IAU-82, UT1 = UTC)
@@ -0,0 +1,39 @@
+#!/usr/bin/env python3
+import sys, os, gzip, hashlib
+
+# Command: python3 build_web_ui.py
+# Compresses server_module/web/index.html into server_module/WebUi.h (gzip bytes in flash + ETag).
+# Run it after every change to index.html and commit both files.
+
+here = os.path.dirname(os.path.abspath(__file__))
+src = os.path.join(here, "..", "server_module", "web", "index.html")
+dst = os.path.join(here, "..", "server_module", "WebUi.h")
+if len(sys.argv) > 1: src = sys.argv[1]
+if len(sys.argv) > 2: dst = sys.argv[2]
+
+with open(src, "rb") as f:
+    html = f.read()
+
+# mtime=0 keeps the output identical for identical input (stable ETag, clean diffs)
+gz = gzip.compress(html, compresslevel=9, mtime=0)
+etag = '"' + hashlib.sha1(html).hexdigest()[:16] + '"'
+
+lines = []
+lines.append("#pragma once")
+lines.append("#include <Arduino.h>")
+lines.append("")
+lines.append("// Generated by setupfiles/build_web_ui.py from web/index.html -- do not edit.")
+lines.append(f"// {len(html)} bytes of HTML, {len(gz)} bytes gzipped.")
+lines.append("")
+lines.append(f"#define WEB_INDEX_ETAG   \"{etag.replace(chr(34), chr(92) + chr(34))}\"")
+lines.append(f"#define WEB_INDEX_GZ_LEN {len(gz)}")
+lines.append("")
+lines.append("static const uint8_t WEB_INDEX_GZ[WEB_INDEX_GZ_LEN] PROGMEM = {")
+for i in range(0, len(gz), 16):
+    lines.append("  " + ",".join(f"0x{b:02x}" for b in gz[i:i+16]) + ",")
+lines.append("};")
+
+with open(dst, "w", newline="\n") as f:
+    f.write("\n".join(lines) + "\n")
+
+print(f"{os.path.basename(src)}: {len(html)} -> {len(gz)} bytes, ETag {etag}, wrote {os.path.normpath(dst)}")
@@ -11,6 +11,8 @@ from PyQt5.QtWidgets import (
 from PyQt5.QtCore import QDateTime
 import requests
 import os
+import struct
+import calendar
 
 # Fetch latest Starlink TLE data from Celestrak database
 TLE_TXT = "starlink_tle.txt"
@@ -148,6 +150,39 @@ def calculate_elevation(user_coord, sat_coord):
     elevation = 90 - math.degrees(c)
     return elevation
 
+# Binary catalog (read by server_module/SatCatalog.cpp, keep both in sync)
+CATALOG_FILE = "sat_catalog.bin"
+CATALOG_MAGIC = b"SATC"
+CATALOG_VERSION = 1
+CATALOG_HEADER = struct.Struct("<4sHHIII12x")       # 32 bytes
+CATALOG_RECORD = struct.Struct("<IIdff28s70s70s")   # 192 bytes
+
+def to_unix(dt):
+    """Naive datetime (treated as UTC) -> unix seconds with fraction."""
+    return calendar.timegm(dt.timetuple()) + dt.microsecond / 1e6
+
+def write_catalog(entries, filename):
+    """Write fixed-size records so the server can seek straight to record i."""
+    with open(filename, "wb") as f:
+        f.write(CATALOG_HEADER.pack(CATALOG_MAGIC, CATALOG_VERSION, CATALOG_RECORD.size,
+                                    len(entries), int(to_unix(datetime.utcnow())),
+                                    CATALOG_HEADER.size))
+        for entry in entries:
+            line1 = entry["tle"]["line-1"]
+            line2 = entry["tle"]["line-2"]
+            epoch = parse_tle_lines(line1, line2)["epoch"]
+            exported = datetime.fromisoformat(entry["datetime_utc"])
+            f.write(CATALOG_RECORD.pack(
+                int(line1[2:7]),
+                int(to_unix(exported)),
+                to_unix(epoch),
+                entry["distance_km"],
+                entry["elevation_deg"],
+                entry["name"].encode("ascii", "replace")[:27],
+                line1.encode("ascii")[:69],
+                line2.encode("ascii")[:69],
+            ))
+
 # Interface
 class SatelliteFinder(QWidget):
     def __init__(self):
@@ -339,6 +374,9 @@ class SatelliteFinder(QWidget):
                 json.dump(chunk, f, indent=4)
             files_written.append(f"{filename} ({len(chunk)} satellites)")
 
+        write_catalog(nearby, CATALOG_FILE)
+        files_written.append(f"{CATALOG_FILE} ({len(nearby)} satellites, binary)")
+
         msg = (
             f"Exported {len(nearby)} records into {len(files_written)} file(s):\n" +
             "\n".join(files_written) +
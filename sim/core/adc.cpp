@@ -0,0 +1,77 @@
+// ADC continuous driver stand-in. Frames are produced at the configured sample rate on
+// the local clock; the "microphone" is a quiet 440 Hz tone plus noise around mid-scale.
+#include <Arduino.h>
+#include <esp_adc/adc_continuous.h>
+
+struct adc_continuous_ctx_t {
+  uint32_t frameBytes = 256;
+  uint32_t rate = 20000;
+  uint8_t  channel = 0;
+  bool     running = false;
+  int64_t  startUs = 0;
+  uint64_t produced = 0;   // samples handed out since start
+  uint32_t noise = 1;
+};
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t* cfg, adc_continuous_handle_t* out) {
+  if (!cfg || !out || !cfg->conv_frame_size) return ESP_ERR_INVALID_ARG;
+  adc_continuous_handle_t h = new adc_continuous_ctx_t;
+  h->frameBytes = cfg->conv_frame_size;
+  *out = h;
+  return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t h) { delete h; return ESP_OK; }
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t h, const adc_continuous_config_t* cfg) {
+  if (!h || !cfg || !cfg->pattern_num || !cfg->sample_freq_hz) return ESP_ERR_INVALID_ARG;
+  if (h->running) return ESP_ERR_INVALID_STATE;
+  h->rate = cfg->sample_freq_hz;
+  h->channel = cfg->adc_pattern[0].channel;
+  return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t, const adc_continuous_evt_cbs_t*, void*) {
+  return ESP_OK;   // the pool never overflows here: frames are generated on demand
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t h) {
+  h->running = true;
+  h->startUs = sim::localUs();
+  h->produced = 0;
+  return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t h) { h->running = false; return ESP_OK; }
+
+esp_err_t adc_continuous_read(adc_continuous_handle_t h, uint8_t* buf, uint32_t maxLen, uint32_t* outLen, uint32_t timeoutMs) {
+  *outLen = 0;
+  if (!h || !h->running) return ESP_ERR_INVALID_STATE;
+  uint32_t samples = min(h->frameBytes, maxLen) / SOC_ADC_DIGI_RESULT_BYTES;
+  // a frame is ready once the clock has passed its last sample
+  int64_t readyUs = h->startUs + (int64_t)((h->produced + samples) * 1000000ULL / h->rate);
+  int64_t waitUs = readyUs - sim::localUs();
+  if (waitUs > (int64_t)timeoutMs * 1000) { sim::sleepUs((int64_t)timeoutMs * 1000); return ESP_ERR_TIMEOUT; }
+  if (waitUs > 0) sim::sleepUs(waitUs);
+
+  for (uint32_t i = 0; i < samples; i++) {
+    double t = (double)(h->produced + i) / h->rate;
+    h->noise = h->noise * 1664525u + 1013904223u;
+    int v = 2048 + (int)(120.0 * sin(2.0 * PI * 440.0 * t)) + (int)((h->noise >> 24) % 41) - 20;
+    adc_digi_output_data_t d;
+    d.type1.data = constrain(v, 0, 4095);
+    d.type1.channel = h->channel;
+    memcpy(buf + i * SOC_ADC_DIGI_RESULT_BYTES, &d, SOC_ADC_DIGI_RESULT_BYTES);
+  }
+  h->produced += samples;
+  *outLen = samples * SOC_ADC_DIGI_RESULT_BYTES;
+  return ESP_OK;
+}
+
+esp_err_t adc_continuous_io_to_channel(int gpio, adc_unit_t* unit, adc_channel_t* channel) {
+  static const int8_t adc1[] = { 36, 37, 38, 39, 32, 33, 34, 35 };   // ADC1_CH0..7 on the ESP32
+  for (int i = 0; i < 8; i++) {
+    if (adc1[i] == gpio) { *unit = ADC_UNIT_1; *channel = (adc_channel_t)i; return ESP_OK; }
+  }
+  return ESP_ERR_INVALID_ARG;
+}
@@ -0,0 +1,316 @@
+// Arduino core stand-in: clocks, Serial, GPIO/DAC, hardware timers, WiFi identity.
+#include <Arduino.h>
+#include <WiFi.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <hal/dac_ll.h>
+#include <soc/gpio_struct.h>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+SPIClass SPI;
+TwoWire Wire;
+gpio_dev_t GPIO;
+
+namespace sim {
+
+Config cfg;
+
+static int64_t hostMonoUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const int64_t sBootUs = hostMonoUs();
+
+int64_t localUs() {
+  int64_t host = hostMonoUs() - sBootUs;
+  return host + (int64_t)((double)host * cfg.driftPpm * 1e-6);
+}
+
+int64_t worldUs() {
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 + (int64_t)(cfg.worldOffsetS * 1e6);
+}
+
+void sleepUs(int64_t us) {
+  if (us <= 0) { std::this_thread::yield(); return; }
+  std::this_thread::sleep_for(std::chrono::microseconds((int64_t)(us / (1.0 + cfg.driftPpm * 1e-6))));
+}
+
+} // namespace sim
+
+// ===== Time =====
+
+unsigned long micros() { return (unsigned long)(uint32_t)sim::localUs(); }
+unsigned long millis() { return (unsigned long)(uint32_t)(sim::localUs() / 1000); }
+int64_t esp_timer_get_time() { return sim::localUs(); }
+void delay(uint32_t ms) { sim::sleepUs((int64_t)ms * 1000); }
+void yield() { std::this_thread::yield(); }
+
+void delayMicroseconds(uint32_t us) {
+  int64_t end = sim::localUs() + us;
+  if (us > 2000) sim::sleepUs(us - 1000);
+  while (sim::localUs() < end) std::this_thread::yield();
+}
+
+static std::mt19937 sRng(12345);
+void randomSeed(unsigned long seed) { sRng.seed(seed); }
+long random(long max) { return max > 0 ? (long)(sRng() % (unsigned long)max) : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+uint32_t esp_random() { static std::random_device rd; return rd(); }
+
+// ===== Print / Stream / Serial =====
+
+size_t Print::printf(const char* fmt, ...) {
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if (n < (int)sizeof(buf)) return write((const uint8_t*)buf, n);
+  std::string big(n + 1, '\0');
+  va_start(ap, fmt);
+  vsnprintf(&big[0], n + 1, fmt, ap);
+  va_end(ap);
+  return write((const uint8_t*)big.data(), n);
+}
+
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    sim::sleepUs(500);
+  } while (millis() - start < _timeout);
+  return -1;
+}
+
+int Stream::timedPeek() {
+  unsigned long start = millis();
+  do {
+    int c = peek();
+    if (c >= 0) return c;
+    sim::sleepUs(500);
+  } while (millis() - start < _timeout);
+  return -1;
+}
+
+size_t Stream::readBytes(char* buf, size_t n) {
+  size_t k = 0;
+  while (k < n) { int c = timedRead(); if (c < 0) break; buf[k++] = (char)c; }
+  return k;
+}
+
+size_t Stream::readBytesUntil(char term, char* buf, size_t n) {
+  size_t k = 0;
+  while (k < n) { int c = timedRead(); if (c < 0 || c == term) break; buf[k++] = (char)c; }
+  return k;
+}
+
+String Stream::readString() {
+  String s;
+  for (int c; (c = timedRead()) >= 0; ) s += (char)c;
+  return s;
+}
+
+String Stream::readStringUntil(char term) {
+  String s;
+  for (int c; (c = timedRead()) >= 0 && c != term; ) s += (char)c;
+  return s;
+}
+
+bool Stream::find(const char* target) {
+  size_t len = strlen(target), matched = 0;
+  if (!len) return true;
+  for (int c; (c = timedRead()) >= 0; ) {
+    matched = (c == target[matched]) ? matched + 1 : (c == target[0] ? 1 : 0);
+    if (matched == len) return true;
+  }
+  return false;
+}
+
+long Stream::parseInt() {
+  int c;
+  while ((c = timedPeek()) >= 0 && c != '-' && !isDigit((char)c)) read();
+  bool neg = false;
+  long v = 0;
+  if (c == '-') { neg = true; read(); }
+  while ((c = timedPeek()) >= 0 && isDigit((char)c)) { v = v * 10 + (c - '0'); read(); }
+  return neg ? -v : v;
+}
+
+float Stream::parseFloat() {
+  int c;
+  char buf[32];
+  size_t n = 0;
+  while ((c = timedPeek()) >= 0 && c != '-' && c != '.' && !isDigit((char)c)) read();
+  while ((c = timedPeek()) >= 0 && (isDigit((char)c) || c == '.' || c == '-') && n < sizeof(buf) - 1) { buf[n++] = (char)c; read(); }
+  buf[n] = 0;
+  return (float)atof(buf);
+}
+
+static std::mutex sOutLock;
+static uint8_t sInBuf[256];
+static size_t  sInLen = 0, sInPos = 0;
+
+void HardwareSerial::begin(unsigned long, uint32_t, int8_t, int8_t) {}
+
+int HardwareSerial::available() {
+  if (sInPos == sInLen) {
+    sInPos = sInLen = 0;
+    pollfd p = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&p, 1, 0) == 1 && (p.revents & POLLIN)) {
+      ssize_t n = ::read(STDIN_FILENO, sInBuf, sizeof(sInBuf));
+      if (n > 0) sInLen = n;
+    }
+  }
+  return (int)(sInLen - sInPos);
+}
+int HardwareSerial::read() { return available() ? sInBuf[sInPos++] : -1; }
+int HardwareSerial::peek() { return available() ? sInBuf[sInPos] : -1; }
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+  std::lock_guard<std::mutex> g(sOutLock);
+  return fwrite(buf, 1, n, stdout);
+}
+void HardwareSerial::flush() { std::lock_guard<std::mutex> g(sOutLock); fflush(stdout); }
+
+// ===== ESP =====
+
+#define SIM_HEAP_BYTES (320u * 1024u)   // DRAM heap of a plain ESP32 with WiFi up, roughly
+
+uint32_t EspClass::getHeapSize()     { return SIM_HEAP_BYTES; }
+uint32_t EspClass::getFreeHeap()     { int64_t f = SIM_HEAP_BYTES - sim::heapInUse(); return f > 0 ? (uint32_t)f : 0; }
+uint32_t EspClass::getMinFreeHeap()  { int64_t f = SIM_HEAP_BYTES - sim::heapPeak(); return f > 0 ? (uint32_t)f : 0; }
+uint32_t EspClass::getMaxAllocHeap() { return getFreeHeap(); }
+uint32_t EspClass::getCycleCount()   { return (uint32_t)(sim::localUs() * 240); }
+uint64_t EspClass::getEfuseMac()     { return 0x00004F286F24ULL | ((uint64_t)sim::cfg.ip << 40); }
+
+extern char** simArgv;   // sim_main.cpp
+void simRunShutdownHandlers();   // nvs.cpp
+void EspClass::restart() {
+  simRunShutdownHandlers();
+  Serial.println("[SIM] ESP.restart()");
+  fflush(stdout);
+  execv("/proc/self/exe", simArgv);
+  _exit(1);
+}
+
+// ===== GPIO / DAC =====
+
+#define SIM_GPIO_PINS 40
+static std::atomic<uint8_t> sLevel[SIM_GPIO_PINS];
+static uint8_t sMode[SIM_GPIO_PINS];
+
+static void setLevel(int pin, int level) {
+  if (pin < 0 || pin >= SIM_GPIO_PINS) return;
+  uint8_t v = level ? 1 : 0;
+  if (sLevel[pin].exchange(v) != v) sim::statGpio(pin, v);
+}
+
+void SimGpioReg::operator=(uint32_t mask) {
+  for (int b = 0; b < 32; b++) if (mask & (1UL << b)) setLevel(base + b, set);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= SIM_GPIO_PINS) return;
+  sMode[pin] = mode;
+  if (mode == INPUT_PULLUP) sLevel[pin] = 1;
+}
+void digitalWrite(uint8_t pin, uint8_t level) { setLevel(pin, level); }
+int  digitalRead(uint8_t pin) { return pin < SIM_GPIO_PINS ? sLevel[pin].load() : 0; }
+uint16_t analogRead(uint8_t) { return 2048; }
+void analogReadResolution(uint8_t) {}
+void analogSetPinAttenuation(uint8_t, adc_attenuation_t) {}
+int  digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(uint8_t, void (*)(), int) {}   // no external signals in the simulation
+void detachInterrupt(uint8_t) {}
+
+void dacWrite(uint8_t pin, uint8_t value) { sim::statDac(pin == 25 ? 0 : 1, value); }
+void dac_ll_update_output_value(dac_channel_t chan, uint8_t value) { sim::statDac((int)chan, value); }
+
+// ===== Hardware timers =====
+// One thread per timer. It wakes every millisecond and runs the ISR as many times as
+// periods have elapsed on the local clock, so the average rate is exact without a
+// host thread spinning at 20 kHz per module.
+
+#define SIM_TIMER_SLICE_US 1000
+
+struct hw_timer_s {
+  uint32_t freq = 1000000;
+  void (*isr)() = nullptr;
+  uint64_t alarm = 0;
+  bool autoreload = true;
+  std::atomic<bool> enabled { false };
+  std::atomic<bool> quit { false };
+  std::thread th;
+};
+
+static void timerThread(hw_timer_t* t) {
+  int64_t start = sim::localUs();
+  uint64_t fired = 0;
+  while (!t->quit) {
+    sim::sleepUs(SIM_TIMER_SLICE_US);
+    if (!t->enabled || !t->isr || !t->alarm) { start = sim::localUs(); fired = 0; continue; }
+    double periodUs = (double)t->alarm * 1e6 / t->freq;
+    uint64_t due = (uint64_t)((sim::localUs() - start) / periodUs);
+    for (int guard = 0; fired < due && guard < 100000; guard++) {
+      fired++;
+      t->isr();
+      if (!t->autoreload) { t->enabled = false; break; }
+    }
+    if (fired < due) fired = due;   // fell too far behind: drop, don't burst
+  }
+}
+
+hw_timer_t* timerBegin(uint32_t frequency) {
+  hw_timer_t* t = new hw_timer_t;
+  t->freq = frequency ? frequency : 1000000;
+  t->th = std::thread(timerThread, t);
+  return t;
+}
+void timerEnd(hw_timer_t* t) {
+  if (!t) return;
+  t->quit = true;
+  t->th.join();
+  delete t;
+}
+void timerAttachInterrupt(hw_timer_t* t, void (*isr)()) { t->isr = isr; }
+void timerDetachInterrupt(hw_timer_t* t) { t->isr = nullptr; }
+void timerAlarm(hw_timer_t* t, uint64_t alarmValue, bool autoreload, uint64_t) {
+  t->alarm = alarmValue;
+  t->autoreload = autoreload;
+  t->enabled = true;
+}
+void timerStart(hw_timer_t* t) { t->enabled = true; }
+void timerStop(hw_timer_t* t)  { t->enabled = false; }
+
+// ===== WiFi identity =====
+
+IPAddress WiFiClass::softAPIP()  { return IPAddress(192, 168, 4, 1); }
+IPAddress WiFiClass::gatewayIP() { return IPAddress(192, 168, 4, 1); }
+IPAddress WiFiClass::localIP()   { return IPAddress(192, 168, 4, (uint8_t)sim::cfg.ip); }
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  const uint8_t m[6] = { 0x24, 0x6F, 0x28, 0x00, 0x00, (uint8_t)sim::cfg.ip };
+  memcpy(mac, m, 6);
+  return mac;
+}
+String WiFiClass::macAddress() {
+  uint8_t m[6];
+  macAddress(m);
+  char b[18];
+  snprintf(b, sizeof(b), "%02X:%02X:%02X:%02X:%02X:%02X", m[0], m[1], m[2], m[3], m[4], m[5]);
+  return String(b);
+}
@@ -0,0 +1,146 @@
+// SD card stand-in: paths are relative to sim::cfg.sdRoot.
+#include <SD.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+SDFS SD;
+
+namespace fs {
+
+struct FileImpl {
+  FILE*       f = nullptr;
+  DIR*        d = nullptr;
+  std::string path;    // as the sketch sees it ("/sat_data_1.json")
+  std::string name;    // last component
+  ~FileImpl() { if (f) fclose(f); if (d) closedir(d); }
+};
+
+} // namespace fs
+
+static bool sMounted = false;
+
+static std::string hostPath(const char* path) {
+  std::string p = sim::cfg.sdRoot ? sim::cfg.sdRoot : ".";
+  if (!path || path[0] != '/') p += '/';
+  return p + (path ? path : "");
+}
+
+static std::shared_ptr<fs::FileImpl> openImpl(const std::string& path, const char* mode) {
+  std::string host = hostPath(path.c_str());
+  auto impl = std::make_shared<fs::FileImpl>();
+  impl->path = path;
+  size_t slash = path.find_last_of('/');
+  impl->name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+  struct stat st;
+  if (stat(host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    impl->d = opendir(host.c_str());
+    return impl->d ? impl : nullptr;
+  }
+  const char* m = "rb";
+  if (mode[0] == 'w') m = (mode[1] == '+') ? "w+b" : "wb";
+  else if (mode[0] == 'a') m = (mode[1] == '+') ? "a+b" : "ab";
+  else if (mode[1] == '+') m = "r+b";
+  impl->f = fopen(host.c_str(), m);
+  return impl->f ? impl : nullptr;
+}
+
+namespace fs {
+
+size_t File::write(uint8_t c) { return write(&c, 1); }
+size_t File::write(const uint8_t* buf, size_t n) { return (_p && _p->f) ? fwrite(buf, 1, n, _p->f) : 0; }
+
+int File::available() {
+  if (!_p || !_p->f) return 0;
+  long left = (long)size() - (long)position();
+  return left > 0 ? (int)left : 0;
+}
+
+int File::read() {
+  if (!_p || !_p->f) return -1;
+  int c = fgetc(_p->f);
+  return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t* buf, size_t n) { return (_p && _p->f) ? fread(buf, 1, n, _p->f) : 0; }
+
+int File::peek() {
+  if (!_p || !_p->f) return -1;
+  int c = fgetc(_p->f);
+  if (c == EOF) return -1;
+  ungetc(c, _p->f);
+  return c;
+}
+
+void File::flush() { if (_p && _p->f) fflush(_p->f); }
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_p || !_p->f) return false;
+  int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+  return fseek(_p->f, pos, whence) == 0;
+}
+
+size_t File::position() const { return (_p && _p->f) ? (size_t)ftell(_p->f) : 0; }
+
+size_t File::size() const {
+  if (!_p || !_p->f) return 0;
+  fflush(_p->f);
+  struct stat st;
+  return fstat(fileno(_p->f), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() { _p.reset(); }
+File::operator bool() const { return _p != nullptr; }
+const char* File::name() const { return _p ? _p->name.c_str() : ""; }
+const char* File::path() const { return _p ? _p->path.c_str() : ""; }
+bool File::isDirectory() const { return _p && _p->d; }
+
+File File::openNextFile(const char* mode) {
+  if (!_p || !_p->d) return File();
+  while (dirent* e = readdir(_p->d)) {
+    if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, "..")) continue;
+    std::string child = _p->path;
+    if (child.empty() || child.back() != '/') child += '/';
+    child += e->d_name;
+    auto impl = openImpl(child, mode);
+    if (impl) return File(impl);
+  }
+  return File();
+}
+
+void File::rewindDirectory() { if (_p && _p->d) rewinddir(_p->d); }
+
+File FS::open(const char* path, const char* mode, bool) {
+  if (!sMounted) return File();
+  auto impl = openImpl(path ? path : "/", mode ? mode : FILE_READ);
+  return impl ? File(impl) : File();
+}
+
+bool FS::exists(const char* path) { struct stat st; return sMounted && stat(hostPath(path).c_str(), &st) == 0; }
+bool FS::remove(const char* path) { return sMounted && unlink(hostPath(path).c_str()) == 0; }
+bool FS::rename(const char* a, const char* b) { return sMounted && ::rename(hostPath(a).c_str(), hostPath(b).c_str()) == 0; }
+bool FS::mkdir(const char* path) { return sMounted && ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+bool FS::rmdir(const char* path) { return sMounted && ::rmdir(hostPath(path).c_str()) == 0; }
+
+} // namespace fs
+
+bool SDFS::begin(uint8_t, SPIClass&, uint32_t, const char*, uint8_t, bool) {
+  struct stat st;
+  sMounted = sim::cfg.sdRoot && stat(sim::cfg.sdRoot, &st) == 0 && S_ISDIR(st.st_mode);
+  return sMounted;
+}
+
+sdcard_type_t SDFS::cardType() { return sMounted ? CARD_SDHC : CARD_NONE; }
+uint64_t SDFS::cardSize() { return 8ULL << 30; }
+
+uint64_t SDFS::totalBytes() {
+  struct statvfs v;
+  return (sMounted && statvfs(sim::cfg.sdRoot, &v) == 0) ? (uint64_t)v.f_blocks * v.f_frsize : 0;
+}
+
+uint64_t SDFS::usedBytes() {
+  struct statvfs v;
+  return (sMounted && statvfs(sim::cfg.sdRoot, &v) == 0) ? (uint64_t)(v.f_blocks - v.f_bfree) * v.f_frsize : 0;
+}
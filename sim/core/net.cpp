@@ -0,0 +1,344 @@
+// WiFi sockets on loopback. Module x of the simulated AP network 192.168.4.0/24 binds
+// 127.0.4.x, so every module has its own address (the server tells clients apart by IP)
+// and all of them can use the same fixed ports. Privileged ports get SIM_PORT_OFFSET.
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "../../server_module/NetProto.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define SIM_TCP_WRITE_TIMEOUT_MS 3000   // like the core's blocking WiFiClient::write
+
+namespace sim {
+
+uint32_t hostAddr(const uint8_t ip[4]) {
+  uint8_t a = ip[0], b = ip[1], c = ip[2], d = ip[3];
+  if (a == 0 && b == 0 && c == 0 && d == 0) { a = 127; b = 0; c = 4; d = (uint8_t)cfg.ip; }
+  else if (a == 192 && b == 168) { a = 127; b = 0; }
+  return htonl(((uint32_t)a << 24) | ((uint32_t)b << 16) | ((uint32_t)c << 8) | d);
+}
+
+void simAddr(uint32_t n, uint8_t out[4]) {
+  uint32_t h = ntohl(n);
+  out[0] = h >> 24; out[1] = h >> 16; out[2] = h >> 8; out[3] = h;
+  if (out[0] == 127 && out[1] == 0 && out[2] != 0) { out[0] = 192; out[1] = 168; }
+}
+
+uint16_t hostPort(uint16_t port) { return (port && port < 1024) ? port + SIM_PORT_OFFSET : port; }
+uint16_t simPort(uint16_t port)  { return (port >= SIM_PORT_OFFSET && port < SIM_PORT_OFFSET + 1024) ? port - SIM_PORT_OFFSET : port; }
+
+} // namespace sim
+
+static sockaddr_in makeAddr(const IPAddress& ip, uint16_t port) {
+  sockaddr_in a = {};
+  a.sin_family = AF_INET;
+  a.sin_addr.s_addr = sim::hostAddr(ip.raw());
+  a.sin_port = htons(sim::hostPort(port));
+  return a;
+}
+
+static sockaddr_in ownAddr(uint16_t port) { return makeAddr(IPAddress(0, 0, 0, 0), port); }
+
+static IPAddress fromSockaddr(const sockaddr_in& a) {
+  uint8_t b[4];
+  sim::simAddr(a.sin_addr.s_addr, b);
+  return IPAddress(b[0], b[1], b[2], b[3]);
+}
+
+// ===== Module link wire tap =====
+// Follows the NetFrameHeader framing of one direction of a link connection and reports
+// each frame (type + leading id field) to the statistics.
+
+struct LinkTap {
+  uint8_t  hdr[sizeof(NetFrameHeader)];
+  size_t   hdrGot = 0;
+  uint32_t left = 0;
+  uint8_t  id[4];
+  size_t   idGot = 0;
+  bool     inPayload = false;
+
+  void emit(bool tx) {
+    uint32_t v = 0;
+    if (idGot == 4) memcpy(&v, id, 4);
+    sim::statLinkFrame(tx, hdr[2], v);
+    hdrGot = 0; idGot = 0; inPayload = false;
+  }
+
+  void feed(const uint8_t* p, size_t n, bool tx) {
+    while (n) {
+      if (!inPayload) {
+        hdr[hdrGot++] = *p++; n--;
+        if (hdrGot < sizeof(hdr)) continue;
+        NetFrameHeader h;
+        memcpy(&h, hdr, sizeof(h));
+        left = h.len;
+        inPayload = true;
+        if (!left) emit(tx);
+        continue;
+      }
+      size_t k = min((size_t)left, n);
+      for (size_t i = 0; i < k && idGot < 4; i++) id[idGot++] = p[i];
+      p += k; n -= k; left -= k;
+      if (!left) emit(tx);
+    }
+  }
+};
+
+struct SimSocket {
+  int  fd;
+  bool tapped = false;
+  LinkTap txTap, rxTap;
+  explicit SimSocket(int f) : fd(f) {
+    sockaddr_in l = {}, r = {};
+    socklen_t n = sizeof(l);
+    getsockname(fd, (sockaddr*)&l, &n);
+    n = sizeof(r);
+    getpeername(fd, (sockaddr*)&r, &n);
+    tapped = ntohs(l.sin_port) == NET_LINK_PORT || ntohs(r.sin_port) == NET_LINK_PORT;
+  }
+  ~SimSocket() { if (fd >= 0) ::close(fd); }
+};
+
+// ===== WiFiClient =====
+
+WiFiClient::WiFiClient(int fd) : _s(std::make_shared<SimSocket>(fd)) {}
+
+int WiFiClient::fd() const { return _s ? _s->fd : -1; }
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) { return connect(ip, port, 3000); }
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  IPAddress ip;
+  return ip.fromString(host) ? connect(ip, port) : 0;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+  stop();
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (fd < 0) return 0;
+  sockaddr_in me = ownAddr(0), to = makeAddr(ip, port);
+  if (bind(fd, (sockaddr*)&me, sizeof(me)) < 0) { ::close(fd); return 0; }
+  if (::connect(fd, (sockaddr*)&to, sizeof(to)) < 0) {
+    if (errno != EINPROGRESS) { ::close(fd); return 0; }
+    pollfd p = { fd, POLLOUT, 0 };
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (poll(&p, 1, timeoutMs) != 1 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err) { ::close(fd); return 0; }
+  }
+  _s = std::make_shared<SimSocket>(fd);
+  return 1;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t n) {
+  if (!_s || _s->fd < 0) return 0;
+  size_t done = 0;
+  unsigned long start = millis();
+  while (done < n) {
+    ssize_t w = send(_s->fd, buf + done, n - done, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (w > 0) {
+      if (_s->tapped) _s->txTap.feed(buf + done, w, true);
+      done += w;
+      continue;
+    }
+    if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && millis() - start < SIM_TCP_WRITE_TIMEOUT_MS) {
+      pollfd p = { _s->fd, POLLOUT, 0 };
+      poll(&p, 1, 10);
+      continue;
+    }
+    break;
+  }
+  return done;
+}
+
+int WiFiClient::available() {
+  if (!_s || _s->fd < 0) return 0;
+  int n = 0;
+  return ioctl(_s->fd, FIONREAD, &n) == 0 ? n : 0;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t n) {
+  if (!_s || _s->fd < 0) return -1;
+  ssize_t r = recv(_s->fd, buf, n, MSG_DONTWAIT);
+  if (r > 0 && _s->tapped) _s->rxTap.feed(buf, r, false);
+  return r > 0 ? (int)r : (r == 0 ? 0 : -1);
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::peek() {
+  uint8_t c;
+  if (!_s || _s->fd < 0) return -1;
+  return recv(_s->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+void WiFiClient::stop() {
+  if (_s && _s->fd >= 0) { ::close(_s->fd); _s->fd = -1; }
+  _s.reset();
+}
+
+uint8_t WiFiClient::connected() {
+  if (!_s || _s->fd < 0) return 0;
+  uint8_t c;
+  ssize_t r = recv(_s->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (r > 0) return 1;
+  if (r == 0) return 0;
+  return (errno == EAGAIN || errno == EWOULDBLOCK) ? 1 : 0;
+}
+
+IPAddress WiFiClient::remoteIP() const {
+  sockaddr_in a = {};
+  socklen_t n = sizeof(a);
+  if (!_s || _s->fd < 0 || getpeername(_s->fd, (sockaddr*)&a, &n) < 0) return IPAddress();
+  return fromSockaddr(a);
+}
+
+uint16_t WiFiClient::remotePort() const {
+  sockaddr_in a = {};
+  socklen_t n = sizeof(a);
+  if (!_s || _s->fd < 0 || getpeername(_s->fd, (sockaddr*)&a, &n) < 0) return 0;
+  return sim::simPort(ntohs(a.sin_port));
+}
+
+IPAddress WiFiClient::localIP() const {
+  sockaddr_in a = {};
+  socklen_t n = sizeof(a);
+  if (!_s || _s->fd < 0 || getsockname(_s->fd, (sockaddr*)&a, &n) < 0) return IPAddress();
+  return fromSockaddr(a);
+}
+
+int WiFiClient::setNoDelay(bool nodelay) {
+  int v = nodelay ? 1 : 0;
+  return (_s && _s->fd >= 0) ? setsockopt(_s->fd, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v)) : -1;
+}
+
+// ===== WiFiServer =====
+
+void WiFiServer::begin(uint16_t port) {
+  if (port) _port = port;
+  end();
+  _fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  int one = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in me = ownAddr(_port);
+  if (bind(_fd, (sockaddr*)&me, sizeof(me)) < 0 || listen(_fd, _max) < 0) {
+    fprintf(stderr, "[SIM] TCP listen on port %u failed: %s\n", sim::hostPort(_port), strerror(errno));
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+void WiFiServer::end() {
+  if (_fd >= 0) ::close(_fd);
+  _fd = -1;
+}
+
+bool WiFiServer::hasClient() {
+  if (_fd < 0) return false;
+  pollfd p = { _fd, POLLIN, 0 };
+  return poll(&p, 1, 0) == 1 && (p.revents & POLLIN);
+}
+
+WiFiClient WiFiServer::accept() {
+  if (_fd < 0) return WiFiClient();
+  int fd = accept4(_fd, nullptr, nullptr, SOCK_NONBLOCK);
+  if (fd < 0) return WiFiClient();
+  WiFiClient c(fd);
+  if (_noDelay) c.setNoDelay(true);
+  return c;
+}
+
+// ===== WiFiUDP =====
+
+bool WiFiUDP::open(uint16_t port) {
+  _fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+  if (_fd < 0) return false;
+  int one = 1;
+  setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in me = ownAddr(port);
+  if (bind(_fd, (sockaddr*)&me, sizeof(me)) < 0) {
+    fprintf(stderr, "[SIM] UDP bind to port %u failed: %s\n", sim::hostPort(port), strerror(errno));
+    ::close(_fd);
+    _fd = -1;
+    return false;
+  }
+  return true;
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  stop();
+  return open(port) ? 1 : 0;
+}
+
+void WiFiUDP::stop() {
+  if (_fd >= 0) ::close(_fd);
+  _fd = -1;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  _txIp = ip;
+  _txPort = port;
+  _txLen = 0;
+  return 1;
+}
+
+int WiFiUDP::beginPacket(const char* host, uint16_t port) {
+  IPAddress ip;
+  return ip.fromString(host) ? beginPacket(ip, port) : 0;
+}
+
+size_t WiFiUDP::write(const uint8_t* buf, size_t n) {
+  n = min(n, sizeof(_tx) - _txLen);
+  memcpy(_tx + _txLen, buf, n);
+  _txLen += n;
+  return n;
+}
+
+int WiFiUDP::endPacket() {
+  if (_fd < 0 && !open(0)) return 0;
+  if (_txIp[3] == 255) {   // subnet broadcast: one datagram per possible host
+    IPAddress to = _txIp;
+    for (int d = 1; d < 255; d++) {
+      to[3] = d;
+      sockaddr_in a = makeAddr(to, _txPort);
+      sendto(_fd, _tx, _txLen, 0, (sockaddr*)&a, sizeof(a));
+    }
+    return 1;
+  }
+  sockaddr_in a = makeAddr(_txIp, _txPort);
+  return sendto(_fd, _tx, _txLen, 0, (sockaddr*)&a, sizeof(a)) == (ssize_t)_txLen ? 1 : 0;
+}
+
+int WiFiUDP::parsePacket() {
+  _rxLen = _rxPos = 0;
+  if (_fd < 0) return 0;
+  sockaddr_in from = {};
+  socklen_t n = sizeof(from);
+  ssize_t r = recvfrom(_fd, _rx, sizeof(_rx), MSG_DONTWAIT, (sockaddr*)&from, &n);
+  if (r <= 0) return 0;
+  if (sim::cfg.udpLoss > 0 && random(1000000) < (long)(sim::cfg.udpLoss * 1000000)) {   // lossy air
+    sim::statCount("udp_rx_dropped");
+    return 0;
+  }
+  _rxLen = r;
+  _remoteIp = fromSockaddr(from);
+  _remotePort = sim::simPort(ntohs(from.sin_port));
+  return (int)r;
+}
+
+int WiFiUDP::read(uint8_t* buf, size_t n) {
+  n = min(n, _rxLen - _rxPos);
+  memcpy(buf, _rx + _rxPos, n);
+  _rxPos += n;
+  return (int)n;
+}
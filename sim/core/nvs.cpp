@@ -0,0 +1,109 @@
+// NVS (Preferences) stand-in and the few esp_system/ROM calls the sketches use.
+#include <Preferences.h>
+#include <esp_system.h>
+#include <esp_rom_crc.h>
+#include <mutex>
+#include <errno.h>
+#include <dirent.h>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define NVS_KEY_NAME_MAX 15   // namespace and key names, as on the device
+
+bool Preferences::begin(const char* name, bool readOnly, const char*) {
+  if (!name || !*name || strlen(name) > NVS_KEY_NAME_MAX) return false;
+  std::string root;
+  if (sim::cfg.nvsDir) root = sim::cfg.nvsDir;
+  else root = std::string(sim::cfg.sdRoot ? sim::cfg.sdRoot : ".") + "/.nvs";
+  mkdir(root.c_str(), 0755);
+  _dir = root + "/" + name;
+  if (mkdir(_dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+  _open = true;
+  _readOnly = readOnly;
+  return true;
+}
+
+void Preferences::end() { _open = false; }
+
+bool Preferences::isKey(const char* key) {
+  struct stat st;
+  return _open && key && stat(keyPath(key).c_str(), &st) == 0;
+}
+
+bool Preferences::remove(const char* key) {
+  return _open && !_readOnly && key && unlink(keyPath(key).c_str()) == 0;
+}
+
+bool Preferences::clear() {
+  if (!_open || _readOnly) return false;
+  DIR* d = opendir(_dir.c_str());
+  if (!d) return false;
+  while (dirent* e = readdir(d)) {
+    if (e->d_name[0] != '.') unlink(keyPath(e->d_name).c_str());
+  }
+  closedir(d);
+  return true;
+}
+
+// written to a temp file and renamed, so a kill mid-write leaves the old value (like NVS)
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  if (!_open || _readOnly || !key || strlen(key) > NVS_KEY_NAME_MAX) return 0;
+  std::string path = keyPath(key), tmp = path + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) return 0;
+  bool ok = fwrite(value, 1, len, f) == len;
+  ok = (fclose(f) == 0) && ok;
+  if (!ok || rename(tmp.c_str(), path.c_str()) != 0) { unlink(tmp.c_str()); return 0; }
+  sim::statCount("nvs_writes");
+  return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  struct stat st;
+  return (_open && key && stat(keyPath(key).c_str(), &st) == 0) ? (size_t)st.st_size : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if (!len || len > maxLen) return 0;
+  FILE* f = fopen(keyPath(key).c_str(), "rb");
+  if (!f) return 0;
+  size_t n = fread(buf, 1, len, f);
+  fclose(f);
+  return n == len ? len : 0;
+}
+
+// ===== esp_system =====
+
+static std::mutex sShutdownLock;
+static std::vector<shutdown_handler_t> sShutdown;
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler) {
+  std::lock_guard<std::mutex> g(sShutdownLock);
+  for (auto h : sShutdown) if (h == handler) return ESP_ERR_INVALID_STATE;
+  sShutdown.push_back(handler);
+  return ESP_OK;
+}
+
+void esp_restart() { ESP.restart(); }
+
+void simRunShutdownHandlers() {
+  std::vector<shutdown_handler_t> handlers;
+  {
+    std::lock_guard<std::mutex> g(sShutdownLock);
+    handlers = sShutdown;
+  }
+  for (auto it = handlers.rbegin(); it != handlers.rend(); ++it) (*it)();
+}
+
+// ===== ROM =====
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
@@ -0,0 +1,47 @@
+// DS3231 stand-in and RTClib's DateTime arithmetic.
+#include <RTClib.h>
+#include <atomic>
+
+// days since 1970-01-01 <-> civil date (proleptic Gregorian)
+static int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  int64_t era = (y >= 0 ? y : y - 399) / 400;
+  unsigned yoe = (unsigned)(y - era * 400);
+  unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int64_t)doe - 719468;
+}
+
+DateTime::DateTime(uint32_t t) : _t(t) {
+  int64_t z = t / 86400 + 719468;
+  uint32_t secs = t % 86400;
+  int64_t era = z / 146097;
+  unsigned doe = (unsigned)(z - era * 146097);
+  unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned mp = (5 * doy + 2) / 153;
+  _d = doy - (153 * mp + 2) / 5 + 1;
+  _m = mp < 10 ? mp + 3 : mp - 9;
+  _y = (uint16_t)(yoe + era * 400 + (_m <= 2));
+  _hh = secs / 3600;
+  _mm = (secs / 60) % 60;
+  _ss = secs % 60;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+  : _y(year < 100 ? year + 2000 : year), _m(month), _d(day), _hh(hour), _mm(min), _ss(sec) {
+  _t = (uint32_t)(daysFromCivil(_y, _m, _d) * 86400 + hour * 3600L + min * 60L + sec);
+}
+
+uint8_t DateTime::dayOfTheWeek() const { return (uint8_t)((_t / 86400 + 4) % 7); }   // 1970-01-01 was a Thursday
+
+// RTC = whole seconds of the world clock plus whatever adjust() set
+static std::atomic<int64_t> sRtcOffsetS { 0 };
+
+static int64_t worldSeconds() {
+  int64_t us = sim::worldUs();
+  return us >= 0 ? us / 1000000 : (us - 999999) / 1000000;
+}
+
+DateTime RTC_DS3231::now() { return DateTime((uint32_t)(worldSeconds() + sRtcOffsetS)); }
+void RTC_DS3231::adjust(const DateTime& dt) { sRtcOffsetS = (int64_t)dt.unixtime() - worldSeconds(); }
@@ -0,0 +1,125 @@
+// FreeRTOS stand-in: tasks are detached threads, semaphores are mutex + condition variable.
+#include <Arduino.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <condition_variable>
+#include <thread>
+
+struct SimTask {
+  std::mutex m;
+  std::condition_variable cv;
+  uint32_t notify = 0;
+  const char* name = "";
+};
+
+struct SimSem {
+  std::mutex m;
+  std::condition_variable cv;
+  UBaseType_t count, max;
+  bool recursive = false;
+  std::thread::id owner;
+  unsigned depth = 0;
+};
+
+static thread_local SimTask* tCurrent = nullptr;
+
+static SimTask* currentTask() {
+  if (!tCurrent) tCurrent = new SimTask;   // loopTask and timer "ISRs" get one lazily
+  return tCurrent;
+}
+
+// Wait on cv until pred() or the tick timeout; ticks are milliseconds of local time
+template <class Pred>
+static bool waitTicks(std::unique_lock<std::mutex>& lk, std::condition_variable& cv, TickType_t ticks, Pred pred) {
+  if (ticks == portMAX_DELAY) { cv.wait(lk, pred); return true; }
+  double scale = 1.0 / (1.0 + sim::cfg.driftPpm * 1e-6);
+  return cv.wait_for(lk, std::chrono::microseconds((int64_t)(ticks * 1000.0 * scale)), pred);
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  SimTask* t = new SimTask;
+  t->name = name;
+  if (handle) *handle = t;
+  std::thread([fn, arg, t]() { tCurrent = t; fn(arg); }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(void (*fn)(void*), const char* name, uint32_t stack, void* arg,
+                       UBaseType_t prio, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t t) {
+  // Only self-deletion can be honoured with threads: park the calling task for good
+  if (t == nullptr || t == tCurrent) for (;;) std::this_thread::sleep_for(std::chrono::hours(24));
+}
+
+void vTaskDelay(TickType_t ticks) { sim::sleepUs((int64_t)ticks * 1000); }
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return currentTask(); }
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }   // not measurable on the host
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  SimTask* t = currentTask();
+  std::unique_lock<std::mutex> lk(t->m);
+  if (!waitTicks(lk, t->cv, ticks, [t] { return t->notify > 0; })) return 0;
+  uint32_t v = t->notify;
+  t->notify = clearOnExit ? 0 : v - 1;
+  return v;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t t) {
+  if (!t) return pdFAIL;
+  { std::lock_guard<std::mutex> g(t->m); t->notify++; }
+  t->cv.notify_one();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t* woken) {
+  xTaskNotifyGive(t);
+  if (woken) *woken = pdTRUE;
+}
+
+static SemaphoreHandle_t newSem(UBaseType_t max, UBaseType_t initial, bool recursive) {
+  SimSem* s = new SimSem;
+  s->max = max;
+  s->count = initial;
+  s->recursive = recursive;
+  return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()          { return newSem(1, 1, false); }
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return newSem(1, 1, true); }
+SemaphoreHandle_t xSemaphoreCreateBinary()         { return newSem(1, 0, false); }
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initial) { return newSem(maxCount, initial, false); }
+void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  std::unique_lock<std::mutex> lk(s->m);
+  if (s->recursive && s->depth && s->owner == std::this_thread::get_id()) { s->depth++; return pdTRUE; }
+  if (!waitTicks(lk, s->cv, ticks, [s] { return s->count > 0; })) return pdFALSE;
+  s->count--;
+  if (s->recursive) { s->owner = std::this_thread::get_id(); s->depth = 1; }
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  {
+    std::lock_guard<std::mutex> g(s->m);
+    if (s->recursive && s->depth > 1) { s->depth--; return pdTRUE; }
+    if (s->count >= s->max) return pdFALSE;
+    s->count++;
+    s->depth = 0;
+  }
+  s->cv.notify_one();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t* woken) {
+  if (woken) *woken = pdTRUE;
+  return xSemaphoreGive(s);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) { return xSemaphoreTake(s, ticks); }
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) { return xSemaphoreGive(s); }
@@ -0,0 +1,200 @@
+// Simulation statistics: heap accounting, counters, percentile series, link frame
+// latency, GPIO edges (+ optional trace) and DAC output (+ optional PCM dump).
+#include <Arduino.h>
+#include "../../server_module/NetProto.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <new>
+#include <mutex>
+#include <vector>
+#include <malloc.h>
+#include <sys/resource.h>
+
+// ===== Heap =====
+// malloc/calloc/realloc/free are wrapped at link time (-Wl,--wrap=...), operator new and
+// delete are routed through them, so every allocation of the sketch is counted.
+
+static std::atomic<int64_t> sHeapInUse { 0 };
+static std::atomic<int64_t> sHeapPeak { 0 };
+static thread_local bool tUncounted = false;   // set while the statistics allocate for themselves
+
+struct Uncounted {
+  bool prev;
+  Uncounted() : prev(tUncounted) { tUncounted = true; }
+  ~Uncounted() { tUncounted = prev; }
+};
+
+static void heapAdd(void* p) {
+  if (!p || tUncounted) return;
+  int64_t now = sHeapInUse += (int64_t)malloc_usable_size(p);
+  int64_t peak = sHeapPeak.load();
+  while (now > peak && !sHeapPeak.compare_exchange_weak(peak, now)) {}
+}
+static void heapSub(void* p) { if (p && !tUncounted) sHeapInUse -= (int64_t)malloc_usable_size(p); }
+
+extern "C" {
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t n);
+void  __real_free(void* p);
+
+void* __wrap_malloc(size_t n) { void* p = __real_malloc(n); heapAdd(p); return p; }
+void* __wrap_calloc(size_t n, size_t size) { void* p = __real_calloc(n, size); heapAdd(p); return p; }
+void  __wrap_free(void* p) { heapSub(p); __real_free(p); }
+void* __wrap_realloc(void* p, size_t n) {
+  int64_t old = p ? (int64_t)malloc_usable_size(p) : 0;
+  void* q = __real_realloc(p, n);
+  if ((q || n == 0) && !tUncounted) sHeapInUse -= old;
+  heapAdd(q);
+  return q;
+}
+}
+
+void* operator new(size_t n) { void* p = malloc(n ? n : 1); if (!p) throw std::bad_alloc(); return p; }
+void* operator new[](size_t n) { return operator new(n); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept { return malloc(n ? n : 1); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return malloc(n ? n : 1); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace sim {
+
+int64_t heapInUse() { int64_t v = sHeapInUse; return v > 0 ? v : 0; }
+int64_t heapPeak()  { return sHeapPeak; }
+
+// ===== Counters and series =====
+
+static std::mutex sLock;
+static std::map<std::string, long> sCounters;
+static std::map<std::string, std::vector<double>> sSeries;
+static std::map<uint32_t, int64_t> sAssignSentUs;   // ASSIGN id -> send time (server side)
+
+void statCount(const char* counter, long delta) {
+  Uncounted u;
+  std::lock_guard<std::mutex> g(sLock);
+  sCounters[counter] += delta;
+}
+
+void statSample(const char* series, double value) {
+  Uncounted u;
+  std::lock_guard<std::mutex> g(sLock);
+  sSeries[series].push_back(value);
+}
+
+static const char* linkTypeName(uint8_t type) {
+  switch (type) {
+    case NET_MSG_HELLO:     return "hello";
+    case NET_MSG_ASSIGN:    return "assign";
+    case NET_MSG_ACK:       return "ack";
+    case NET_MSG_DONE:      return "done";
+    case NET_MSG_HEARTBEAT: return "heartbeat";
+    default:                return "other";
+  }
+}
+
+void statLinkFrame(bool tx, uint8_t type, uint32_t id) {
+  char key[40];
+  snprintf(key, sizeof(key), "link_%s_%s", tx ? "tx" : "rx", linkTypeName(type));
+  statCount(key);
+  Uncounted u;
+  std::lock_guard<std::mutex> g(sLock);
+  if (tx && type == NET_MSG_ASSIGN) sAssignSentUs[id] = localUs();
+  if (!tx && type == NET_MSG_ACK) {
+    auto it = sAssignSentUs.find(id);
+    if (it != sAssignSentUs.end()) {
+      sSeries["link_ack_ms"].push_back((localUs() - it->second) / 1000.0);
+      sAssignSentUs.erase(it);
+    }
+  }
+}
+
+// ===== GPIO / DAC =====
+
+static std::atomic<long> sRising[64];
+static FILE* sTrace = nullptr;
+static FILE* sDac = nullptr;
+static std::mutex sIoLock;
+
+void statGpio(int pin, int level) {
+  if (level && pin >= 0 && pin < 64) sRising[pin]++;
+  if (!cfg.tracePath) return;
+  std::lock_guard<std::mutex> g(sIoLock);
+  Uncounted u;
+  if (!sTrace && (sTrace = fopen(cfg.tracePath, "w"))) fputs("t_us,pin,level\n", sTrace);
+  if (sTrace) fprintf(sTrace, "%lld,%d,%d\n", (long long)localUs(), pin, level);
+}
+
+struct DacStat { std::atomic<long> n { 0 }; std::atomic<int> lo { 255 }, hi { 0 }; };
+static DacStat sDacStat[2];
+
+void statDac(int channel, uint8_t value) {
+  if (channel < 0 || channel > 1) return;
+  DacStat& d = sDacStat[channel];
+  d.n++;
+  if (value < d.lo) d.lo = value;
+  if (value > d.hi) d.hi = value;
+  if (channel != cfg.dacChannel || !cfg.dacPath) return;
+  std::lock_guard<std::mutex> g(sIoLock);
+  Uncounted u;
+  if (!sDac) sDac = fopen(cfg.dacPath, "wb");
+  if (sDac) fputc(value, sDac);
+}
+
+// ===== Report =====
+
+static double pct(const std::vector<double>& v, double p) {
+  if (v.empty()) return 0;
+  size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+  return v[min(i, v.size() - 1)];
+}
+
+void writeStats(FILE* out) {
+  Uncounted u;
+  std::lock_guard<std::mutex> g(sLock);
+  {
+    std::lock_guard<std::mutex> io(sIoLock);
+    if (sTrace) fflush(sTrace);
+    if (sDac) fflush(sDac);
+  }
+  rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  fprintf(out, "{\"role\":\"%s\",\"ip\":%d,\"uptime_s\":%.3f,\"drift_ppm\":%.3f,", cfg.role, cfg.ip, localUs() / 1e6, cfg.driftPpm);
+  fprintf(out, "\"heap_now\":%lld,\"heap_peak\":%lld,\"maxrss_kb\":%ld,", (long long)heapInUse(), (long long)heapPeak(), ru.ru_maxrss);
+
+  fputs("\"counters\":{", out);
+  bool first = true;
+  for (auto& c : sCounters) { fprintf(out, "%s\"%s\":%ld", first ? "" : ",", c.first.c_str(), c.second); first = false; }
+
+  fputs("},\"series\":{", out);
+  first = true;
+  for (auto& s : sSeries) {
+    std::vector<double> v = s.second;
+    std::sort(v.begin(), v.end());
+    double sum = 0;
+    for (double x : v) sum += x;
+    fprintf(out, "%s\"%s\":{\"n\":%zu,\"mean\":%.6g,\"p50\":%.6g,\"p90\":%.6g,\"p99\":%.6g,\"max\":%.6g}",
+            first ? "" : ",", s.first.c_str(), v.size(), v.empty() ? 0 : sum / v.size(),
+            pct(v, 0.5), pct(v, 0.9), pct(v, 0.99), v.empty() ? 0 : v.back());
+    first = false;
+  }
+
+  fputs("},\"gpio_rising\":{", out);
+  first = true;
+  for (int p = 0; p < 64; p++) {
+    if (!sRising[p]) continue;
+    fprintf(out, "%s\"%d\":%ld", first ? "" : ",", p, sRising[p].load());
+    first = false;
+  }
+
+  fputs("},\"dac\":[", out);
+  for (int c = 0; c < 2; c++) {
+    fprintf(out, "%s{\"n\":%ld,\"min\":%d,\"max\":%d}", c ? "," : "", sDacStat[c].n.load(),
+            sDacStat[c].n ? sDacStat[c].lo.load() : 0, sDacStat[c].hi.load());
+  }
+  fputs("]}", out);
+}
+
+} // namespace sim
@@ -0,0 +1,319 @@
+#pragma once
+// Host stand-in for the ESP32 Arduino core: just the API surface the sketches use.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include "sim.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+
+#define F(x) (x)
+#define PROGMEM
+#define PSTR(x) (x)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define HIGH 1
+#define LOW  0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+template <class T, class L, class H>
+auto constrain(T x, L lo, H hi) -> decltype(x + lo + hi) { return x < lo ? lo : (x > hi ? hi : x); }
+inline long map(long x, long a, long b, long c, long d) { return (x - a) * (d - c) / (b - a) + c; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool isSpace(char c) { return isspace((unsigned char)c) != 0; }
+inline bool isAlpha(char c) { return isalpha((unsigned char)c) != 0; }
+
+#if !defined(__GLIBC__) || __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+// newlib has these; glibc only since 2.38
+inline size_t strlcpy(char* dst, const char* src, size_t n) {
+  size_t len = strlen(src);
+  if (n) { size_t c = len < n - 1 ? len : n - 1; memcpy(dst, src, c); dst[c] = 0; }
+  return len;
+}
+inline size_t strlcat(char* dst, const char* src, size_t n) {
+  size_t d = strnlen(dst, n);
+  return d == n ? n + strlen(src) : d + strlcpy(dst + d, src, n - d);
+}
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();   // hardware RNG: differs per run
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int  digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+void analogReadResolution(uint8_t bits);
+typedef enum { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db } adc_attenuation_t;
+void analogSetPinAttenuation(uint8_t pin, adc_attenuation_t att);
+void dacWrite(uint8_t pin, uint8_t value);
+int  digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+// ---- String (std::string based; same API subset as the ESP32 core) ----
+class String {
+public:
+  String() {}
+  String(const char* c) { if (c) s = c; }
+  String(const std::string& x) : s(x) {}
+  String(char c) : s(1, c) {}
+  String(int v, unsigned char base = 10)            { num((long long)v, base); }
+  String(unsigned v, unsigned char base = 10)       { num((unsigned long long)v, base); }
+  String(long v, unsigned char base = 10)           { num((long long)v, base); }
+  String(unsigned long v, unsigned char base = 10)  { num((unsigned long long)v, base); }
+  String(long long v, unsigned char base = 10)      { num(v, base); }
+  String(unsigned long long v, unsigned char base = 10) { num(v, base); }
+  String(double v, unsigned int decimals = 2) { char b[64]; snprintf(b, sizeof(b), "%.*f", decimals, v); s = b; }
+  String(float v, unsigned int decimals = 2) : String((double)v, decimals) {}
+
+  unsigned int length() const { return s.size(); }
+  bool isEmpty() const { return s.empty(); }
+  const char* c_str() const { return s.c_str(); }
+  bool reserve(unsigned int n) { s.reserve(n); return true; }
+  char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  void setCharAt(unsigned int i, char c) { if (i < s.size()) s[i] = c; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return s[i]; }
+
+  bool concat(const String& o) { s += o.s; return true; }
+  bool concat(const char* p) { if (p) s += p; return p != nullptr; }
+  bool concat(const char* p, unsigned int n) { if (p) s.append(p, n); return p != nullptr; }
+  bool concat(char c) { s += c; return true; }
+  template <class T> bool concat(T v) { s += String(v).s; return true; }
+  template <class T> String& operator+=(const T& v) { concat(v); return *this; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+  friend String operator+(const String& a, const char* b)   { return String(a.s + (b ? b : "")); }
+  friend String operator+(const char* a, const String& b)   { return String(std::string(a ? a : "") + b.s); }
+  friend String operator+(const String& a, char b)          { return String(a.s + b); }
+  template <class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend String operator+(const String& a, T v) { return a + String(v); }
+
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator==(const char* o) const { return s == (o ? o : ""); }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator!=(const char* o) const { return !(*this == o); }
+  bool operator<(const String& o) const { return s < o.s; }
+  bool equals(const String& o) const { return s == o.s; }
+  bool equalsIgnoreCase(const String& o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+  int  compareTo(const String& o) const { return s.compare(o.s); }
+  bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+  bool endsWith(const String& p) const { return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0; }
+
+  int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+  int indexOf(const String& t, unsigned int from = 0) const { return pos(s.find(t.s, from)); }
+  int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+  int lastIndexOf(const String& t) const { return pos(s.rfind(t.s)); }
+  String substring(unsigned int a) const { return a >= s.size() ? String() : String(s.substr(a)); }
+  String substring(unsigned int a, unsigned int b) const {
+    if (a > b) std::swap(a, b);
+    if (a >= s.size()) return String();
+    return String(s.substr(a, b - a));
+  }
+
+  long   toInt() const { return atol(s.c_str()); }
+  float  toFloat() const { return (float)atof(s.c_str()); }
+  double toDouble() const { return atof(s.c_str()); }
+  void trim() {
+    size_t a = 0, b = s.size();
+    while (a < b && isspace((unsigned char)s[a])) a++;
+    while (b > a && isspace((unsigned char)s[b-1])) b--;
+    s = s.substr(a, b - a);
+  }
+  void toUpperCase() { for (auto& c : s) c = toupper((unsigned char)c); }
+  void toLowerCase() { for (auto& c : s) c = tolower((unsigned char)c); }
+  void replace(char a, char b) { for (auto& c : s) if (c == a) c = b; }
+  void replace(const String& a, const String& b) {
+    if (a.s.empty()) return;
+    for (size_t p = 0; (p = s.find(a.s, p)) != std::string::npos; p += b.s.size()) s.replace(p, a.s.size(), b.s);
+  }
+  void remove(unsigned int i) { if (i < s.size()) s.erase(i); }
+  void remove(unsigned int i, unsigned int n) { if (i < s.size()) s.erase(i, n); }
+  void toCharArray(char* buf, unsigned int n) const { if (n) { strncpy(buf, s.c_str(), n - 1); buf[n-1] = 0; } }
+
+private:
+  std::string s;
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void num(long long v, unsigned char base) {
+    if (v < 0 && base == 10) { num((unsigned long long)(-(v + 1)) + 1, base); s.insert(0, 1, '-'); }
+    else num((unsigned long long)v, base);
+  }
+  void num(unsigned long long v, unsigned char base) {
+    char b[72]; int i = sizeof(b) - 1; b[i] = 0;
+    if (base < 2) base = 10;
+    do { int d = v % base; b[--i] = d < 10 ? '0' + d : 'A' + d - 10; v /= base; } while (v);
+    s = &b[i];
+  }
+};
+
+// ---- Print / Stream ----
+class Print;
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) { size_t k = 0; while (n--) k += write(*buf++); return k; }
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+  size_t write(const char* buf, size_t n) { return write((const uint8_t*)buf, n); }
+  virtual void flush() {}
+  virtual int availableForWrite() { return 0; }
+
+  size_t print(const char* s)   { return write(s); }
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(char c)          { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC)      { return printNum((unsigned long long)v, base); }
+  size_t print(int v, int base = DEC)                { return printNum((long long)v, base); }
+  size_t print(unsigned int v, int base = DEC)       { return printNum((unsigned long long)v, base); }
+  size_t print(long v, int base = DEC)               { return printNum((long long)v, base); }
+  size_t print(unsigned long v, int base = DEC)      { return printNum((unsigned long long)v, base); }
+  size_t print(long long v, int base = DEC)          { return printNum(v, base); }
+  size_t print(unsigned long long v, int base = DEC) { return printNum(v, base); }
+  size_t print(double v, int digits = 2) { char b[64]; int n = snprintf(b, sizeof(b), "%.*f", digits, v); return write((const uint8_t*)b, n); }
+  size_t print(const Printable& p) { return p.printTo(*this); }
+
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+  size_t printNum(long long v, int base) { return print(String(v, (unsigned char)base)); }
+  size_t printNum(unsigned long long v, int base) { return print(String(v, (unsigned char)base)); }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { _timeout = ms; }
+  unsigned long getTimeout() const { return _timeout; }
+  size_t readBytes(char* buf, size_t n);
+  size_t readBytes(uint8_t* buf, size_t n) { return readBytes((char*)buf, n); }
+  size_t readBytesUntil(char term, char* buf, size_t n);
+  String readString();
+  String readStringUntil(char term);
+  bool   find(const char* target);
+  long   parseInt();
+  float  parseFloat();
+
+protected:
+  unsigned long _timeout = 1000;
+  int timedRead();
+  int timedPeek();
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud, uint32_t config = 0, int8_t rx = -1, int8_t tx = -1);
+  void end() {}
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  void flush() override;
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ---- IPAddress ----
+class IPAddress : public Printable {
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { _b[0] = a; _b[1] = b; _b[2] = c; _b[3] = d; }
+  IPAddress(uint32_t v) { memcpy(_b, &v, 4); }
+  bool fromString(const char* s) {
+    unsigned a, b, c, d; char tail;
+    if (!s || sscanf(s, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+    _b[0] = a; _b[1] = b; _b[2] = c; _b[3] = d;
+    return true;
+  }
+  bool fromString(const String& s) { return fromString(s.c_str()); }
+  String toString() const { char t[16]; snprintf(t, sizeof(t), "%u.%u.%u.%u", _b[0], _b[1], _b[2], _b[3]); return String(t); }
+  uint8_t operator[](int i) const { return _b[i]; }
+  uint8_t& operator[](int i) { return _b[i]; }
+  operator uint32_t() const { uint32_t v; memcpy(&v, _b, 4); return v; }
+  bool operator==(const IPAddress& o) const { return memcmp(_b, o._b, 4) == 0; }
+  bool operator!=(const IPAddress& o) const { return !(*this == o); }
+  size_t printTo(Print& p) const override { return p.print(toString()); }
+  const uint8_t* raw() const { return _b; }
+private:
+  uint8_t _b[4] = {0, 0, 0, 0};
+};
+
+// ---- ESP ----
+class EspClass {
+public:
+  uint32_t getHeapSize();
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint64_t getEfuseMac();
+  void restart();
+};
+extern EspClass ESP;
+
+// ---- hardware timers (esp32-hal-timer, core 3.x) ----
+struct hw_timer_s;
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t* timerBegin(uint32_t frequency);
+void timerEnd(hw_timer_t* t);
+void timerAttachInterrupt(hw_timer_t* t, void (*isr)());
+void timerDetachInterrupt(hw_timer_t* t);
+void timerAlarm(hw_timer_t* t, uint64_t alarmValue, bool autoreload, uint64_t reloadCount);
+void timerStart(hw_timer_t* t);
+void timerStop(hw_timer_t* t);
+
+void setup();
+void loop();
@@ -0,0 +1,26 @@
+#pragma once
+// NVS stand-in: one file per key under <sd dir>/.nvs/<namespace>/ (or --nvs DIR).
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool   begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+  void   end();
+  bool   clear();
+  bool   remove(const char* key);
+  bool   isKey(const char* key);
+  size_t putBytes(const char* key, const void* value, size_t len);
+  size_t getBytes(const char* key, void* buf, size_t maxLen);
+  size_t getBytesLength(const char* key);
+  size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  uint32_t getUInt(const char* key, uint32_t def = 0) { uint32_t v; return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : def; }
+  size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+  int32_t getInt(const char* key, int32_t def = 0) { int32_t v; return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : def; }
+  size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+  float  getFloat(const char* key, float def = 0) { float v; return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : def; }
+
+private:
+  std::string _dir;
+  bool _open = false, _readOnly = false;
+  std::string keyPath(const char* key) const { return _dir + "/" + key; }
+};
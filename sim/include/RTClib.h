@@ -0,0 +1,51 @@
+#pragma once
+// DS3231 stand-in: whole seconds of the simulated world clock, adjustable like the chip.
+#include "Arduino.h"
+#include "Wire.h"
+
+class TimeSpan {
+public:
+  TimeSpan(int32_t seconds = 0) : _s(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+    : _s((int32_t)days * 86400L + (int32_t)hours * 3600 + (int32_t)minutes * 60 + seconds) {}
+  int32_t totalseconds() const { return _s; }
+  int16_t days() const { return _s / 86400L; }
+private:
+  int32_t _s;
+};
+
+class DateTime {
+public:
+  DateTime(uint32_t t = 946684800UL);   // 2000-01-01, like RTClib
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+  uint16_t year() const   { return _y; }
+  uint8_t  month() const  { return _m; }
+  uint8_t  day() const    { return _d; }
+  uint8_t  hour() const   { return _hh; }
+  uint8_t  minute() const { return _mm; }
+  uint8_t  second() const { return _ss; }
+  uint8_t  dayOfTheWeek() const;
+  uint32_t unixtime() const { return _t; }
+  bool isValid() const { return _y >= 2000 && _m >= 1 && _m <= 12 && _d >= 1 && _d <= 31 && _hh < 24 && _mm < 60 && _ss < 60; }
+  DateTime operator+(const TimeSpan& s) const { return DateTime(_t + s.totalseconds()); }
+  DateTime operator-(const TimeSpan& s) const { return DateTime(_t - s.totalseconds()); }
+  TimeSpan operator-(const DateTime& o) const { return TimeSpan((int32_t)(_t - o._t)); }
+  bool operator<(const DateTime& o) const  { return _t < o._t; }
+  bool operator==(const DateTime& o) const { return _t == o._t; }
+private:
+  uint32_t _t;
+  uint16_t _y;
+  uint8_t  _m, _d, _hh, _mm, _ss;
+};
+
+enum Ds3231SqwPinMode { DS3231_OFF = 0x1C, DS3231_SquareWave1Hz = 0x00 };
+
+class RTC_DS3231 {
+public:
+  bool begin(TwoWire* wire = &Wire) { return true; }
+  DateTime now();
+  void adjust(const DateTime& dt);
+  bool lostPower() { return false; }
+  void writeSqwPinMode(Ds3231SqwPinMode mode) {}
+  float getTemperature() { return 25.0f; }
+};
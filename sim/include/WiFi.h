@@ -0,0 +1,32 @@
+#pragma once
+// Station/AP stand-in: always "connected" on the simulated 192.168.4.0/24 network,
+// this module's address is 192.168.4.<sim::cfg.ip>.
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_DISCONNECTED = 6 } wl_status_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t m) { _mode = m; return true; }
+  bool mode(int m) { return mode((wifi_mode_t)m); }
+  bool softAP(const char* ssid, const char* pass = nullptr, int channel = 1, int hidden = 0, int maxConn = 4) { return true; }
+  IPAddress softAPIP();
+  wl_status_t begin(const char* ssid, const char* pass = nullptr) { return WL_CONNECTED; }
+  wl_status_t status() { return WL_CONNECTED; }
+  bool disconnect(bool wifiOff = false) { return true; }
+  bool reconnect() { return true; }
+  IPAddress localIP();
+  IPAddress gatewayIP();
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  IPAddress dnsIP() { return gatewayIP(); }
+  int8_t RSSI() { return -50; }
+  uint8_t* macAddress(uint8_t* mac);
+  String macAddress();
+  bool setSleep(bool enable) { return true; }
+private:
+  wifi_mode_t _mode = WIFI_OFF;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,36 @@
+#pragma once
+// TCP client on a loopback socket bound to this module's simulated address.
+#include "Arduino.h"
+#include <memory>
+
+struct SimSocket;
+
+class WiFiClient : public Stream {
+public:
+  WiFiClient() {}
+  explicit WiFiClient(int fd);
+
+  int connect(IPAddress ip, uint16_t port);
+  int connect(IPAddress ip, uint16_t port, int32_t timeoutMs);
+  int connect(const char* host, uint16_t port);
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int  available() override;
+  int  read() override;
+  int  read(uint8_t* buf, size_t n);
+  int  read(char* buf, size_t n) { return read((uint8_t*)buf, n); }
+  int  peek() override;
+  void flush() override {}
+  void stop();
+  uint8_t connected();
+  operator bool() { return connected(); }
+  IPAddress remoteIP() const;
+  uint16_t  remotePort() const;
+  IPAddress localIP() const;
+  int  setNoDelay(bool nodelay);
+  int  fd() const;
+
+private:
+  std::shared_ptr<SimSocket> _s;
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include "WiFiClient.h"
+
+class WiFiServer {
+public:
+  WiFiServer(uint16_t port = 80, uint8_t maxClients = 4) : _port(port), _max(maxClients) {}
+  void begin(uint16_t port = 0);
+  void end();
+  bool hasClient();
+  WiFiClient accept();
+  WiFiClient available() { return accept(); }
+  void setNoDelay(bool nodelay) { _noDelay = nodelay; }
+  operator bool() const { return _fd >= 0; }
+
+private:
+  uint16_t _port;
+  uint8_t  _max;
+  int      _fd = -1;
+  bool     _noDelay = false;
+};
@@ -0,0 +1,38 @@
+#pragma once
+// UDP on a loopback socket bound to this module's simulated address.
+// Packets to x.x.x.255 are fanned out to every address of the simulated subnet.
+#include "Arduino.h"
+
+class WiFiUDP : public Stream {
+public:
+  ~WiFiUDP() { stop(); }
+  uint8_t begin(uint16_t port);
+  void stop();
+  int  beginPacket(IPAddress ip, uint16_t port);
+  int  beginPacket(const char* host, uint16_t port);
+  int  endPacket();
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int  parsePacket();
+  int  available() override { return (int)(_rxLen - _rxPos); }
+  int  read() override { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+  int  read(uint8_t* buf, size_t n);
+  int  read(char* buf, size_t n) { return read((uint8_t*)buf, n); }
+  int  peek() override { return _rxPos < _rxLen ? _rx[_rxPos] : -1; }
+  void flush() override { _rxPos = _rxLen; }
+  IPAddress remoteIP() const { return _remoteIp; }
+  uint16_t  remotePort() const { return _remotePort; }
+
+private:
+  int       _fd = -1;
+  uint8_t   _tx[1472];
+  size_t    _txLen = 0;
+  IPAddress _txIp;
+  uint16_t  _txPort = 0;
+  uint8_t   _rx[1472];
+  size_t    _rxLen = 0, _rxPos = 0;
+  IPAddress _remoteIp;
+  uint16_t  _remotePort = 0;
+  bool open(uint16_t port);
+};
@@ -0,0 +1,55 @@
+#pragma once
+// FreeRTOS stand-in: tasks are threads, ticks are milliseconds.
+#include <stdint.h>
+#include <mutex>
+
+struct SimTask;
+struct SimSem;
+typedef SimTask*  TaskHandle_t;
+typedef SimSem*   SemaphoreHandle_t;
+typedef uint32_t  TickType_t;
+typedef int       BaseType_t;
+typedef unsigned  UBaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY      0xffffffffu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+#define configTICK_RATE_HZ 1000
+#define tskNO_AFFINITY     0x7fffffff
+
+// Critical sections: a recursive mutex per portMUX (ISRs are threads here too)
+struct portMUX_TYPE { std::recursive_mutex m; };
+#define portMUX_INITIALIZER_UNLOCKED {}
+inline void portENTER_CRITICAL(portMUX_TYPE* mux)     { mux->m.lock(); }
+inline void portEXIT_CRITICAL(portMUX_TYPE* mux)      { mux->m.unlock(); }
+inline void portENTER_CRITICAL_ISR(portMUX_TYPE* mux) { mux->m.lock(); }
+inline void portEXIT_CRITICAL_ISR(portMUX_TYPE* mux)  { mux->m.unlock(); }
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t prio, TaskHandle_t* handle, BaseType_t core);
+BaseType_t xTaskCreate(void (*fn)(void*), const char* name, uint32_t stackDepth, void* arg,
+                       UBaseType_t prio, TaskHandle_t* handle);
+void         vTaskDelete(TaskHandle_t t);
+void         vTaskDelay(TickType_t ticks);
+TickType_t   xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t t);
+uint32_t     ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+BaseType_t   xTaskNotifyGive(TaskHandle_t t);
+void         vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t* woken);
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initial);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t* woken);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s);
+void       vSemaphoreDelete(SemaphoreHandle_t s);
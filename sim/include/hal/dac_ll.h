@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+typedef enum { DAC_CHAN_0, DAC_CHAN_1 } dac_channel_t;
+void dac_ll_update_output_value(dac_channel_t chan, uint8_t value);
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Host simulation layer (see sim/Makefile, sim/run_sim.py).
+// Everything the stand-in Arduino/ESP32 headers need from the simulator, plus the
+// hooks sim_main.cpp uses to collect statistics. Not part of the firmware.
+
+namespace sim {
+
+struct Config {
+  const char* role = "module";     // "server" / "client", for the stats
+  int         ip = 1;              // last octet on the simulated AP net (192.168.4.x -> 127.0.4.x)
+  double      driftPpm = 0;        // local oscillator error (micros/millis/esp_timer)
+  double      worldOffsetS = 0;    // simulated UTC = host UTC + offset (shared by all processes)
+  const char* sdRoot = nullptr;    // directory that stands in for the SD card
+  const char* nvsDir = nullptr;    // NVS (Preferences) directory, default <sdRoot>/.nvs
+  const char* tracePath = nullptr; // GPIO edge trace (CSV), optional
+  const char* dacPath = nullptr;   // samples of one DAC channel as raw u8 PCM, optional
+  int         dacChannel = 1;      // 0 = GPIO25, 1 = GPIO26 (the client's audio output)
+  double      durationS = 0;       // 0 = until SIGINT/SIGTERM
+  unsigned    loopSleepUs = 200;   // pause between loop() calls (keeps dozens of processes cheap)
+  double      udpLoss = 0;         // fraction of received UDP datagrams dropped (0..1)
+};
+extern Config cfg;
+
+// Clocks
+int64_t localUs();                 // this module's oscillator: micros()/millis()/esp_timer
+int64_t worldUs();                 // true simulated UTC, unix microseconds
+void    sleepUs(int64_t us);       // host sleep for `us` of local time
+
+// Network address mapping: 192.168.4.x <-> 127.0.4.x, privileged ports + SIM_PORT_OFFSET
+#define SIM_PORT_OFFSET 8000
+uint32_t hostAddr(const uint8_t ip[4]);           // network byte order
+void     simAddr(uint32_t hostAddrN, uint8_t out[4]);
+uint16_t hostPort(uint16_t port);
+uint16_t simPort(uint16_t hostPort);
+
+// Statistics
+void statLinkFrame(bool tx, uint8_t type, uint32_t id); // module link frames seen on the wire
+void statGpio(int pin, int level);
+void statDac(int channel, uint8_t value);
+void statSample(const char* series, double value);      // percentile series
+void statCount(const char* counter, long delta = 1);
+int64_t heapInUse();
+int64_t heapPeak();
+void    writeStats(FILE* out);                          // one JSON object
+
+} // namespace sim
@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+// GPIO register block: writes to the set/clear registers are routed to the GPIO trace
+struct SimGpioReg {
+  int  base;   // first pin of this register (0 or 32)
+  bool set;    // w1ts or w1tc
+  void operator=(uint32_t mask);
+};
+struct SimGpioReg1 { SimGpioReg val; };
+
+typedef struct {
+  SimGpioReg  out_w1ts { 0, true };
+  SimGpioReg  out_w1tc { 0, false };
+  SimGpioReg1 out1_w1ts { { 32, true } };
+  SimGpioReg1 out1_w1tc { { 32, false } };
+} gpio_dev_t;
+extern gpio_dev_t GPIO;
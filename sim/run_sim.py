@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+import argparse, calendar, datetime, glob, http.client, json, os, re, shutil, signal, socket, struct
+import subprocess, sys, threading, time
+
+# Command: python3 run_sim.py [--clients 24] [--duration 60]
+# Runs build/sim_server and N build/sim_client processes on loopback (192.168.4.x -> 127.0.4.x,
+# port 80 -> 8080), loads the web UI while they run, and reports assignment throughput,
+# request latency percentiles, time-sync error and memory high-water marks.
+# Output (logs, SD directories, per-process stats, report.json) goes to --out.
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+ap = argparse.ArgumentParser()
+ap.add_argument("--clients", type=int, default=24)
+ap.add_argument("--duration", type=float, default=60.0, help="seconds of load after the clients start")
+ap.add_argument("--data", default=os.path.join(here, "..", "example_satellite_data"),
+                help="directory with sat_data_*.json and location.json (copied to the server's SD)")
+ap.add_argument("--catalog", action="store_true", help="also pack the data into /sat_catalog.bin")
+ap.add_argument("--drift", type=float, default=30.0, help="client oscillator error is spread over +-DRIFT ppm")
+ap.add_argument("--http-rate", type=float, default=20.0, help="web requests per second (0 = none)")
+ap.add_argument("--loop-us", type=int, default=200, help="pause between loop() calls")
+ap.add_argument("--cmd-rate", type=float, default=1.0, help="/send commands to ALL per second (0 = none)")
+ap.add_argument("--udp-loss", type=float, default=0.0, help="fraction of UDP datagrams each module drops")
+ap.add_argument("--out", default=os.path.join(here, "out"))
+ap.add_argument("--no-build", action="store_true")
+args = ap.parse_args()
+
+SERVER_HTTP = ("127.0.4.1", 8080)
+HTTP_PATHS = ["/", "/files", "/clients"]
+
+# Same layout as setupfiles/sat_export_multifile.py (see server_module/SatCatalog.h)
+CATALOG_HEADER = struct.Struct("<4sHHIII12x")
+CATALOG_RECORD = struct.Struct("<IIdff28s70s70s")
+
+def to_unix(iso):
+    dt = datetime.datetime.fromisoformat(iso.replace("Z", ""))
+    return calendar.timegm(dt.timetuple()) + dt.microsecond / 1e6
+
+def tle_epoch_unix(line1):
+    yy = int(line1[18:20])
+    day = float(line1[20:32])
+    year = 2000 + yy if yy < 57 else 1900 + yy
+    return calendar.timegm((year, 1, 1, 0, 0, 0)) + (day - 1) * 86400
+
+def load_entries(data_dir):
+    entries = []
+    for path in sorted(glob.glob(os.path.join(data_dir, "sat_data_*.json"))):
+        with open(path) as f:
+            entries += json.load(f)
+    return entries
+
+def write_catalog(entries, filename):
+    with open(filename, "wb") as f:
+        f.write(CATALOG_HEADER.pack(b"SATC", 1, CATALOG_RECORD.size, len(entries), int(time.time()),
+                                    CATALOG_HEADER.size))
+        for e in entries:
+            l1, l2 = e["tle"]["line-1"], e["tle"]["line-2"]
+            f.write(CATALOG_RECORD.pack(int(l1[2:7]), int(to_unix(e["datetime_utc"])), tle_epoch_unix(l1),
+                                        e["distance_km"], e["elevation_deg"],
+                                        e["name"].encode("ascii", "replace")[:27],
+                                        l1.encode("ascii")[:69], l2.encode("ascii")[:69]))
+
+def percentiles(values):
+    if not values:
+        return {"n": 0}
+    v = sorted(values)
+    pick = lambda p: v[min(len(v) - 1, int(p * (len(v) - 1) + 0.5))]
+    return {"n": len(v), "mean": sum(v) / len(v), "p50": pick(0.5), "p90": pick(0.9), "p99": pick(0.99), "max": v[-1]}
+
+def wait_for_port(addr, timeout):
+    end = time.time() + timeout
+    while time.time() < end:
+        try:
+            socket.create_connection(addr, timeout=0.5).close()
+            return True
+        except OSError:
+            time.sleep(0.2)
+    return False
+
+# ---- build and prepare ----
+if not args.no_build:
+    subprocess.check_call(["make", "-C", here, "-j", str(os.cpu_count() or 1)])
+
+entries = load_entries(args.data)
+if not entries:
+    sys.exit(f"no sat_data_*.json in {args.data}")
+# Start the world clock at the export time so the TLEs are as fresh as on the day they were taken
+world_start = min(to_unix(e["datetime_utc"]) for e in entries)
+world_offset = world_start - time.time()
+
+shutil.rmtree(args.out, ignore_errors=True)
+server_sd = os.path.join(args.out, "server_sd")
+os.makedirs(server_sd)
+for name in os.listdir(args.data):
+    if name.endswith(".json"):
+        shutil.copy(os.path.join(args.data, name), server_sd)
+if args.catalog:
+    write_catalog(entries, os.path.join(server_sd, "sat_catalog.bin"))
+
+procs = []
+
+def start(binary, ip, sd, drift, name):
+    os.makedirs(sd, exist_ok=True)
+    log = open(os.path.join(args.out, name + ".log"), "w")
+    cmd = [os.path.join(here, "build", binary), "--ip", str(ip), "--sd", sd,
+           "--drift-ppm", f"{drift:.3f}", "--world-offset", f"{world_offset:.6f}",
+           "--loop-us", str(args.loop_us), "--udp-loss", str(args.udp_loss), "--stats", os.path.join(args.out, name + ".stats.json")]
+    p = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+    procs.append((name, p))
+    return p
+
+def stop_all():
+    for _, p in reversed(procs):          # clients first, the server last
+        if p.poll() is None:
+            p.send_signal(signal.SIGTERM)
+    for _, p in procs:
+        try:
+            p.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            p.kill()
+
+# ---- run ----
+try:
+    start("sim_server", 1, server_sd, 0.0, "server")
+    if not wait_for_port(SERVER_HTTP, 30):
+        stop_all()
+        sys.exit("server did not come up, see " + os.path.join(args.out, "server.log"))
+
+    for i in range(args.clients):
+        drift = -args.drift + (2 * args.drift * i / max(1, args.clients - 1)) if args.clients > 1 else 0.0
+        start("sim_client", 10 + i, os.path.join(args.out, f"client{i:02d}_sd"), drift, f"client{i:02d}")
+        time.sleep(0.05)
+
+    http_lat = {p: [] for p in HTTP_PATHS}
+    http_errors = [0]
+    stop = threading.Event()
+
+    def http_load():
+        conn = None
+        n = 0
+        period = 1.0 / args.http_rate
+        next_t = time.time()
+        while not stop.is_set():
+            path = HTTP_PATHS[n % len(HTTP_PATHS)]
+            n += 1
+            t0 = time.perf_counter()
+            try:
+                if conn is None:
+                    conn = http.client.HTTPConnection(*SERVER_HTTP, timeout=5)
+                conn.request("GET", path, headers={"Accept-Encoding": "gzip"})
+                r = conn.getresponse()
+                r.read()
+                if r.status != 200:
+                    http_errors[0] += 1
+                else:
+                    http_lat[path].append((time.perf_counter() - t0) * 1000.0)
+                if r.getheader("Connection", "").lower() == "close":
+                    conn.close()
+                    conn = None
+            except (OSError, http.client.HTTPException):
+                http_errors[0] += 1
+                if conn:
+                    conn.close()
+                conn = None
+            next_t += period
+            stop.wait(max(0.0, next_t - time.time()))
+
+    # command fan-out report: "OK delivered 3/3: 192.168.4.10 4.1ms, 192.168.4.11 9.8ms (2 tries), ..."
+    cmd_delivered, cmd_targets, cmd_ms, cmd_tries = [0], [0], [], []
+
+    def cmd_load():
+        conn = None
+        while not stop.wait(1.0 / args.cmd_rate):
+            try:
+                if conn is None:
+                    conn = http.client.HTTPConnection(*SERVER_HTTP, timeout=5)
+                conn.request("GET", "/send?targets=ALL&cmd=LASER%20TRACK%3BAUDIO%20IDLEMUTE%20ON")
+                body = conn.getresponse().read().decode(errors="replace")
+                # "OK #12 queued for 3 modules": the report comes from /send?id=12 once the acks are in
+                m = re.match(r"OK #(\d+)", body)
+                while m:
+                    time.sleep(0.1)
+                    conn.request("GET", "/send?id=" + m.group(1))
+                    body = conn.getresponse().read().decode(errors="replace")
+                    if not body.startswith("PENDING"):
+                        break
+            except (OSError, http.client.HTTPException):
+                if conn:
+                    conn.close()
+                conn = None
+                continue
+            if " delivered " not in body:
+                continue
+            head, _, per = body.partition(":")
+            got, total = head.split()[-1].split("/")
+            cmd_delivered[0] += int(got)
+            cmd_targets[0] += int(total)
+            for item in per.split(","):
+                f = item.split()
+                if len(f) >= 2 and f[1].endswith("ms"):
+                    cmd_ms.append(float(f[1][:-2]))
+                cmd_tries.append(int(f[f.index("tries)") - 1].lstrip("(")) if "tries)" in f else 1)
+
+    loader = threading.Thread(target=http_load, daemon=True)
+    if args.http_rate > 0:
+        loader.start()
+    commander = threading.Thread(target=cmd_load, daemon=True)
+    if args.cmd_rate > 0:
+        commander.start()
+    print(f"running 1 server + {args.clients} clients for {args.duration:.0f} s (output in {args.out})")
+    time.sleep(args.duration)
+    stop.set()
+    for t in (loader, commander):
+        if t.is_alive():
+            t.join(timeout=10)
+finally:
+    stop_all()
+
+# ---- report ----
+stats = {}
+for name, _ in procs:
+    try:
+        with open(os.path.join(args.out, name + ".stats.json")) as f:
+            stats[name] = json.load(f)
+    except (OSError, ValueError):
+        print(f"warning: no stats from {name} (crashed?), see {name}.log")
+
+server = stats.get("server", {})
+clients = [s for n, s in stats.items() if n != "server"]
+counters = server.get("counters", {})
+series = server.get("series", {})
+client_err = [c["series"]["timesync_abs_err_us"] for c in clients if "timesync_abs_err_us" in c.get("series", {})]
+
+report = {
+    "clients": args.clients,
+    "clients_reporting": len(clients),
+    "duration_s": args.duration,
+    "assignments": {
+        "pushed": counters.get("link_tx_assign", 0),
+        "acked": counters.get("link_rx_ack", 0),
+        "done": counters.get("link_rx_done", 0),
+        "received_by_clients": sum(c.get("counters", {}).get("link_rx_assign", 0) for c in clients),
+        "per_s": counters.get("link_tx_assign", 0) / server.get("uptime_s", 1) if server else 0,
+        "ack_latency_ms": series.get("link_ack_ms", {"n": 0}),
+    },
+    "http_ms": {p: percentiles(v) for p, v in http_lat.items()},
+    "http_ms_all": percentiles([x for v in http_lat.values() for x in v]),
+    "http_errors": http_errors[0],
+    "commands": {
+        "delivered": cmd_delivered[0],
+        "targets": cmd_targets[0],
+        "latency_ms": percentiles(cmd_ms),
+        "retransmitted": sum(1 for t in cmd_tries if t > 1),
+        "udp_rx_dropped": sum(s.get("counters", {}).get("udp_rx_dropped", 0) for s in stats.values()),
+    },
+    "timesync_abs_err_us": {
+        "clients_synced": len(client_err),
+        "median_p50": percentiles([e["p50"] for e in client_err]).get("p50", 0),
+        "worst_p99": max([e["p99"] for e in client_err], default=0),
+        "worst_max": max([e["max"] for e in client_err], default=0),
+        "server_anchor": series.get("timesync_abs_err_us", {"n": 0}),
+    },
+    "memory": {
+        "server_heap_peak": server.get("heap_peak", 0),
+        "server_maxrss_kb": server.get("maxrss_kb", 0),
+        "client_heap_peak_max": max([c.get("heap_peak", 0) for c in clients], default=0),
+        "client_maxrss_kb_max": max([c.get("maxrss_kb", 0) for c in clients], default=0),
+    },
+    "loop_max_us": {
+        "server_p99": series.get("loop_max_us", {}).get("p99", 0),
+        "client_p99_max": max([c["series"].get("loop_max_us", {}).get("p99", 0) for c in clients], default=0),
+    },
+}
+
+with open(os.path.join(args.out, "report.json"), "w") as f:
+    json.dump({"summary": report, "processes": stats}, f, indent=2)
+
+a = report["assignments"]
+h = report["http_ms_all"]
+t = report["timesync_abs_err_us"]
+m = report["memory"]
+print(f"assignments  pushed={a['pushed']} acked={a['acked']} done={a['done']} "
+      f"rx={a['received_by_clients']} ({a['per_s']:.2f}/s)")
+if a["ack_latency_ms"].get("n"):
+    l = a["ack_latency_ms"]
+    print(f"link ack     p50={l['p50']:.2f} ms  p99={l['p99']:.2f} ms  max={l['max']:.2f} ms")
+if h.get("n"):
+    print(f"http         n={h['n']} p50={h['p50']:.2f} ms  p90={h['p90']:.2f} ms  p99={h['p99']:.2f} ms  "
+          f"errors={report['http_errors']}")
+cm = report["commands"]
+if cm["targets"]:
+    l = cm["latency_ms"]
+    print(f"commands     delivered {cm['delivered']}/{cm['targets']}  p50={l.get('p50', 0):.2f} ms  "
+          f"p99={l.get('p99', 0):.2f} ms  retransmitted={cm['retransmitted']}  udp dropped={cm['udp_rx_dropped']}")
+print(f"time sync    {t['clients_synced']}/{len(clients)} synced, |err| median p50={t['median_p50']:.0f} us  "
+      f"worst p99={t['worst_p99']:.0f} us  worst max={t['worst_max']:.0f} us")
+print(f"memory       server heap peak={m['server_heap_peak']} B rss={m['server_maxrss_kb']} kB, "
+      f"client heap peak={m['client_heap_peak_max']} B rss={m['client_maxrss_kb_max']} kB")
+print("report:", os.path.join(args.out, "report.json"))
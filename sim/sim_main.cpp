@@ -0,0 +1,94 @@
+// Host entry point: parses the simulator options, then runs the sketch's setup()/loop()
+// like the Arduino core's loopTask until the duration expires or SIGINT/SIGTERM arrives.
+// On exit one "SIMSTAT {...}" line is printed (and written to --stats if given).
+#include <Arduino.h>
+#include <signal.h>
+#include <unistd.h>
+#include "TimeSync.h"
+
+char** simArgv = nullptr;   // ESP.restart() re-executes with the same arguments
+
+static volatile sig_atomic_t sStop = 0;
+static void onSignal(int) { sStop = 1; }
+
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [--ip N] [--sd DIR] [--nvs DIR] [--drift-ppm X] [--world-offset S] [--duration S]\n"
+          "          [--trace FILE] [--dac-out FILE] [--dac-pin 25|26] [--stats FILE] [--loop-us N]\n"
+          "          [--udp-loss FRACTION]\n", argv0);
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  simArgv = argv;
+  const char* statsPath = nullptr;
+#ifdef SIM_ROLE_CLIENT
+  sim::cfg.role = "client";
+  sim::cfg.ip = 10;
+#else
+  sim::cfg.role = "server";
+#endif
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (!v) usage(argv[0]);
+    if      (!strcmp(a, "--ip"))           sim::cfg.ip = atoi(v);
+    else if (!strcmp(a, "--sd"))           sim::cfg.sdRoot = v;
+    else if (!strcmp(a, "--nvs"))          sim::cfg.nvsDir = v;
+    else if (!strcmp(a, "--drift-ppm"))    sim::cfg.driftPpm = atof(v);
+    else if (!strcmp(a, "--world-offset")) sim::cfg.worldOffsetS = atof(v);
+    else if (!strcmp(a, "--duration"))     sim::cfg.durationS = atof(v);
+    else if (!strcmp(a, "--trace"))        sim::cfg.tracePath = v;
+    else if (!strcmp(a, "--dac-out"))      sim::cfg.dacPath = v;
+    else if (!strcmp(a, "--dac-pin"))      sim::cfg.dacChannel = atoi(v) == 25 ? 0 : 1;
+    else if (!strcmp(a, "--stats"))        statsPath = v;
+    else if (!strcmp(a, "--loop-us"))      sim::cfg.loopSleepUs = (unsigned)atoi(v);
+    else if (!strcmp(a, "--udp-loss"))     sim::cfg.udpLoss = atof(v);
+    else usage(argv[0]);
+    i++;
+  }
+  if (sim::cfg.ip < 1 || sim::cfg.ip > 254) usage(argv[0]);
+
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  setup();
+
+  const int64_t endUs = sim::cfg.durationS > 0 ? sim::localUs() + (int64_t)(sim::cfg.durationS * 1e6) : INT64_MAX;
+  int64_t nextSampleUs = sim::localUs() + 1000000;
+  int64_t loopMaxUs = 0;
+  while (!sStop && sim::localUs() < endUs) {
+    int64_t t0 = sim::localUs();
+    loop();
+    int64_t t1 = sim::localUs();
+    if (t1 - t0 > loopMaxUs) loopMaxUs = t1 - t0;
+
+    if (t1 >= nextSampleUs) {
+      nextSampleUs += 1000000;
+      // time-sync error against the true world clock, once per second
+#ifdef SIM_ROLE_CLIENT
+      if (timeSyncIsSynced())
+#endif
+      {
+        double err = (double)(timeSyncNowUs() - sim::worldUs());
+        sim::statSample("timesync_err_us", err);
+        sim::statSample("timesync_abs_err_us", fabs(err));
+      }
+      sim::statSample("loop_max_us", (double)loopMaxUs);
+      loopMaxUs = 0;
+    }
+    if (sim::cfg.loopSleepUs) sim::sleepUs(sim::cfg.loopSleepUs);
+  }
+
+  fputs("SIMSTAT ", stdout);
+  sim::writeStats(stdout);
+  fputc('\n', stdout);
+  fflush(stdout);
+  if (statsPath) {
+    if (FILE* f = fopen(statsPath, "w")) { sim::writeStats(f); fputc('\n', f); fclose(f); }
+  }
+  _exit(0);   // sketch tasks are still running; don't unwind their statics underneath them
+}
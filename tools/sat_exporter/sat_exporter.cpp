@@ -0,0 +1,487 @@
+// Headless satellite exporter: reads a TLE file and location.json, searches a time window
+// for real passes (batch SGP4, one worker thread per slice of the catalog) and writes the
+// sat_data_N.json files and optionally the binary catalog the server reads from its SD.
+//
+//   sat_exporter --tle starlink_tle.txt --location location.json --hours 3 --out sd/ --catalog
+//
+// One JSON entry / catalog record per satellite that passes, describing its highest pass:
+// datetime_utc = TCA, elevation_deg = max elevation, distance_km = range at TCA.
+
+#include "Sgp4Batch.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ===== Binary catalog (server_module/SatCatalog.h, keep both in sync) =====
+struct CatalogHeader {
+  char     magic[4];
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t count;
+  uint32_t createdUnix;
+  uint32_t recordsOffset;
+  uint8_t  reserved[12];
+};
+
+struct SatRecord {
+  uint32_t norad;
+  uint32_t exportUnix;
+  double   epochUnix;
+  float    distanceKm;
+  float    elevationDeg;
+  char     name[28];
+  char     line1[70];
+  char     line2[70];
+};
+
+static_assert(sizeof(CatalogHeader) == 32, "CatalogHeader must stay 32 bytes");
+static_assert(sizeof(SatRecord) == 192, "SatRecord must stay 192 bytes");
+
+// ===== Options =====
+struct Options {
+  const char* tlePath = nullptr;
+  const char* locationPath = nullptr;
+  const char* outDir = ".";
+  double startUnix = 0;       // 0 = now
+  double hours = 3.0;
+  double stepS = 20.0;        // coarse grid; passes shorter than this above min-el can be missed
+  double minElDeg = 10.0;     // same threshold as the server's scheduler (PASS_MIN_EL_DEG)
+  int perFile = 60;           // 0 = everything in sat_data_1.json
+  int threads = 0;            // 0 = one per hardware thread
+  bool catalog = false;
+  bool list = false;
+};
+
+struct Satellite {
+  std::string name, line1, line2;
+  uint32_t norad;
+  double   epoch;     // TLE epoch as year * 1000 + day of year (orders epochs, nothing more)
+};
+
+struct Pass {
+  int    sat;                 // index into the loaded satellites
+  double aosUnix, tcaUnix, losUnix;
+  float  maxElDeg, aosAzDeg, tcaRangeKm;
+  bool   upAtStart, upAtEnd;  // AOS/LOS clipped to the window
+};
+
+static void usage() {
+  fprintf(stderr,
+    "usage: sat_exporter --tle FILE --location location.json [options]\n"
+    "  --start ISO|UNIX|now   window start, UTC (default now)\n"
+    "  --hours H              window length (default 3)\n"
+    "  --step S               coarse search step in seconds (default 20)\n"
+    "  --min-el DEG           pass threshold (default 10)\n"
+    "  --out DIR              where sat_data_N.json go (default .)\n"
+    "  --per-file N           satellites per JSON file, 0 = one file (default 60)\n"
+    "  --catalog              also write sat_catalog.bin\n"
+    "  --threads N            worker threads (default: all cores)\n"
+    "  --list                 print every pass sorted by AOS\n");
+}
+
+// ===== Time =====
+static long daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const long era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = (unsigned)(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (long)doe - 719468;
+}
+
+// "2025-09-01T20:00:00Z" (Z optional, fraction allowed), a unix time, or "now"
+static bool parseTime(const char* s, double& out) {
+  if (!strcmp(s, "now")) { out = (double)time(nullptr); return true; }
+  int y, M, d, h = 0, m = 0; double sec = 0;
+  if (sscanf(s, "%d-%d-%dT%d:%d:%lf", &y, &M, &d, &h, &m, &sec) >= 3) {
+    out = (double)daysFromCivil(y, M, d) * 86400.0 + h * 3600.0 + m * 60.0 + sec;
+    return true;
+  }
+  char* end;
+  out = strtod(s, &end);
+  return end != s && *end == 0;
+}
+
+// Python's datetime.isoformat() as the server's isoUnix() reads it
+static std::string isoUtc(double unixTime) {
+  time_t t = (time_t)floor(unixTime);
+  struct tm tmv;
+  gmtime_r(&t, &tmv);
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d.%06d", tmv.tm_year + 1900, tmv.tm_mon + 1,
+           tmv.tm_mday, tmv.tm_hour, tmv.tm_min, tmv.tm_sec, (int)((unixTime - floor(unixTime)) * 1e6));
+  return buf;
+}
+
+// ===== Inputs =====
+static std::string trimmed(const char* s) {
+  std::string r(s);
+  while (!r.empty() && (r.back() == '\n' || r.back() == '\r' || r.back() == ' ')) r.pop_back();
+  size_t a = r.find_first_not_of(' ');
+  return a == std::string::npos ? std::string() : r.substr(a);
+}
+
+// Celestrak 3-line blocks (name, line 1, line 2); bare 2-line sets are named after the NORAD id
+static bool readTleFile(const char* path, std::vector<Satellite>& out) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char buf[256];
+  std::string name;
+  Satellite s;
+  while (fgets(buf, sizeof(buf), f)) {
+    std::string line = trimmed(buf);
+    if (line.empty()) continue;
+    if (line.size() >= 61 && line[0] == '1' && line[1] == ' ') { s.line1 = line; continue; }
+    if (line.size() >= 63 && line[0] == '2' && line[1] == ' ' && !s.line1.empty()) {
+      s.line2 = line;
+      s.norad = (uint32_t)strtoul(s.line1.substr(2, 5).c_str(), nullptr, 10);
+      int yy = atoi(s.line1.substr(18, 2).c_str());
+      s.epoch = (yy < 57 ? 2000 + yy : 1900 + yy) * 1000.0 + atof(s.line1.substr(20, 12).c_str());
+      s.name = name.empty() ? "NORAD " + std::to_string(s.norad) : name;
+      out.push_back(s);
+      s.line1.clear(); name.clear();
+      continue;
+    }
+    name = line;
+  }
+  fclose(f);
+  return true;
+}
+
+// One set per NORAD id, the newest epoch winning (the later one on a tie), as the server's
+// satIndexFinish() does; the kept sets stay in file order. Returns how many were dropped.
+static size_t dropDuplicates(std::vector<Satellite>& sats) {
+  std::vector<size_t> order(sats.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (sats[a].norad != sats[b].norad) return sats[a].norad < sats[b].norad;
+    if (sats[a].epoch != sats[b].epoch) return sats[a].epoch > sats[b].epoch;
+    return a > b;
+  });
+  std::vector<bool> keep(sats.size(), false);
+  for (size_t i = 0; i < order.size(); i++) {
+    if (i == 0 || sats[order[i]].norad != sats[order[i-1]].norad) keep[order[i]] = true;
+  }
+  std::vector<Satellite> kept;
+  for (size_t i = 0; i < sats.size(); i++) if (keep[i]) kept.push_back(sats[i]);
+  size_t dropped = sats.size() - kept.size();
+  sats.swap(kept);
+  return dropped;
+}
+
+static bool jsonNumber(const std::string& text, const char* key, double& out) {
+  std::string k = std::string("\"") + key + "\"";
+  size_t p = text.find(k);
+  if (p == std::string::npos) return false;
+  p = text.find(':', p + k.size());
+  if (p == std::string::npos) return false;
+  char* end;
+  out = strtod(text.c_str() + p + 1, &end);
+  return end != text.c_str() + p + 1;
+}
+
+// Same keys the server reads from /location.json
+static bool readLocation(const char* path, double& lat, double& lon, double& altM) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  std::string text;
+  char buf[512];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+  fclose(f);
+  altM = 0;
+  jsonNumber(text, "altitude_m", altM);
+  return jsonNumber(text, "latitude", lat) && jsonNumber(text, "longitude", lon);
+}
+
+// ===== Pass search =====
+struct Scratch {
+  std::vector<float> az, el, range;
+  explicit Scratch(int n) : az(n), el(n), range(n) {}
+};
+
+static float elAt(const Sgp4Batch& b, const Sgp4Site& site, int i, double t, Scratch& s) {
+  sgp4BatchLook(b, site, t, i, i + 1, s.az.data(), s.el.data(), s.range.data());
+  return s.el[i];
+}
+
+// Time in (lo, hi] where elevation crosses minEl; 'rising' says which side is above
+static double refineCrossing(const Sgp4Batch& b, const Sgp4Site& site, int i, double lo, double hi,
+                             bool rising, float minEl, Scratch& s) {
+  for (int k = 0; k < 12; k++) {
+    double mid = 0.5 * (lo + hi);
+    bool above = elAt(b, site, i, mid, s) >= minEl;
+    if (above == rising) hi = mid; else lo = mid;
+  }
+  return hi;
+}
+
+// Maximum elevation within [lo, hi] (golden section; single peak per pass)
+static double refineMax(const Sgp4Batch& b, const Sgp4Site& site, int i, double lo, double hi, Scratch& s) {
+  const double g = 0.6180339887498949;
+  double x1 = hi - g * (hi - lo), x2 = lo + g * (hi - lo);
+  float f1 = elAt(b, site, i, x1, s), f2 = elAt(b, site, i, x2, s);
+  for (int k = 0; k < 24; k++) {
+    if (f1 < f2) { lo = x1; x1 = x2; f1 = f2; x2 = lo + g * (hi - lo); f2 = elAt(b, site, i, x2, s); }
+    else         { hi = x2; x2 = x1; f2 = f1; x1 = hi - g * (hi - lo); f1 = elAt(b, site, i, x1, s); }
+  }
+  return 0.5 * (lo + hi);
+}
+
+// Sweeps satellites [from, to) over the whole window; each worker owns one slice, so the
+// grid evaluation is a straight batch call per step and no state is shared
+static void searchSlice(const Sgp4Batch& b, const Sgp4Site& site, const Options& o, int from, int to,
+                        std::vector<Pass>& out) {
+  Scratch grid(b.count), fine(b.count);
+  const float minEl = (float)o.minElDeg;
+  const double t0 = o.startUnix, t1 = o.startUnix + o.hours * 3600.0;
+  const int n = to - from;
+  std::vector<Pass> open(n);
+  std::vector<char> up(n, 0);
+  std::vector<double> bestT(n, 0);
+  auto close = [&](int k, double losUnix, bool upAtEnd) {
+    Pass& p = open[k];
+    int i = from + k;
+    p.upAtEnd = upAtEnd;
+    p.losUnix = losUnix;
+    double lo = std::max(p.aosUnix, bestT[k] - o.stepS), hi = std::min(p.losUnix, bestT[k] + o.stepS);
+    p.tcaUnix = refineMax(b, site, i, lo, hi, fine);
+    p.maxElDeg = std::max(p.maxElDeg, elAt(b, site, i, p.tcaUnix, fine));
+    p.tcaRangeKm = fine.range[i];
+    out.push_back(p);
+    up[k] = 0;
+  };
+
+  for (double t = t0, prevT = t0; ; prevT = t, t = std::min(t + o.stepS, t1)) {
+    sgp4BatchLook(b, site, t, from, to, grid.az.data(), grid.el.data(), grid.range.data());
+    for (int k = 0; k < n; k++) {
+      int i = from + k;
+      float el = grid.el[i];
+      if (!up[k] && el >= minEl) {
+        Pass& p = open[k];
+        p.sat = i;
+        p.upAtStart = (t == t0);
+        p.aosUnix = p.upAtStart ? t0 : refineCrossing(b, site, i, prevT, t, true, minEl, fine);
+        elAt(b, site, i, p.aosUnix, fine);
+        p.aosAzDeg = fine.az[i];
+        p.maxElDeg = el; bestT[k] = t;
+        up[k] = 1;
+      } else if (up[k]) {
+        Pass& p = open[k];
+        if (el > p.maxElDeg) { p.maxElDeg = el; bestT[k] = t; }
+        if (el < minEl) close(k, refineCrossing(b, site, i, prevT, t, false, minEl, fine), false);
+      }
+    }
+    if (t >= t1) break;
+  }
+  for (int k = 0; k < n; k++)   // still up at t1, including passes that rose on the last step
+    if (up[k]) close(k, t1, true);
+}
+
+// Geodetic sub-satellite point (WGS-84) at unixTime; x/y/z are batch-sized scratch
+static void subPoint(const Sgp4Batch& b, int i, double unixTime, std::vector<sgp4_real>& x,
+                     std::vector<sgp4_real>& y, std::vector<sgp4_real>& z, double& latDeg, double& lonDeg) {
+  sgp4BatchPropagate(b, unixTime, i, i + 1, x.data(), y.data(), z.data(), nullptr, nullptr, nullptr);
+  double g = sgp4GmstRad(unixTime);
+  double xe = cos(g) * x[i] + sin(g) * y[i], ye = -sin(g) * x[i] + cos(g) * y[i], ze = z[i];
+  const double A = 6378.137, E2 = 0.00669437999014;
+  double p = sqrt(xe * xe + ye * ye), lat = atan2(ze, p);
+  for (int k = 0; k < 5; k++) {
+    double sl = sin(lat), nr = A / sqrt(1.0 - E2 * sl * sl);
+    double h = p / cos(lat) - nr;
+    lat = atan2(ze, p * (1.0 - E2 * nr / (nr + h)));
+  }
+  latDeg = lat * 180.0 / M_PI;
+  lonDeg = atan2(ye, xe) * 180.0 / M_PI;
+}
+
+// ===== Output =====
+static std::string jsonEscaped(const std::string& s) {
+  std::string r;
+  for (char c : s) {
+    if (c == '"' || c == '\\') r += '\\';
+    if ((unsigned char)c >= 0x20) r += c;
+  }
+  return r;
+}
+
+struct Export {
+  int sat;                    // index into the loaded satellites
+  const Pass* best;           // highest pass in the window
+  int passes;
+};
+
+static bool writeJsonFiles(const Options& o, const Sgp4Batch& b, const std::vector<Satellite>& sats,
+                           const std::vector<Export>& ex, int& files) {
+  int per = o.perFile > 0 ? o.perFile : std::max<int>(1, (int)ex.size());
+  std::vector<sgp4_real> x(b.count), y(b.count), z(b.count);
+  files = 0;
+  for (size_t start = 0; start < ex.size() || files == 0; start += per) {
+    std::string path = std::string(o.outDir) + "/sat_data_" + std::to_string(files + 1) + ".json";
+    FILE* f = fopen(path.c_str(), "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path.c_str()); return false; }
+    fputs("[", f);
+    size_t end = std::min(ex.size(), start + per);
+    for (size_t k = start; k < end; k++) {
+      const Satellite& s = sats[ex[k].sat];
+      const Pass& p = *ex[k].best;
+      double lat, lon;
+      subPoint(b, p.sat, p.tcaUnix, x, y, z, lat, lon);
+      fprintf(f, "%s\n    {\n", k == start ? "" : ",");
+      fprintf(f, "        \"id\": %d,\n", ex[k].sat + 1);
+      fprintf(f, "        \"name\": \"%s\",\n", jsonEscaped(s.name).c_str());
+      fprintf(f, "        \"distance_km\": %.2f,\n", p.tcaRangeKm);
+      fprintf(f, "        \"elevation_deg\": %.2f,\n", p.maxElDeg);
+      fprintf(f, "        \"visible\": true,\n");
+      fprintf(f, "        \"latitude\": %.6f,\n", lat);
+      fprintf(f, "        \"longitude\": %.6f,\n", lon);
+      fprintf(f, "        \"datetime_utc\": \"%s\",\n", isoUtc(p.tcaUnix).c_str());
+      fprintf(f, "        \"aos_utc\": \"%s\",\n", isoUtc(p.aosUnix).c_str());
+      fprintf(f, "        \"los_utc\": \"%s\",\n", isoUtc(p.losUnix).c_str());
+      fprintf(f, "        \"aos_az_deg\": %.1f,\n", p.aosAzDeg);
+      fprintf(f, "        \"passes\": %d,\n", ex[k].passes);
+      fprintf(f, "        \"tle\": {\n            \"line-1\": \"%s\",\n            \"line-2\": \"%s\"\n        }\n    }",
+              s.line1.c_str(), s.line2.c_str());
+    }
+    fputs(end > start ? "\n]\n" : "]\n", f);
+    fclose(f);
+    files++;
+  }
+  return true;
+}
+
+static bool writeCatalog(const Options& o, const Sgp4Batch& b, const std::vector<Satellite>& sats,
+                         const std::vector<Export>& ex) {
+  std::string path = std::string(o.outDir) + "/sat_catalog.bin";
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) { fprintf(stderr, "cannot write %s\n", path.c_str()); return false; }
+  CatalogHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "SATC", 4);
+  h.version = 1;
+  h.recordSize = sizeof(SatRecord);
+  h.count = (uint32_t)ex.size();
+  h.createdUnix = (uint32_t)time(nullptr);
+  h.recordsOffset = sizeof(CatalogHeader);
+  fwrite(&h, sizeof(h), 1, f);
+  for (const Export& e : ex) {
+    const Satellite& s = sats[e.sat];
+    SatRecord r;
+    memset(&r, 0, sizeof(r));
+    r.norad = s.norad;
+    r.exportUnix = (uint32_t)e.best->tcaUnix;
+    r.epochUnix = b.epochUnix[e.best->sat];
+    r.distanceKm = e.best->tcaRangeKm;
+    r.elevationDeg = e.best->maxElDeg;
+    strncpy(r.name, s.name.c_str(), sizeof(r.name) - 1);
+    strncpy(r.line1, s.line1.c_str(), sizeof(r.line1) - 1);
+    strncpy(r.line2, s.line2.c_str(), sizeof(r.line2) - 1);
+    fwrite(&r, sizeof(r), 1, f);
+  }
+  fclose(f);
+  return true;
+}
+
+// ===== Main =====
+int main(int argc, char** argv) {
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    bool hasVal = i + 1 < argc;
+    if      (!strcmp(a, "--tle") && hasVal)       o.tlePath = argv[++i];
+    else if (!strcmp(a, "--location") && hasVal)  o.locationPath = argv[++i];
+    else if (!strcmp(a, "--out") && hasVal)       o.outDir = argv[++i];
+    else if (!strcmp(a, "--hours") && hasVal)     o.hours = atof(argv[++i]);
+    else if (!strcmp(a, "--step") && hasVal)      o.stepS = atof(argv[++i]);
+    else if (!strcmp(a, "--min-el") && hasVal)    o.minElDeg = atof(argv[++i]);
+    else if (!strcmp(a, "--per-file") && hasVal)  o.perFile = atoi(argv[++i]);
+    else if (!strcmp(a, "--threads") && hasVal)   o.threads = atoi(argv[++i]);
+    else if (!strcmp(a, "--catalog"))             o.catalog = true;
+    else if (!strcmp(a, "--list"))                o.list = true;
+    else if (!strcmp(a, "--start") && hasVal) {
+      if (!parseTime(argv[++i], o.startUnix)) { fprintf(stderr, "bad --start %s\n", argv[i]); return 2; }
+    } else { usage(); return 2; }
+  }
+  if (!o.tlePath || !o.locationPath || o.hours <= 0 || o.stepS <= 0) { usage(); return 2; }
+  if (o.startUnix == 0) o.startUnix = (double)time(nullptr);
+  if (o.threads <= 0) o.threads = std::max(1u, std::thread::hardware_concurrency());
+
+  double lat, lon, altM;
+  if (!readLocation(o.locationPath, lat, lon, altM)) {
+    fprintf(stderr, "cannot read latitude/longitude from %s\n", o.locationPath);
+    return 1;
+  }
+  std::vector<Satellite> all;
+  if (!readTleFile(o.tlePath, all) || all.empty()) {
+    fprintf(stderr, "no TLEs in %s\n", o.tlePath);
+    return 1;
+  }
+  size_t read = all.size(), duplicates = dropDuplicates(all);
+
+  auto t0 = std::chrono::steady_clock::now();
+  Sgp4Batch b;
+  if (!sgp4BatchBegin(b, (int)all.size())) { fprintf(stderr, "out of memory\n"); return 1; }
+  std::vector<Satellite> sats;   // batch index == index here
+  for (const Satellite& s : all) {
+    if (sgp4BatchAdd(b, s.line1.c_str(), s.line2.c_str(), s.norad)) sats.push_back(s);
+  }
+  Sgp4Site site;
+  sgp4SiteInit(site, lat, lon, altM);
+
+  int threads = std::min(o.threads, std::max(1, b.count / 64));
+  std::vector<std::vector<Pass>> found(threads);
+  std::vector<std::thread> pool;
+  int slice = (b.count + threads - 1) / threads;
+  for (int k = 0; k < threads; k++) {
+    int from = k * slice, to = std::min(b.count, from + slice);
+    if (from >= to) break;
+    pool.emplace_back([&, k, from, to] { searchSlice(b, site, o, from, to, found[k]); });
+  }
+  for (std::thread& th : pool) th.join();
+  std::vector<Pass> passes;
+  for (auto& v : found) passes.insert(passes.end(), v.begin(), v.end());
+  std::sort(passes.begin(), passes.end(), [](const Pass& a, const Pass& c) { return a.aosUnix < c.aosUnix; });
+  double searchS = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  // one entry per satellite: its highest pass, in order of first rise
+  std::vector<Export> ex;
+  std::vector<int> slot(sats.size(), -1);
+  for (const Pass& p : passes) {
+    int& e = slot[p.sat];
+    if (e < 0) { e = (int)ex.size(); ex.push_back({ p.sat, &p, 0 }); }
+    ex[e].passes++;
+    if (p.maxElDeg > ex[e].best->maxElDeg) ex[e].best = &p;
+  }
+
+  if (o.list) {
+    for (const Pass& p : passes) {
+      printf("%s %s %s  max %5.1f°  AOS az %5.1f°  %s%s\n", isoUtc(p.aosUnix).substr(0, 19).c_str(),
+             isoUtc(p.tcaUnix).substr(11, 8).c_str(), isoUtc(p.losUnix).substr(11, 8).c_str(), p.maxElDeg,
+             p.aosAzDeg, sats[p.sat].name.c_str(), p.upAtStart ? " (up at start)" : p.upAtEnd ? " (up at end)" : "");
+    }
+  }
+
+  int files = 0;
+  if (!writeJsonFiles(o, b, sats, ex, files)) return 1;
+  if (o.catalog && !writeCatalog(o, b, sats, ex)) return 1;
+
+  fprintf(stderr, "%zu TLEs (%zu duplicates dropped, %zu skipped: unparsable, deep space or decayed), %s + %.1f h above %.0f° from %.4f, %.4f\n",
+          read, duplicates, all.size() - sats.size(), isoUtc(o.startUnix).substr(0, 19).c_str(), o.hours, o.minElDeg, lat, lon);
+  fprintf(stderr, "%zu passes by %zu satellites, searched in %.2f s on %d threads (%.0f s step)\n",
+          passes.size(), ex.size(), searchS, (int)pool.size(), o.stepS);
+  fprintf(stderr, "wrote %d JSON file(s)%s to %s\n", files, o.catalog ? " and sat_catalog.bin" : "", o.outDir);
+  std::string next = std::string(o.outDir) + "/sat_data_" + std::to_string(files + 1) + ".json";
+  if (FILE* old = fopen(next.c_str(), "r")) {
+    fclose(old);
+    fprintf(stderr, "warning: %s is left from an earlier export; the server would load it too\n", next.c_str());
+  }
+  sgp4BatchEnd(b);
+  return 0;
+}